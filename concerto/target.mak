@@ -26,13 +26,21 @@ SYSIDIRS := $(HOST_ROOT)/include
 SYSLDIRS :=
 SYSDEFS  := OPENVX_BUILDING OPENVX_USE_SMP
 #SYSDEFS  += OPENVX_USE_TILING
+#SYSDEFS  += OPENVX_USE_HUGE_PAGES
+#SYSDEFS  += OPENVX_USE_FIXED_POINT_REMAP
 #SYSDEFS  += EXPERIMENTAL_USE_TARGET
 #SYSDEFS  += EXPERIMENTAL_USE_VARIANTS
 #SYSDEFS  += EXPERIMENTAL_USE_NODE_MEMORY
+#SYSDEFS  += EXPERIMENTAL_USE_PIPELINING
+#SYSDEFS  += EXPERIMENTAL_USE_MEMORY_PLAN
+#SYSDEFS  += EXPERIMENTAL_USE_IMAGE_HANDLE
 
 ifeq ($(TARGET_BUILD),debug)
 SYSDEFS += OPENVX_DEBUGGING
 endif
+ifeq ($(TARGET_BUILD),production)
+SYSDEFS += OPENVX_RELEASE_BUILD
+endif
 
 ifeq ($(TARGET_PLATFORM),PC)
     ifneq ($(OPENCL_ROOT),) 
@@ -36,10 +36,10 @@
 
 void vx_print(vx_enum zone, char *format, ...);
 
-static vx_uint32 vx_zone_mask;
+vx_uint32 vx_zone_mask;
 
 #undef  ZONE_BIT
-#define ZONE_BIT(zone)  (1 << zone)
+#define ZONE_BIT(zone)  (1u << (zone))
 
 void vx_set_debug_zone(vx_enum zone)
 {
@@ -62,7 +62,7 @@ void vx_clr_debug_zone(vx_enum zone)
 vx_bool vx_get_debug_zone(vx_enum zone)
 {
     if (0 <= zone && zone < VX_ZONE_MAX)
-        return ((vx_zone_mask & zone)?vx_true_e:vx_false_e);
+        return ((vx_zone_mask & ZONE_BIT(zone))?vx_true_e:vx_false_e);
     else
         return vx_false_e;
 }
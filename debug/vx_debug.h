@@ -73,10 +73,27 @@ enum vx_debug_zone_e {
     VX_ZONE_MAX         = 32
 };
 
+/*! \def VX_ZONE_BUILD_MASK
+ * \brief The zones which are compiled in. A release build (OPENVX_RELEASE_BUILD)
+ * keeps only the errors and warnings, the other prints are removed by the compiler.
+ * \ingroup group_int_debug
+ */
+#if defined(OPENVX_RELEASE_BUILD)
+#define VX_ZONE_BUILD_MASK  ((1u << VX_ZONE_ERROR) | (1u << VX_ZONE_WARNING))
+#else
+#define VX_ZONE_BUILD_MASK  (0xFFFFFFFFu)
+#endif
+
+/*! \brief Tests a zone against the compiled in zones and the runtime mask, before
+ * any of the arguments of a print are evaluated.
+ * \ingroup group_int_debug
+ */
+#define VX_ZONE_ENABLED(zone) ((VX_ZONE_BUILD_MASK & vx_zone_mask & (1u << (zone))) != 0u)
+
 #if defined(_WIN32) && !defined(__GNUC__)
-#define VX_PRINT(zone, message, ...) do { vx_print(zone, "[%s:%u] "message, __FUNCTION__, __LINE__, __VA_ARGS__); } while (0)
+#define VX_PRINT(zone, message, ...) do { if (VX_ZONE_ENABLED(zone)) vx_print(zone, "[%s:%u] "message, __FUNCTION__, __LINE__, __VA_ARGS__); } while (0)
 #else
-#define VX_PRINT(zone, message, ...) do { vx_print(zone, "[%s:%u] "message, __FUNCTION__, __LINE__, ## __VA_ARGS__); } while (0)
+#define VX_PRINT(zone, message, ...) do { if (VX_ZONE_ENABLED(zone)) vx_print(zone, "[%s:%u] "message, __FUNCTION__, __LINE__, ## __VA_ARGS__); } while (0)
 #endif
 
 /*! \def VX_PRINT
@@ -141,6 +158,11 @@ enum vx_debug_zone_e {
 extern "C" {
 #endif
 
+/*! \brief The mask of the enabled zones, one bit per zone.
+ * \ingroup group_int_debug
+ */
+extern vx_uint32 vx_zone_mask;
+
 /*! \brief Internal Printing Function.
  * \param [in] zone The debug zone from \ref vx_debug_zone_e.
  * \param [in] format The format string to print.
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+#ifndef _VX_EXT_IMAGE_HANDLE_H_
+#define _VX_EXT_IMAGE_HANDLE_H_
+
+#include <VX/vx.h>
+
+/*! \file
+ * \brief The OpenVX Image Handle Swap Extension.
+ *
+ * \defgroup group_image_handle Extension: Image Handle Swap
+ * \brief An image created with <tt>\ref vxCreateImageFromHandle</tt> may be given
+ * new plane pointers for each frame, so that a capture buffer is bound to a graph
+ * without a copy and without creating a new image.
+ *
+ * A graph execution holds the handles of the images its nodes use from the start
+ * of <tt>\ref vxProcessGraph</tt> or <tt>\ref vxScheduleGraph</tt> until it
+ * completes. A swap of a held image is deferred until the last hold is released,
+ * so an execution always sees the planes it started with. Swapping doesn't change
+ * the format or the strides of the image, so the graphs using it are not verified
+ * again. Images created from a region of the image follow the swap.
+ *
+ * Once the image no longer uses a set of plane pointers, the callback set with
+ * <tt>\ref vxSetImageHandleCallback</tt> is called with them, either from the
+ * swap itself, from the thread which completes the last execution holding the
+ * image, or when the image is released.
+ * \note The image must not be accessed with <tt>\ref vxAccessImagePatch</tt> while a swap is made.
+ */
+
+/*! \brief The extension name.
+ * \ingroup group_image_handle
+ */
+#define OPENVX_EXT_IMAGE_HANDLE "vx_ext_image_handle"
+
+/*! \brief The callback which returns plane pointers to the application.
+ * \param [in] image The image which used the planes.
+ * \param [in] ptrs The plane pointers the image no longer uses.
+ * \param [in] num_planes The number of entries in ptrs.
+ * \param [in] user_data The value given to <tt>\ref vxSetImageHandleCallback</tt>.
+ * \note The callback must not swap or release the image.
+ * \ingroup group_image_handle
+ */
+typedef void (VX_CALLBACK *vx_image_handle_f)(vx_image image, void *ptrs[], vx_uint32 num_planes, void *user_data);
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/*! \brief Sets the callback which is called with the plane pointers an image no longer uses.
+ * \param [in] image The image created with <tt>\ref vxCreateImageFromHandle</tt>.
+ * \param [in] callback The callback, or NULL to remove it.
+ * \param [in] user_data The value passed to the callback.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_SUCCESS No errors.
+ * \retval VX_ERROR_INVALID_REFERENCE image is not a <tt>\ref vx_image</tt>.
+ * \retval VX_ERROR_NOT_SUPPORTED image was not created from a handle.
+ * \ingroup group_image_handle
+ */
+VX_API_ENTRY vx_status VX_API_CALL vxSetImageHandleCallback(vx_image image, vx_image_handle_f callback, void *user_data);
+
+/*! \brief Replaces the plane pointers of an image created from a handle.
+ * \details If no graph execution holds the image the swap takes effect at once.
+ * Otherwise it takes effect when the last execution holding the image completes,
+ * and a later swap replaces a pending one, returning its planes through the callback.
+ * \param [in] image The image created with <tt>\ref vxCreateImageFromHandle</tt>.
+ * \param [in] new_ptrs The new plane pointers, laid out with the strides the image was created with.
+ * \param [out] prev_ptrs Optional, receives the plane pointers the image used when called.
+ * \param [in] num_planes The number of planes of the image.
+ * \return A <tt>\ref vx_status_e</tt> enumeration.
+ * \retval VX_SUCCESS No errors.
+ * \retval VX_ERROR_INVALID_REFERENCE image is not a <tt>\ref vx_image</tt>.
+ * \retval VX_ERROR_NOT_SUPPORTED image was not created from a handle.
+ * \retval VX_ERROR_INVALID_PARAMETERS A plane pointer is NULL or num_planes is wrong.
+ * \ingroup group_image_handle
+ */
+VX_API_ENTRY vx_status VX_API_CALL vxSwapImageHandle(vx_image image, void *const new_ptrs[], void *prev_ptrs[], vx_uint32 num_planes);
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
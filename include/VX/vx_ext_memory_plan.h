@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+#ifndef _VX_EXT_MEMORY_PLAN_H_
+#define _VX_EXT_MEMORY_PLAN_H_
+
+#include <VX/vx.h>
+
+/*! \file
+ * \brief The OpenVX Graph Memory Plan Extension.
+ *
+ * \defgroup group_memory_plan Extension: Graph Memory Plan
+ * \brief During <tt>\ref vxVerifyGraph</tt> the virtual images and arrays of a
+ * graph are placed into one arena, where objects whose lifetimes can't overlap
+ * share storage. These attributes report the effect of the plan.
+ */
+
+/*! \brief The extension name.
+ * \ingroup group_memory_plan
+ */
+#define OPENVX_EXT_MEMORY_PLAN "vx_ext_memory_plan"
+
+/*! \brief The graph attributes added by the memory plan extension.
+ * \ingroup group_memory_plan
+ */
+enum vx_ext_memory_plan_graph_attribute_e {
+    /*! \brief Queries the number of bytes the arena of the verified graph occupies. Use a <tt>\ref vx_size</tt> parameter. */
+    VX_GRAPH_ATTRIBUTE_PLANNED_MEMORY = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x5,
+    /*! \brief Queries the number of bytes the objects in the arena would need if each was allocated on its own. Use a <tt>\ref vx_size</tt> parameter. */
+    VX_GRAPH_ATTRIBUTE_NAIVE_MEMORY = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x6,
+};
+
+#endif
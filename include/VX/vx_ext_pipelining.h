@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+#ifndef _VX_EXT_PIPELINING_H_
+#define _VX_EXT_PIPELINING_H_
+
+#include <VX/vx.h>
+
+/*! \file
+ * \brief The OpenVX Graph Pipelining Extension.
+ *
+ * \defgroup group_pipelining Extension: Graph Pipelining
+ * \brief A graph with a pipeline depth greater than one accepts that many
+ * outstanding <tt>\ref vxScheduleGraph</tt> calls. Each scheduled execution
+ * (a frame) may enter the head nodes of the graph while earlier frames are still
+ * executing the tail nodes. A node always processes the frames in the order in
+ * which they were scheduled.
+ *
+ * During <tt>\ref vxVerifyGraph</tt> each virtual image and virtual array of the
+ * graph is given one buffer per frame of the pipeline depth. The values set with
+ * <tt>\ref vxSetGraphParameterByIndex</tt> are captured by the next call to
+ * <tt>\ref vxScheduleGraph</tt>, so the parameters of the next frame may be set
+ * while earlier frames are executing. <tt>\ref vxWaitGraph</tt> waits on the
+ * oldest outstanding frame and returns its status.
+ * \note Delays used by a pipelined graph must not be aged while frames are outstanding.
+ */
+
+/*! \brief The extension name.
+ * \ingroup group_pipelining
+ */
+#define OPENVX_EXT_PIPELINING "vx_ext_pipelining"
+
+/*! \brief The graph attributes added by the pipelining extension.
+ * \ingroup group_pipelining
+ */
+enum vx_ext_pipelining_graph_attribute_e {
+    /*! \brief Queries or sets the number of frames which may be outstanding on the graph at once.
+     * The default is 1, which disables pipelining. Setting the depth requires the graph to be
+     * verified again. Use a <tt>\ref vx_uint32</tt> parameter.
+     */
+    VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH = VX_ATTRIBUTE_BASE(VX_ID_KHRONOS, VX_TYPE_GRAPH) + 0x4,
+};
+
+#endif
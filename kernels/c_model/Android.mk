@@ -41,8 +41,10 @@ LOCAL_SRC_FILES :=  c_absdiff.c \
 					c_integralimage.c \
 					c_lut.c \
 					c_magnitude.c \
+					c_pyramid.c \
 					c_sobel3x3.c \
-					c_statistics.c 
+					c_statistics.c \
+					c_vector.c 
 LOCAL_C_INCLUDES := $(OPENVX_INC) $(OPENVX_TOP)/$(OPENVX_SRC)/include $(OPENVX_TOP)/debug
 LOCAL_MODULE := libopenvx-c_model-lib
 include $(BUILD_STATIC_LIBRARY)
\ No newline at end of file
@@ -22,6 +22,7 @@
  */
 
 #include <c_model.h>
+#include <stdlib.h>
 
 vx_uint8 vx_clamp_u8_i32(vx_int32 value)
 {
@@ -77,6 +78,71 @@ static vx_int32 vx_convolve8with16(void *base, vx_uint32 x, vx_uint32 y, vx_imag
     return sum / div;
 }
 
+/* Splits the matrix into a column and a row with conv[i][j] == col[i] * row[j]. */
+static vx_bool vxSeparateConvolution3x3(vx_int16 conv[3][3], vx_int32 col[3], vx_int32 row[3])
+{
+    vx_uint32 i, j, pi = 3u, pj = 3u;
+    for (i = 0u; (i < 3u) && (pi == 3u); i++)
+    {
+        for (j = 0u; j < 3u; j++)
+        {
+            if (conv[i][j] != 0)
+            {
+                pi = i;
+                pj = j;
+                break;
+            }
+        }
+    }
+    if (pi == 3u)
+        return vx_false_e;
+    for (j = 0u; j < 3u; j++)
+    {
+        row[j] = conv[pi][j];
+    }
+    for (i = 0u; i < 3u; i++)
+    {
+        if ((conv[i][pj] % conv[pi][pj]) != 0)
+            return vx_false_e;
+        col[i] = conv[i][pj] / conv[pi][pj];
+    }
+    for (i = 0u; i < 3u; i++)
+    {
+        for (j = 0u; j < 3u; j++)
+        {
+            if (conv[i][j] != col[i] * row[j])
+                return vx_false_e;
+        }
+    }
+    return vx_true_e;
+}
+
+/* Finds a multiplier and shift which divide every magnitude up to limit by div,
+ * truncating as the integer division of the reference does.
+ */
+static vx_bool vxFindReciprocal(vx_uint32 div, vx_uint32 limit, vx_uint32 *mult, vx_uint32 *shift)
+{
+    vx_uint32 s, n;
+    for (s = 0u; s < 32u; s++)
+    {
+        vx_uint64 m = (((vx_uint64)1 << s) + div - 1u) / div;
+        if ((m * limit) > UINT32_MAX)
+            break;
+        for (n = 0u; n <= limit; n++)
+        {
+            if ((vx_uint32)((n * m) >> s) != (n / div))
+                break;
+        }
+        if (n > limit)
+        {
+            *mult = (vx_uint32)m;
+            *shift = s;
+            return vx_true_e;
+        }
+    }
+    return vx_false_e;
+}
+
 vx_status vxConvolution3x3(vx_image src, vx_image dst, vx_int16 conv[3][3], const vx_border_mode_t *borders)
 {
     vx_uint32 y, x;
@@ -87,6 +153,9 @@ vx_status vxConvolution3x3(vx_image src, vx_image dst, vx_int16 conv[3][3], cons
     vx_enum dst_format = VX_DF_IMAGE_VIRT;
     vx_status status = VX_SUCCESS;
     vx_uint32 low_x = 0, low_y = 0, high_x, high_y;
+    const vx_row_ops_t *ops = vxGetRowOps();
+    vx_int32 col[3], row[3], *rows = NULL;
+    vx_uint32 mult = 1u, shift = 0u, computed = 0u;
 
     status = vxGetValidRegionImage(src, &rect);
     status |= vxAccessImagePatch(src, &rect, 0, &src_addr, &src_base, VX_READ_ONLY);
@@ -104,11 +173,70 @@ vx_status vxConvolution3x3(vx_image src, vx_image dst, vx_int16 conv[3][3], cons
     }
     //printf("%s Rectangle = {%u,%u x %u,%u}\n",__FUNCTION__, rect.start_x, rect.start_y, rect.end_x, rect.end_y);
 
+    /* the interior rows of a separable matrix are computed with a row pass per
+     * source row, kept for the three output rows which use it, and a column pass.
+     */
+    if ((status == VX_SUCCESS) && (src_addr.dim_x >= 3u) && (src_addr.dim_y >= 3u) &&
+        (src_addr.stride_x == 1) && (dst_addr.stride_x == (dst_format == VX_DF_IMAGE_U8 ? 1 : 2)) &&
+        (vxSeparateConvolution3x3(conv, col, row) == vx_true_e))
+    {
+        vx_uint32 limit = 0u, div = 0u, i, j;
+        vx_int32 sum = 0;
+        for (i = 0u; i < 3u; i++)
+        {
+            for (j = 0u; j < 3u; j++)
+            {
+                sum += conv[i][j];
+                limit += (vx_uint32)abs(conv[i][j]) * UINT8_MAX;
+            }
+        }
+        div = (sum == 0 ? 1u : (vx_uint32)abs(sum));
+        if ((limit <= UINT16_MAX) && (vxFindReciprocal(div, limit, &mult, &shift) == vx_true_e))
+        {
+            /* a negative divisor moves into the column */
+            if (sum < 0)
+            {
+                col[0] = -col[0]; col[1] = -col[1]; col[2] = -col[2];
+            }
+            rows = (vx_int32 *)malloc(3u * src_addr.dim_x * sizeof(vx_int32));
+        }
+    }
+
     for (y = low_y; y < high_y; y++)
     {
+        vx_bool interior = ((rows != NULL) && (y > 0u) && (y < src_addr.dim_y - 1u) ? vx_true_e : vx_false_e);
+        if (interior == vx_true_e)
+        {
+            vx_int32 *r[3];
+            /* slide the window of row passes down to the rows around y */
+            if (computed < y - 1u)
+                computed = y - 1u;
+            for (; computed <= y + 1u; computed++)
+            {
+                ops->convolve_row(vxFormatImagePatchAddress2d(src_base, 0, computed, &src_addr),
+                                  src_addr.dim_x, row, &rows[(computed % 3u) * src_addr.dim_x]);
+            }
+            r[0] = &rows[((y - 1u) % 3u) * src_addr.dim_x];
+            r[1] = &rows[(y % 3u) * src_addr.dim_x];
+            r[2] = &rows[((y + 1u) % 3u) * src_addr.dim_x];
+            if (dst_format == VX_DF_IMAGE_U8)
+                ops->convolve_column_u8(r[0], r[1], r[2], src_addr.dim_x, col, mult, shift,
+                                        vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr));
+            else
+                ops->convolve_column_s16(r[0], r[1], r[2], src_addr.dim_x, col, mult, shift,
+                                         vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr));
+        }
         for (x = low_x; x < high_x; x++)
         {
-            vx_int32 value = vx_convolve8with16(src_base, x, y, &src_addr, conv, borders);
+            vx_int32 value = 0;
+
+            /* only the border columns are left in the interior rows */
+            if ((interior == vx_true_e) && (x == 1u))
+            {
+                x = src_addr.dim_x - 2u;
+                continue;
+            }
+            value = vx_convolve8with16(src_base, x, y, &src_addr, conv, borders);
 
             if (dst_format == VX_DF_IMAGE_U8)
             {
@@ -122,9 +250,9 @@ vx_status vxConvolution3x3(vx_image src, vx_image dst, vx_int16 conv[3][3], cons
             }
         }
     }
+    free(rows);
 
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
     status |= vxCommitImagePatch(dst, &rect, 0, &dst_addr, dst_base);
     return status;
 }
-
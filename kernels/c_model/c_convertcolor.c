@@ -23,9 +23,22 @@
 
 #include <c_model.h>
 #include <vx_debug.h>
+#include <stdlib.h>
+#include <string.h>
 
 // helpers -------------------------------------------------------------------
 
+/*! \brief The number of fraction bits of the fixed point conversion coefficients. */
+#define CC_SHIFT (16)
+
+/*! \brief Converts a coefficient to fixed point, rounding to nearest. */
+#define CC_FIX(c) ((vx_int32)((c) * (1 << CC_SHIFT) + ((c) < 0 ? -0.5f : 0.5f)))
+
+/*! \brief Added to the sums of the YUV to RGB conversions to keep them positive, so
+ * they are floored by the shift just like the truncation of a clamped float.
+ */
+#define CC_BIAS (512)
+
 static vx_uint8 usat8(vx_int32 a)
 {
     if (a > 255)
@@ -35,116 +48,308 @@ static vx_uint8 usat8(vx_int32 a)
     return (vx_uint8)a;
 }
 
-static void yuv2rgb_bt601(vx_uint8 y, vx_uint8 cb, vx_uint8 cr,
-                          vx_uint8 *r, vx_uint8 *g, vx_uint8 *b)
-{
+/*! \brief The coefficients of a YUV to RGB conversion.
+ * \details R = Y + rv*V, G = Y + gu*U + gv*V, B = Y + bu*U with U and V centered on 128.
+ */
+typedef struct _vx_yuv2rgb_coeffs_t {
+    vx_int32 rv;
+    vx_int32 gu;
+    vx_int32 gv;
+    vx_int32 bu;
+} vx_yuv2rgb_coeffs_t;
+
+static const vx_yuv2rgb_coeffs_t yuv2rgb_bt601 = {
     /*
     R'= Y' + 0.000*U' + 1.403*V'
     G'= Y' - 0.344*U' - 0.714*V'
     B'= Y' + 1.773*U' + 0.000*V'
     */
-    vx_float64 f_y = (vx_float64)y;
-    vx_float64 f_u = (vx_float64)cb - 128;
-    vx_float64 f_v = (vx_float64)cr - 128;
-    vx_float64 f_r = f_y + 0.000f*f_u + 1.403f*f_v;
-    vx_float64 f_g = f_y - 0.344f*f_u - 0.714f*f_v;
-    vx_float64 f_b = f_y + 1.773f*f_u + 0.000f*f_v;
-    vx_int32 i_r = (vx_int32)f_r;
-    vx_int32 i_g = (vx_int32)f_g;
-    vx_int32 i_b = (vx_int32)f_b;
-    *r = usat8(i_r);
-    *g = usat8(i_g);
-    *b = usat8(i_b);
-}
+    CC_FIX(1.403f), CC_FIX(-0.344f), CC_FIX(-0.714f), CC_FIX(1.773f),
+};
+
+static const vx_yuv2rgb_coeffs_t yuv2rgb_bt709 = {
+    /*
+    R'= Y' + 0.0000*U + 1.5748*V
+    G'= Y' - 0.1873*U - 0.4681*V
+    B'= Y' + 1.8556*U + 0.0000*V
+    */
+    CC_FIX(1.5748f), CC_FIX(-0.1873f), CC_FIX(-0.4681f), CC_FIX(1.8556f),
+};
+
+/*! \brief The coefficients of an RGB to YUV conversion, one row per output channel. */
+typedef struct _vx_rgb2yuv_coeffs_t {
+    vx_int32 y[3];
+    vx_int32 u[3];
+    vx_int32 v[3];
+} vx_rgb2yuv_coeffs_t;
 
 #if 0 /* we don't make 601 yet */
-static void rgb2yuv_bt601(vx_uint8 r, vx_uint8 g, vx_uint8 b,
-                          vx_uint8 *y, vx_uint8 *cb, vx_uint8 *cr)
-{
+static const vx_rgb2yuv_coeffs_t rgb2yuv_bt601 = {
     /*
     Y'= 0.299*R' + 0.587*G' + 0.114*B'
     Cb=-0.169*R' - 0.331*G' + 0.500*B'
     Cr= 0.500*R' - 0.419*G' - 0.081*B'
     */
-    vx_float64 f_r = (vx_float64)r;
-    vx_float64 f_g = (vx_float64)g;
-    vx_float64 f_b = (vx_float64)b;
-    vx_float64 f_y = 0 + 0.299f*f_r + 0.587f*f_g + 0.114f*f_b;
-    vx_float64 f_u = 0 - 0.169f*f_r - 0.331f*f_g + 0.500f*f_b;
-    vx_float64 f_v = 0 + 0.500f*f_r - 0.419f*f_g - 0.081f*f_b;
-    vx_int32 i_y = (vx_int32)f_y;
-    vx_int32 i_u = (vx_int32)f_u + 128;
-    vx_int32 i_v = (vx_int32)f_v + 128;
-    *y  = usat8(i_y);
-    *cb = usat8(i_u);
-    *cr = usat8(i_v);
-}
+    {CC_FIX(0.299f), CC_FIX(0.587f), CC_FIX(0.114f)},
+    {CC_FIX(-0.169f), CC_FIX(-0.331f), CC_FIX(0.500f)},
+    {CC_FIX(0.500f), CC_FIX(-0.419f), CC_FIX(-0.081f)},
+};
 #endif
 
-static void yuv2rgb_bt709(vx_uint8 y, vx_uint8 cb, vx_uint8 cr,
-                          vx_uint8 *r, vx_uint8 *g, vx_uint8 *b)
-{
-    /*
-    R'= Y' + 0.0000*U + 1.5748*V
-    G'= Y' - 0.1873*U - 0.4681*V
-    B'= Y' + 1.8556*U + 0.0000*V
-    */
-    vx_float64 f_y = (vx_float64)y;
-    vx_float64 f_u = (vx_float64)cb - 128;
-    vx_float64 f_v = (vx_float64)cr - 128;
-    vx_float64 f_r = f_y + 0.0000f*f_u + 1.5748f*f_v;
-    vx_float64 f_g = f_y - 0.1873f*f_u - 0.4681f*f_v;
-    vx_float64 f_b = f_y + 1.8556f*f_u + 0.0000f*f_v;
-    vx_int32 i_r = (vx_int32)f_r;
-    vx_int32 i_g = (vx_int32)f_g;
-    vx_int32 i_b = (vx_int32)f_b;
-    *r = usat8(i_r);
-    *g = usat8(i_g);
-    *b = usat8(i_b);
-}
-
-static void rgb2yuv_bt709(vx_uint8 r, vx_uint8 g, vx_uint8 b,
-                          vx_uint8 *y, vx_uint8 *cb, vx_uint8 *cr)
-{
+static const vx_rgb2yuv_coeffs_t rgb2yuv_bt709 = {
     /*
     Y'= 0.2126*R' + 0.7152*G' + 0.0722*B'
     U'=-0.1146*R' - 0.3854*G' + 0.5000*B'
     V'= 0.5000*R' - 0.4542*G' - 0.0458*B'
     */
-    vx_float64 f_r = (vx_float64)r;
-    vx_float64 f_g = (vx_float64)g;
-    vx_float64 f_b = (vx_float64)b;
-    vx_float64 f_y = 0 + 0.2126f*f_r + 0.7152f*f_g + 0.0722f*f_b;
-    vx_float64 f_u = 0 - 0.1146f*f_r - 0.3854f*f_g + 0.5000f*f_b;
-    vx_float64 f_v = 0 + 0.5000f*f_r - 0.4542f*f_g - 0.0458f*f_b;
-    vx_int32 i_y = (vx_int32)f_y;
-    vx_int32 i_u = (vx_int32)f_u + 128;
-    vx_int32 i_v = (vx_int32)f_v + 128;
-    *y  = usat8(i_y);
-    *cb = usat8(i_u);
-    *cr = usat8(i_v);
+    {CC_FIX(0.2126f), CC_FIX(0.7152f), CC_FIX(0.0722f)},
+    {CC_FIX(-0.1146f), CC_FIX(-0.3854f), CC_FIX(0.5000f)},
+    {CC_FIX(0.5000f), CC_FIX(-0.4542f), CC_FIX(-0.0458f)},
+};
+
+/*! \brief The coefficients of the conversion of YUV from BT.601 to BT.709.
+ * \details Y' = 1.0090*Y - 0.11826430*Cb - 0.2000311*Cr
+ * Cb'= 0.0000*Y + 1.01911200*Cb + 0.1146035*Cr
+ * Cr'= 0.0001*Y + 0.07534570*Cb + 1.0290932*Cr
+ */
+static const vx_int32 yuv2yuv_601to709[3][3] = {
+    {CC_FIX(1.0090), CC_FIX(-0.11826430), CC_FIX(-0.2000311)},
+    {CC_FIX(0.0000), CC_FIX(1.01911200), CC_FIX(0.1146035)},
+    {CC_FIX(0.0001), CC_FIX(0.07534570), CC_FIX(1.0290932)},
+};
+
+// rows ----------------------------------------------------------------------
+
+/*! \brief Converts a row of YUV to RGB or RGBX.
+ * \details Two horizontally neighbouring pixels share one chroma sample, which is read
+ * at every cstep bytes from cb and cr, so the same routine serves the planar, the
+ * co-planar and the interleaved layouts. Each layout calls it with constant steps in
+ * its own wrapper below, which the compiler specializes and vectorizes.
+ */
+static VX_INLINE void yuv2rgb_row(const vx_uint8 *luma, vx_uint32 ystep,
+                        const vx_uint8 *cb, const vx_uint8 *cr, vx_uint32 cstep,
+                        vx_uint8 * VX_RESTRICT rgb, vx_uint32 dstep,
+                        vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
+{
+    const vx_int32 bias = CC_BIAS << CC_SHIFT;
+    vx_int32 rv = c->rv, gu = c->gu, gv = c->gv, bu = c->bu;
+    vx_uint32 x;
+    for (x = 0u; x < width; x += 2u)
+    {
+        vx_int32 u = (vx_int32)cb[(x / 2u) * cstep] - 128;
+        vx_int32 v = (vx_int32)cr[(x / 2u) * cstep] - 128;
+        vx_int32 r = rv * v + bias;
+        vx_int32 g = gu * u + gv * v + bias;
+        vx_int32 b = bu * u + bias;
+        vx_int32 l0 = (vx_int32)luma[x * ystep] << CC_SHIFT;
+        vx_int32 l1 = (vx_int32)luma[(x + 1u) * ystep] << CC_SHIFT;
+        vx_uint8 *px = &rgb[x * dstep];
+        px[0] = usat8(((l0 + r) >> CC_SHIFT) - CC_BIAS);
+        px[1] = usat8(((l0 + g) >> CC_SHIFT) - CC_BIAS);
+        px[2] = usat8(((l0 + b) >> CC_SHIFT) - CC_BIAS);
+        px[dstep + 0u] = usat8(((l1 + r) >> CC_SHIFT) - CC_BIAS);
+        px[dstep + 1u] = usat8(((l1 + g) >> CC_SHIFT) - CC_BIAS);
+        px[dstep + 2u] = usat8(((l1 + b) >> CC_SHIFT) - CC_BIAS);
+        if (dstep == 4u)
+            px[3] = px[7] = 255;
+    }
+}
+
+/*! \brief Converts a row of YUV from the planes of an IYUV, NV12 or NV21 image, or the
+ * plane of a YUYV or UYVY image, to RGB or RGBX.
+ */
+typedef void (*vx_yuv2rgb_row_f)(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                 vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c);
+
+static void yuv2rgb_row_iyuv_rgb(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                 vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
+{
+    yuv2rgb_row(luma, 1u, cb, cr, 1u, rgb, 3u, width, c);
 }
 
-static void yuv2yuv_601to709(vx_uint8 y0, vx_uint8 cb0, vx_uint8 cr0,
-                             vx_uint8 *y1, vx_uint8 *cb1, vx_uint8 *cr1)
+static void yuv2rgb_row_iyuv_rgbx(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                  vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
 {
-    /*
-    Y' = 1.0090*Y - 0.11826430*Cb - 0.2000311*Cr
-    Cb'= 0.0000*Y + 1.01911200*Cb + 0.1146035*Cr
-    Cr'= 0.0001*Y + 0.07534570*Cb + 1.0290932*Cr
-    */
-    vx_float64 f_y0 = (vx_float64)y0;
-    vx_float64 f_cb0 = (vx_float64)cb0;
-    vx_float64 f_cr0 = (vx_float64)cr0;
-    vx_float64 f_y1  = 1.0090*f_y0 - 0.11826430*f_cb0 - 0.2000311*f_cr0;
-    vx_float64 f_cb1 = 0.0000*f_y0 + 1.01911200*f_cb0 + 0.1146035*f_cr0;
-    vx_float64 f_cr1 = 0.0001*f_y0 + 0.07534570*f_cb0 + 1.0290932*f_cr0;
-    vx_int32 i_y = (vx_int32)f_y1;
-    vx_int32 i_cb = (vx_int32)f_cb1;
-    vx_int32 i_cr = (vx_int32)f_cr1;
-    *y1 = usat8(i_y);
-    *cb1 = usat8(i_cb);
-    *cr1 = usat8(i_cr);
+    yuv2rgb_row(luma, 1u, cb, cr, 1u, rgb, 4u, width, c);
+}
+
+static void yuv2rgb_row_nv12_rgb(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                 vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
+{
+    yuv2rgb_row(luma, 1u, cb, cr, 2u, rgb, 3u, width, c);
+}
+
+static void yuv2rgb_row_nv12_rgbx(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                  vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
+{
+    yuv2rgb_row(luma, 1u, cb, cr, 2u, rgb, 4u, width, c);
+}
+
+static void yuv2rgb_row_yuyv_rgb(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                 vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
+{
+    yuv2rgb_row(luma, 2u, cb, cr, 4u, rgb, 3u, width, c);
+}
+
+static void yuv2rgb_row_yuyv_rgbx(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                  vx_uint8 *rgb, vx_uint32 width, const vx_yuv2rgb_coeffs_t *c)
+{
+    yuv2rgb_row(luma, 2u, cb, cr, 4u, rgb, 4u, width, c);
+}
+
+/*! \brief Converts a row of RGB or RGBX to full resolution Y, U and V.
+ * \details The sums are truncated toward zero like the casts of the float conversion.
+ */
+static VX_INLINE void rgb2yuv_row(const vx_uint8 *rgb, vx_uint32 sstep, vx_uint32 width,
+                        const vx_rgb2yuv_coeffs_t *c, vx_uint8 * VX_RESTRICT luma,
+                        vx_uint8 * VX_RESTRICT cb, vx_uint8 * VX_RESTRICT cr)
+{
+    vx_int32 yr = c->y[0], yg = c->y[1], yb = c->y[2];
+    vx_int32 ur = c->u[0], ug = c->u[1], ub = c->u[2];
+    vx_int32 vr = c->v[0], vg = c->v[1], vb = c->v[2];
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+    {
+        const vx_uint8 *px = &rgb[x * sstep];
+        vx_int32 r = px[0], g = px[1], b = px[2];
+        vx_int32 sy = yr * r + yg * g + yb * b;
+        vx_int32 su = ur * r + ug * g + ub * b;
+        vx_int32 sv = vr * r + vg * g + vb * b;
+        vx_int32 qu = (su < 0 ? -((-su) >> CC_SHIFT) : (su >> CC_SHIFT));
+        vx_int32 qv = (sv < 0 ? -((-sv) >> CC_SHIFT) : (sv >> CC_SHIFT));
+        luma[x] = usat8(sy >> CC_SHIFT);
+        cb[x] = usat8(qu + 128);
+        cr[x] = usat8(qv + 128);
+    }
+}
+
+static void rgb2yuv_row_rgb(const vx_uint8 *rgb, vx_uint32 width, const vx_rgb2yuv_coeffs_t *c,
+                            vx_uint8 *luma, vx_uint8 *cb, vx_uint8 *cr)
+{
+    rgb2yuv_row(rgb, 3u, width, c, luma, cb, cr);
+}
+
+static void rgb2yuv_row_rgbx(const vx_uint8 *rgb, vx_uint32 width, const vx_rgb2yuv_coeffs_t *c,
+                             vx_uint8 *luma, vx_uint8 *cb, vx_uint8 *cr)
+{
+    rgb2yuv_row(rgb, 4u, width, c, luma, cb, cr);
+}
+
+/*! \brief Averages the 2x2 blocks of two rows of chroma into every dstep bytes of dst. */
+static void subsample_row(const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 width,
+                          vx_uint8 * VX_RESTRICT dst, vx_uint32 dstep)
+{
+    vx_uint32 x;
+    for (x = 0u; x < width / 2u; x++)
+    {
+        dst[x * dstep] = (vx_uint8)(((vx_uint32)r0[2u*x] + r0[2u*x+1u] + r1[2u*x] + r1[2u*x+1u]) >> 2);
+    }
+}
+
+/*! \brief Copies a row to every dstep bytes of dst. */
+static void store_row(const vx_uint8 *src, vx_uint32 width, vx_uint8 * VX_RESTRICT dst, vx_uint32 dstep)
+{
+    vx_uint32 x;
+    if (dstep == 1u)
+        memcpy(dst, src, width);
+    else
+    {
+        for (x = 0u; x < width; x++)
+            dst[x * dstep] = src[x];
+    }
+}
+
+/*! \brief Copies every sstep bytes of src to a row. */
+static void gather_row(const vx_uint8 *src, vx_uint32 sstep, vx_uint32 width, vx_uint8 * VX_RESTRICT dst)
+{
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+        dst[x] = src[x * sstep];
+}
+
+/*! \brief Repeats every sstep bytes of a row of chroma twice, up to a full resolution row. */
+static void upsample_row(const vx_uint8 *src, vx_uint32 sstep, vx_uint32 width, vx_uint8 * VX_RESTRICT dst)
+{
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+        dst[x] = src[(x / 2u) * sstep];
+}
+
+/*! \brief Averages every sstep bytes of two rows of chroma into every dstep bytes of dst. */
+static void average_row(const vx_uint8 *r0, const vx_uint8 *r1, vx_uint32 sstep, vx_uint32 width,
+                        vx_uint8 * VX_RESTRICT dst, vx_uint32 dstep)
+{
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+        dst[x * dstep] = (vx_uint8)(((vx_uint32)r0[x * sstep] + r1[x * sstep]) >> 1);
+}
+
+/*! \brief Converts a row of co-planar YUV from BT.601 to BT.709.
+ * \details The luma of every pixel is converted, and when cb_out and cr_out are given
+ * the chroma of every pair of pixels, with the luma of the first pixel of the pair.
+ */
+static void yuv2yuv_601to709_row(const vx_uint8 *luma, const vx_uint8 *cb, const vx_uint8 *cr,
+                                 vx_uint32 width, vx_uint8 * VX_RESTRICT luma_out,
+                                 vx_uint8 * VX_RESTRICT cb_out, vx_uint8 * VX_RESTRICT cr_out)
+{
+    const vx_int32 bias = CC_BIAS << CC_SHIFT;
+    const vx_int32 (*c)[3] = yuv2yuv_601to709;
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+    {
+        vx_int32 u = cb[(x / 2u) * 2u], v = cr[(x / 2u) * 2u];
+        luma_out[x] = usat8(((c[0][0] * luma[x] + c[0][1] * u + c[0][2] * v + bias) >> CC_SHIFT) - CC_BIAS);
+    }
+    if (cb_out && cr_out)
+    {
+        for (x = 0u; x < width / 2u; x++)
+        {
+            vx_int32 l = luma[2u * x], u = cb[2u * x], v = cr[2u * x];
+            cb_out[2u * x] = usat8((c[1][0] * l + c[1][1] * u + c[1][2] * v) >> CC_SHIFT);
+            cr_out[2u * x] = usat8((c[2][0] * l + c[2][1] * u + c[2][2] * v) >> CC_SHIFT);
+        }
+    }
+}
+
+/*! \brief Copies a row of RGB or RGBX to RGB or RGBX, setting the alpha of RGBX. */
+static VX_INLINE void rgb2rgb_row(const vx_uint8 *src, vx_uint32 sstep, vx_uint8 * VX_RESTRICT dst,
+                        vx_uint32 dstep, vx_uint32 width)
+{
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+    {
+        dst[x * dstep + 0u] = src[x * sstep + 0u];
+        dst[x * dstep + 1u] = src[x * sstep + 1u];
+        dst[x * dstep + 2u] = src[x * sstep + 2u];
+        if (dstep == 4u)
+            dst[x * dstep + 3u] = 255;
+    }
+}
+
+/*! \brief Selects the YUV to RGB row conversion of a pair of formats. */
+static vx_yuv2rgb_row_f yuv2rgb_row_select(vx_df_image src_format, vx_df_image dst_format)
+{
+    vx_bool rgbx = (dst_format == VX_DF_IMAGE_RGBX ? vx_true_e : vx_false_e);
+    switch (src_format)
+    {
+        case VX_DF_IMAGE_IYUV:
+            return (rgbx ? yuv2rgb_row_iyuv_rgbx : yuv2rgb_row_iyuv_rgb);
+        case VX_DF_IMAGE_NV12:
+        case VX_DF_IMAGE_NV21:
+            return (rgbx ? yuv2rgb_row_nv12_rgbx : yuv2rgb_row_nv12_rgb);
+        default: /* VX_DF_IMAGE_YUYV, VX_DF_IMAGE_UYVY */
+            return (rgbx ? yuv2rgb_row_yuyv_rgbx : yuv2rgb_row_yuyv_rgb);
+    }
+}
+
+/*! \brief Selects the YUV to RGB coefficients of a color space. */
+static const vx_yuv2rgb_coeffs_t *yuv2rgb_coeffs(vx_enum space)
+{
+    if (space == VX_COLOR_SPACE_BT601_525 ||
+        space == VX_COLOR_SPACE_BT601_625)
+        return &yuv2rgb_bt601;
+    else /*if (space == VX_COLOR_SPACE_BT709)*/
+        return &yuv2rgb_bt709;
 }
 
 // kernel --------------------------------------------------------------------
@@ -160,6 +365,7 @@ vx_status vxConvertColor(vx_image src, vx_image dst)
     vx_size src_planes, dst_planes;
     vx_enum src_space;
     vx_rectangle_t rect;
+    vx_status converted = VX_SUCCESS;
 
     vx_status status = VX_SUCCESS;
     status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &src_format, sizeof(src_format));
@@ -185,93 +391,63 @@ vx_status vxConvertColor(vx_image src, vx_image dst)
 
     if ((src_format == VX_DF_IMAGE_RGB) || (src_format == VX_DF_IMAGE_RGBX))
     {
+        vx_uint32 width = dst_addr[0].dim_x;
+        vx_uint32 sstep = (src_format == VX_DF_IMAGE_RGBX ? 4u : 3u);
         if (dst_format == VX_DF_IMAGE_RGB || dst_format == VX_DF_IMAGE_RGBX)
         {
+            vx_uint32 dstep = (dst_format == VX_DF_IMAGE_RGBX ? 4u : 3u);
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
-                {
-                    vx_uint8 *src_rgb = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *dst_rgb = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    dst_rgb[0] = src_rgb[0];
-                    dst_rgb[1] = src_rgb[1];
-                    dst_rgb[2] = src_rgb[2];
-                    if (dst_format == VX_DF_IMAGE_RGBX)
-                        dst_rgb[3] = 255;
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_NV12)
-        {
-            vx_uint8 cb[4];
-            vx_uint8 cr[4];
-            for (y = 0; y < dst_addr[0].dim_y; y+=2)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *rgb[4] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                        vxFormatImagePatchAddress2d(src_base[0], x+1, y, &src_addr[0]),
-                                        vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0]),
-                                        vxFormatImagePatchAddress2d(src_base[0], x+1, y+1, &src_addr[0])};
-                    vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                    vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    rgb2yuv_bt709(rgb[0][0],rgb[0][1],rgb[0][2],&luma[0][0],&cb[0],&cr[0]);
-                    rgb2yuv_bt709(rgb[1][0],rgb[1][1],rgb[1][2],&luma[1][0],&cb[1],&cr[1]);
-                    rgb2yuv_bt709(rgb[2][0],rgb[2][1],rgb[2][2],&luma[2][0],&cb[2],&cr[2]);
-                    rgb2yuv_bt709(rgb[3][0],rgb[3][1],rgb[3][2],&luma[3][0],&cb[3],&cr[3]);
-
-                    cbcr[0] = (cb[0] + cb[1] + cb[2] + cb[3])/4;
-                    cbcr[1] = (cr[0] + cr[1] + cr[2] + cr[3])/4;
-                }
+                rgb2rgb_row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]), sstep,
+                            vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), dstep, width);
             }
         }
-        else if (dst_format == VX_DF_IMAGE_YUV4)
+        else
         {
-            for (y = 0; y < dst_addr[0].dim_y; y++)
+            /* each row is converted to full resolution YUV, then the chroma of the
+             * 4:2:0 formats is averaged over the 2x2 blocks of a pair of rows */
+            vx_uint32 rows = (dst_format == VX_DF_IMAGE_YUV4 ? 1u : 2u);
+            vx_uint8 *yuv = (vx_uint8 *)malloc(6u * width);
+            if (yuv == NULL)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
-                {
-                    vx_uint8 *rgb  = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                    rgb2yuv_bt709(rgb[0],rgb[1],rgb[2],luma,cb,cr);
-                }
+                VX_PRINT(VX_ZONE_ERROR, "Failed to allocate the rows in Color Convert!\n");
+                converted = VX_ERROR_NO_MEMORY;
             }
-        }
-        else if (dst_format == VX_DF_IMAGE_IYUV)
-        {
-            vx_uint8 cb[4];
-            vx_uint8 cr[4];
-            for (y = 0; y < dst_addr[0].dim_y; y+=2)
+            else
             {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
+                vx_uint8 *luma[2] = {&yuv[0], &yuv[width]};
+                vx_uint8 *cb[2] = {&yuv[2u * width], &yuv[3u * width]};
+                vx_uint8 *cr[2] = {&yuv[4u * width], &yuv[5u * width]};
+                for (y = 0; y < dst_addr[0].dim_y; y += rows)
                 {
-                    vx_uint8 *rgb[4] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                        vxFormatImagePatchAddress2d(src_base[0], x+1, y, &src_addr[0]),
-                                        vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0]),
-                                        vxFormatImagePatchAddress2d(src_base[0], x+1, y+1, &src_addr[0])};
-
-                    vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-
-                    vx_uint8 *cbp = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *crp = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                    rgb2yuv_bt709(rgb[0][0],rgb[0][1],rgb[0][2],&luma[0][0],&cb[0],&cr[0]);
-                    rgb2yuv_bt709(rgb[1][0],rgb[1][1],rgb[1][2],&luma[1][0],&cb[1],&cr[1]);
-                    rgb2yuv_bt709(rgb[2][0],rgb[2][1],rgb[2][2],&luma[2][0],&cb[2],&cr[2]);
-                    rgb2yuv_bt709(rgb[3][0],rgb[3][1],rgb[3][2],&luma[3][0],&cb[3],&cr[3]);
-
-                    cbp[0] = (uint8_t)(((vx_uint16)cb[0] + (vx_uint16)cb[1] + (vx_uint16)cb[2] + (vx_uint16)cb[3])>>2);
-                    crp[0] = (uint8_t)(((vx_uint16)cr[0] + (vx_uint16)cr[1] + (vx_uint16)cr[2] + (vx_uint16)cr[3])>>2);
+                    vx_uint32 r;
+                    for (r = 0; r < rows; r++)
+                    {
+                        const vx_uint8 *rgb = vxFormatImagePatchAddress2d(src_base[0], 0, y + r, &src_addr[0]);
+                        if (sstep == 4u)
+                            rgb2yuv_row_rgbx(rgb, width, &rgb2yuv_bt709, luma[r], cb[r], cr[r]);
+                        else
+                            rgb2yuv_row_rgb(rgb, width, &rgb2yuv_bt709, luma[r], cb[r], cr[r]);
+                        store_row(luma[r], width, vxFormatImagePatchAddress2d(dst_base[0], 0, y + r, &dst_addr[0]), 1u);
+                    }
+                    if (dst_format == VX_DF_IMAGE_NV12)
+                    {
+                        vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]);
+                        subsample_row(cb[0], cb[1], width, &cbcr[0], 2u);
+                        subsample_row(cr[0], cr[1], width, &cbcr[1], 2u);
+                    }
+                    else if (dst_format == VX_DF_IMAGE_IYUV)
+                    {
+                        subsample_row(cb[0], cb[1], width, vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]), 1u);
+                        subsample_row(cr[0], cr[1], width, vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]), 1u);
+                    }
+                    else /* VX_DF_IMAGE_YUV4 */
+                    {
+                        store_row(cb[0], width, vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]), 1u);
+                        store_row(cr[0], width, vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]), 1u);
+                    }
                 }
+                free(yuv);
             }
         }
     }
@@ -281,362 +457,142 @@ vx_status vxConvertColor(vx_image src, vx_image dst)
         int v_pix = src_format == VX_DF_IMAGE_NV12 ? 1 : 0;
         if ((dst_format == VX_DF_IMAGE_RGB) || (dst_format == VX_DF_IMAGE_RGBX))
         {
+            vx_yuv2rgb_row_f row = yuv2rgb_row_select(src_format, dst_format);
+            const vx_yuv2rgb_coeffs_t *coeffs = yuv2rgb_coeffs(src_space);
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
-                {
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                    vx_uint8 *rgb = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    if (dst_format == VX_DF_IMAGE_RGBX)
-                        rgb[3] = 255;
-
-                    if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                        src_space == VX_COLOR_SPACE_BT601_625)
-                        yuv2rgb_bt601(luma[0],crcb[u_pix],crcb[v_pix],&rgb[0],&rgb[1],&rgb[2]);
-                    else /*if (src_space == VX_COLOR_SPACE_BT709)*/
-                        yuv2rgb_bt709(luma[0],crcb[u_pix],crcb[v_pix],&rgb[0],&rgb[1],&rgb[2]);
-                }
+                const vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], 0, y, &src_addr[1]);
+                row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]), &crcb[u_pix], &crcb[v_pix],
+                    vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), dst_addr[0].dim_x, coeffs);
             }
         }
         else if (dst_format == VX_DF_IMAGE_NV12 || dst_format == VX_DF_IMAGE_NV21)
         {
+            int u_out = dst_format == VX_DF_IMAGE_NV12 ? 0 : 1;
+            int v_out = dst_format == VX_DF_IMAGE_NV12 ? 1 : 0;
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
-                {
-                    vx_uint8 *luma[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0])};
-                    vx_uint8 *cbcr = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                    vx_uint8 *crcb = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    yuv2yuv_601to709(luma[0][0],cbcr[0],cbcr[1],&luma[1][0],&crcb[1],&crcb[0]);
-                }
+                const vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], 0, y, &src_addr[1]);
+                vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]);
+                vx_bool chroma = ((y & 1u) == 0u ? vx_true_e : vx_false_e);
+                yuv2yuv_601to709_row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]),
+                                     &crcb[u_pix], &crcb[v_pix], dst_addr[0].dim_x,
+                                     vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]),
+                                     chroma ? &cbcr[u_out] : NULL, chroma ? &cbcr[v_out] : NULL);
             }
         }
         else if (dst_format == VX_DF_IMAGE_YUV4)
         {
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
-                {
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                    vx_uint8 *yout = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                    yout[0] = luma[0];
-                    cb[0] = crcb[u_pix];
-                    cr[0] = crcb[v_pix];
-                }
+                const vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], 0, y, &src_addr[1]);
+                store_row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]), dst_addr[0].dim_x,
+                          vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), 1u);
+                upsample_row(&crcb[u_pix], 2u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]));
+                upsample_row(&crcb[v_pix], 2u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]));
             }
         }
         else if (dst_format == VX_DF_IMAGE_IYUV)
         {
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
+                store_row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]), dst_addr[0].dim_x,
+                          vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), 1u);
+                if ((y & 1u) == 0u)
                 {
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                    vx_uint8 *yout = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                    yout[0] = luma[0];
-                    cb[0] = crcb[u_pix];
-                    cr[0] = crcb[v_pix];
+                    const vx_uint8 *crcb = vxFormatImagePatchAddress2d(src_base[1], 0, y, &src_addr[1]);
+                    gather_row(&crcb[u_pix], 2u, dst_addr[0].dim_x / 2u, vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]));
+                    gather_row(&crcb[v_pix], 2u, dst_addr[0].dim_x / 2u, vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]));
                 }
             }
         }
     }
-    else if (src_format == VX_DF_IMAGE_YUYV)
+    else if (src_format == VX_DF_IMAGE_YUYV || src_format == VX_DF_IMAGE_UYVY)
     {
-        if (dst_format == VX_DF_IMAGE_RGB)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y++)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-
-                    if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                        src_space == VX_COLOR_SPACE_BT601_625)
-                    {
-                        yuv2rgb_bt601(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt601(yuyv[2],yuyv[1],yuyv[3],&rgb[3],&rgb[4],&rgb[5]);
-                    }
-                    else /*if (src_space == VX_COLOR_SPACE_BT709)*/
-                    {
-                        yuv2rgb_bt709(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt709(yuyv[2],yuyv[1],yuyv[3],&rgb[3],&rgb[4],&rgb[5]);
-                    }
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_RGBX)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y++)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    rgb[3] = rgb[7] = 255;
-
-                    if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                        src_space == VX_COLOR_SPACE_BT601_625)
-                    {
-                        yuv2rgb_bt601(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt601(yuyv[2],yuyv[1],yuyv[3],&rgb[4],&rgb[5],&rgb[6]);
-                    }
-                    else /*if (src_space == VX_COLOR_SPACE_BT709)*/
-                    {
-                        yuv2rgb_bt709(yuyv[0],yuyv[1],yuyv[3],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt709(yuyv[2],yuyv[1],yuyv[3],&rgb[4],&rgb[5],&rgb[6]);
-                    }
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_NV12)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y+=2)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *yuyv[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                          vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                    vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                          vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                          vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                          vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                    vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    luma[0][0] = yuyv[0][0];
-                    luma[1][0] = yuyv[0][2];
-                    luma[2][0] = yuyv[1][0];
-                    luma[3][0] = yuyv[1][2];
-                    cbcr[0] = (yuyv[0][1] + yuyv[1][1])/2;
-                    cbcr[1] = (yuyv[0][3] + yuyv[1][3])/2;
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_YUV4)
+        int y_pix = src_format == VX_DF_IMAGE_YUYV ? 0 : 1;
+        int u_pix = src_format == VX_DF_IMAGE_YUYV ? 1 : 0;
+        int v_pix = src_format == VX_DF_IMAGE_YUYV ? 3 : 2;
+        if ((dst_format == VX_DF_IMAGE_RGB) || (dst_format == VX_DF_IMAGE_RGBX))
         {
+            vx_yuv2rgb_row_f row = yuv2rgb_row_select(src_format, dst_format);
+            const vx_yuv2rgb_coeffs_t *coeffs = yuv2rgb_coeffs(src_space);
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                    luma[0] = yuyv[0];
-                    luma[1] = yuyv[2];
-                    cb[0] = yuyv[1];
-                    cr[0] = yuyv[3];
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_IYUV)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y+=2)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *yuyv[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                          vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                    vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                          vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                          vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                          vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                    vx_uint8 *cb = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-                    luma[0][0] = yuyv[0][0];
-                    luma[1][0] = yuyv[0][2];
-                    luma[2][0] = yuyv[1][0];
-                    luma[3][0] = yuyv[1][2];
-                    cb[0] = (yuyv[0][1] + yuyv[1][1])/2;
-                    cr[0] = (yuyv[0][3] + yuyv[1][3])/2;
-                }
+                const vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]);
+                row(&yuyv[y_pix], &yuyv[u_pix], &yuyv[v_pix],
+                    vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), dst_addr[0].dim_x, coeffs);
             }
         }
-    }
-    else if (src_format == VX_DF_IMAGE_UYVY)
-    {
-        if (dst_format == VX_DF_IMAGE_RGB)
+        else
         {
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
+                const vx_uint8 *yuyv = vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]);
+                gather_row(&yuyv[y_pix], 2u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]));
+                if (dst_format == VX_DF_IMAGE_YUV4)
                 {
-                    vx_uint8 *uyvy = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-
-                    if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                        src_space == VX_COLOR_SPACE_BT601_625)
-                    {
-                        yuv2rgb_bt601(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt601(uyvy[3],uyvy[0],uyvy[2],&rgb[3],&rgb[4],&rgb[5]);
-                    }
-                    else /*if (src_space == VX_COLOR_SPACE_BT709)*/
-                    {
-                        yuv2rgb_bt709(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt709(uyvy[3],uyvy[0],uyvy[2],&rgb[3],&rgb[4],&rgb[5]);
-                    }
+                    upsample_row(&yuyv[u_pix], 4u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]));
+                    upsample_row(&yuyv[v_pix], 4u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]));
                 }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_RGBX)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y++)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
+                else if ((y & 1u) == 0u)
                 {
-                    vx_uint8 *uyvy = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    rgb[3] = rgb[7] = 255;
-
-                    if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                        src_space == VX_COLOR_SPACE_BT601_625)
+                    /* the chroma of 4:2:0 is the average of the chroma of a pair of rows */
+                    const vx_uint8 *next = vxFormatImagePatchAddress2d(src_base[0], 0, y + 1u, &src_addr[0]);
+                    if (dst_format == VX_DF_IMAGE_NV12)
                     {
-                        yuv2rgb_bt601(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt601(uyvy[3],uyvy[0],uyvy[2],&rgb[4],&rgb[5],&rgb[6]);
+                        vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]);
+                        average_row(&yuyv[u_pix], &next[u_pix], 4u, dst_addr[0].dim_x / 2u, &cbcr[0], 2u);
+                        average_row(&yuyv[v_pix], &next[v_pix], 4u, dst_addr[0].dim_x / 2u, &cbcr[1], 2u);
                     }
-                    else /*if (src_space == VX_COLOR_SPACE_BT709)*/
+                    else /* VX_DF_IMAGE_IYUV */
                     {
-                        yuv2rgb_bt709(uyvy[1],uyvy[0],uyvy[2],&rgb[0],&rgb[1],&rgb[2]);
-                        yuv2rgb_bt709(uyvy[3],uyvy[0],uyvy[2],&rgb[4],&rgb[5],&rgb[6]);
+                        average_row(&yuyv[u_pix], &next[u_pix], 4u, dst_addr[0].dim_x / 2u,
+                                    vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]), 1u);
+                        average_row(&yuyv[v_pix], &next[v_pix], 4u, dst_addr[0].dim_x / 2u,
+                                    vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]), 1u);
                     }
                 }
             }
         }
-        else if (dst_format == VX_DF_IMAGE_NV12)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y+=2)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *uyvy[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                         vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                    vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                    vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    luma[0][0] = uyvy[0][1];
-                    luma[1][0] = uyvy[0][3];
-                    luma[2][0] = uyvy[1][1];
-                    luma[3][0] = uyvy[1][3];
-                    cbcr[0] = (uyvy[0][0] + uyvy[1][0])/2;
-                    cbcr[1] = (uyvy[0][2] + uyvy[1][2])/2;
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_YUV4)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y++)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *uyvy = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-
-                    luma[0] = uyvy[1];
-                    luma[1] = uyvy[3];
-                    cb[0] = uyvy[0];
-                    cr[0] = uyvy[2];
-                }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_IYUV)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y+=2)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x+=2)
-                {
-                    vx_uint8 *uyvy[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                         vxFormatImagePatchAddress2d(src_base[0], x, y+1, &src_addr[0])};
-                    vx_uint8 *luma[4] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x, y+1, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x+1, y+1, &dst_addr[0])};
-                    vx_uint8 *cb = vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1]);
-                    vx_uint8 *cr = vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2]);
-                    luma[0][0] = uyvy[0][1];
-                    luma[1][0] = uyvy[0][3];
-                    luma[2][0] = uyvy[1][1];
-                    luma[3][0] = uyvy[1][3];
-                    cb[0] = (uyvy[0][0] + uyvy[1][0])/2;
-                    cr[0] = (uyvy[0][2] + uyvy[1][2])/2;
-                }
-            }
-        }
     }
     else if (src_format == VX_DF_IMAGE_IYUV)
     {
-        if (dst_format == VX_DF_IMAGE_RGB || dst_format == VX_DF_IMAGE_RGBX)
+        if ((dst_format == VX_DF_IMAGE_RGB) || (dst_format == VX_DF_IMAGE_RGBX))
         {
+            vx_yuv2rgb_row_f row = yuv2rgb_row_select(src_format, dst_format);
+            const vx_yuv2rgb_coeffs_t *coeffs = yuv2rgb_coeffs(src_space);
+            /*! \todo restricted range 601 ? */
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
-                {
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(src_base[2], x, y, &src_addr[2]);
-                    vx_uint8 *rgb  = vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]);
-                    if (dst_format == VX_DF_IMAGE_RGBX)
-                        rgb[3] = 255;
-
-                    /*! \todo restricted range 601 ? */
-                    if (src_space == VX_COLOR_SPACE_BT601_525 ||
-                        src_space == VX_COLOR_SPACE_BT601_625)
-                        yuv2rgb_bt601(luma[0],cb[0],cr[0],&rgb[0],&rgb[1],&rgb[2]);
-                    else /*if (src_space == VX_COLOR_SPACE_BT709)*/
-                        yuv2rgb_bt709(luma[0],cb[0],cr[0],&rgb[0],&rgb[1],&rgb[2]);
-                }
+                row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]),
+                    vxFormatImagePatchAddress2d(src_base[1], 0, y, &src_addr[1]),
+                    vxFormatImagePatchAddress2d(src_base[2], 0, y, &src_addr[2]),
+                    vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), dst_addr[0].dim_x, coeffs);
             }
         }
-        else if (dst_format == VX_DF_IMAGE_NV12)
+        else
         {
             for (y = 0; y < dst_addr[0].dim_y; y++)
             {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
+                const vx_uint8 *cb = vxFormatImagePatchAddress2d(src_base[1], 0, y, &src_addr[1]);
+                const vx_uint8 *cr = vxFormatImagePatchAddress2d(src_base[2], 0, y, &src_addr[2]);
+                store_row(vxFormatImagePatchAddress2d(src_base[0], 0, y, &src_addr[0]), dst_addr[0].dim_x,
+                          vxFormatImagePatchAddress2d(dst_base[0], 0, y, &dst_addr[0]), 1u);
+                if (dst_format == VX_DF_IMAGE_YUV4)
                 {
-                    vx_uint8 *luma = vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]);
-                    vx_uint8 *cb   = vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]);
-                    vx_uint8 *cr   = vxFormatImagePatchAddress2d(src_base[2], x, y, &src_addr[2]);
-                    vx_uint8 *nv12[2] = {vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1])};
-                    nv12[0][0] = luma[0];
-                    nv12[1][0] = cb[0];
-                    nv12[1][1] = cr[0];
+                    upsample_row(cb, 1u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]));
+                    upsample_row(cr, 1u, dst_addr[0].dim_x, vxFormatImagePatchAddress2d(dst_base[2], 0, y, &dst_addr[2]));
                 }
-            }
-        }
-        else if (dst_format == VX_DF_IMAGE_YUV4)
-        {
-            for (y = 0; y < dst_addr[0].dim_y; y++)
-            {
-                for (x = 0; x < dst_addr[0].dim_x; x++)
+                else if ((y & 1u) == 0u) /* VX_DF_IMAGE_NV12 */
                 {
-                    vx_uint8 *luma[2] = {vxFormatImagePatchAddress2d(src_base[0], x, y, &src_addr[0]),
-                                         vxFormatImagePatchAddress2d(dst_base[0], x, y, &dst_addr[0])};
-                    vx_uint8 *cb[2]   = {vxFormatImagePatchAddress2d(src_base[1], x, y, &src_addr[1]),
-                                         vxFormatImagePatchAddress2d(dst_base[1], x, y, &dst_addr[1])};
-                    vx_uint8 *cr[2]   = {vxFormatImagePatchAddress2d(src_base[2], x, y, &src_addr[2]),
-                                         vxFormatImagePatchAddress2d(dst_base[2], x, y, &dst_addr[2])};
-                    luma[1][0] = luma[0][0];
-                    cb[1][0] = cb[0][0];
-                    cr[1][0] = cr[0][0];
+                    vx_uint8 *cbcr = vxFormatImagePatchAddress2d(dst_base[1], 0, y, &dst_addr[1]);
+                    store_row(cb, dst_addr[0].dim_x / 2u, &cbcr[0], 2u);
+                    store_row(cr, dst_addr[0].dim_x / 2u, &cbcr[1], 2u);
                 }
             }
         }
     }
-    status = VX_SUCCESS;
+    status = converted;
     for (p = 0; p < src_planes; p++)
     {
         status |= vxCommitImagePatch(src, NULL, p, &src_addr[p], src_base[p]);
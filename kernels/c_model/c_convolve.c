@@ -23,6 +23,131 @@
 
 #include <c_model.h>
 #include <VX/vx.h>
+#include <stdlib.h>
+#include <string.h>
+
+static vx_int32 vx_gcd(vx_int32 a, vx_int32 b)
+{
+    while (b != 0)
+    {
+        vx_int32 t = a % b;
+        a = b;
+        b = t;
+    }
+    return (a < 0 ? -a : a);
+}
+
+/* Splits the matrix into an integer column and row with mat[r][c] == col[r] * row[c].
+ * The row is reduced by the gcd of its entries, so the column is an integer whenever
+ * the matrix is the product of integer vectors.
+ */
+static vx_bool vxSeparateConvolution(const vx_int32 *mat, vx_int32 cols, vx_int32 rows,
+                                     vx_int32 col[C_MAX_CONVOLUTION_DIM], vx_int32 row[C_MAX_CONVOLUTION_DIM])
+{
+    vx_int32 r, c, pr = -1, pc = -1, g = 0;
+    for (r = 0; (r < rows) && (pr < 0); r++)
+    {
+        for (c = 0; c < cols; c++)
+        {
+            if (mat[r * cols + c] != 0)
+            {
+                pr = r;
+                break;
+            }
+        }
+    }
+    if (pr < 0)
+        return vx_false_e;
+    for (c = 0; c < cols; c++)
+    {
+        g = vx_gcd(g, mat[pr * cols + c]);
+    }
+    for (c = 0; c < cols; c++)
+    {
+        row[c] = mat[pr * cols + c] / g;
+        if ((pc < 0) && (row[c] != 0))
+            pc = c;
+    }
+    for (r = 0; r < rows; r++)
+    {
+        if ((mat[r * cols + pc] % row[pc]) != 0)
+            return vx_false_e;
+        col[r] = mat[r * cols + pc] / row[pc];
+    }
+    for (r = 0; r < rows; r++)
+    {
+        for (c = 0; c < cols; c++)
+        {
+            if (mat[r * cols + c] != col[r] * row[c])
+                return vx_false_e;
+        }
+    }
+    return vx_true_e;
+}
+
+/* acc[x] += k * src[x], the loops have no branches so the compiler vectorizes them. */
+static void vxMacRow_u8(const vx_uint8 *src, vx_int32 k, vx_int32 *acc, vx_int32 count)
+{
+    vx_int32 x;
+    for (x = 0; x < count; x++)
+        acc[x] += k * src[x];
+}
+
+static void vxMacRow_s16(const vx_int16 *src, vx_int32 k, vx_int32 *acc, vx_int32 count)
+{
+    vx_int32 x;
+    for (x = 0; x < count; x++)
+        acc[x] += k * src[x];
+}
+
+static void vxMacRow_s32(const vx_int32 *src, vx_int32 k, vx_int32 *acc, vx_int32 count)
+{
+    vx_int32 x;
+    for (x = 0; x < count; x++)
+        acc[x] += k * src[x];
+}
+
+/* Accumulates the taps of one row of the matrix over a row of the source, which starts
+ * at the leftmost tap of the first output.
+ */
+static void vxMacTaps(const void *src, vx_df_image format, const vx_int32 *taps, vx_int32 num_taps,
+                      vx_int32 *acc, vx_int32 count)
+{
+    vx_int32 c;
+    for (c = 0; c < num_taps; c++)
+    {
+        if (taps[c] == 0)
+            continue;
+        if (format == VX_DF_IMAGE_U8)
+            vxMacRow_u8((const vx_uint8 *)src + c, taps[c], acc, count);
+        else
+            vxMacRow_s16((const vx_int16 *)src + c, taps[c], acc, count);
+    }
+}
+
+/* Divides by the power of two scale with the truncation of the integer division and saturates. */
+static void vxStoreConvolvedRow(const vx_int32 *acc, vx_int32 count, vx_uint32 shift, void *dst, vx_df_image format)
+{
+    vx_int32 x, bias = (vx_int32)((1u << shift) - 1u);
+    if (format == VX_DF_IMAGE_U8)
+    {
+        vx_uint8 *d = (vx_uint8 *)dst;
+        for (x = 0; x < count; x++)
+        {
+            vx_int32 value = (acc[x] + (acc[x] < 0 ? bias : 0)) >> shift;
+            d[x] = (vx_uint8)(value < 0 ? 0 : (value > UINT8_MAX ? UINT8_MAX : value));
+        }
+    }
+    else
+    {
+        vx_int16 *d = (vx_int16 *)dst;
+        for (x = 0; x < count; x++)
+        {
+            vx_int32 value = (acc[x] + (acc[x] < 0 ? bias : 0)) >> shift;
+            d[x] = (vx_int16)(value < INT16_MIN ? INT16_MIN : (value > INT16_MAX ? INT16_MAX : value));
+        }
+    }
+}
 
 // nodeless version of the Convolve kernel
 vx_status vxConvolve(vx_image src, vx_convolution conv, vx_image dst, vx_border_mode_t *bordermode)
@@ -41,6 +166,11 @@ vx_status vxConvolve(vx_image src, vx_convolution conv, vx_image dst, vx_border_
     vx_df_image dst_format = 0;
     vx_status status  = VX_SUCCESS;
     vx_int32 low_x, low_y, high_x, high_y;
+    vx_int32 taps[C_MAX_CONVOLUTION_DIM * C_MAX_CONVOLUTION_DIM];
+    vx_int32 row_taps[C_MAX_CONVOLUTION_DIM], col_taps[C_MAX_CONVOLUTION_DIM];
+    vx_int32 *acc = NULL, count = 0, computed = 0;
+    vx_uint32 shift = 0u;
+    vx_bool separable = vx_false_e;
 
     status |= vxQueryImage(src, VX_IMAGE_ATTRIBUTE_FORMAT, &src_format, sizeof(src_format));
     status |= vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_FORMAT, &dst_format, sizeof(dst_format));
@@ -70,10 +200,70 @@ vx_status vxConvolve(vx_image src, vx_convolution conv, vx_image dst, vx_border_
         high_y = src_addr.dim_y;
     }
 
+    /* The interior, where the whole matrix lies within the patch, is computed a row
+     * at a time. The matrix is flipped into taps which run along the source. A separable
+     * matrix has a row pass per source row, kept in a ring for the rows of the matrix,
+     * and a column pass over the ring. Any other matrix accumulates all of its taps.
+     */
+    if ((status == VX_SUCCESS) && ((conv_width & 1u) == 1u) && ((conv_height & 1u) == 1u) &&
+        (src_addr.dim_x > 2u * (vx_uint32)conv_radius_x) && (src_addr.dim_y > 2u * (vx_uint32)conv_radius_y) &&
+        (src_addr.stride_x == (src_format == VX_DF_IMAGE_U8 ? 1 : 2)) &&
+        (dst_addr.stride_x == (dst_format == VX_DF_IMAGE_U8 ? 1 : 2)) &&
+        (scale != 0u) && ((scale & (scale - 1u)) == 0u) && (scale <= (1u << 30)))
+    {
+        count = (vx_int32)src_addr.dim_x - 2 * conv_radius_x;
+        for (i = 0; i < (vx_int32)(conv_width * conv_height); i++)
+            taps[i] = conv_mat[conv_width * conv_height - 1 - i];
+        while ((1u << shift) < scale)
+            shift++;
+        separable = vxSeparateConvolution(taps, (vx_int32)conv_width, (vx_int32)conv_height, col_taps, row_taps);
+        acc = (vx_int32 *)malloc((separable ? conv_height + 1 : 1) * count * sizeof(vx_int32));
+    }
+
     for (y = low_y; y < high_y; ++y)
     {
+        vx_bool interior = ((acc != NULL) && (y >= conv_radius_y) && (y < (vx_int32)src_addr.dim_y - conv_radius_y) ? vx_true_e : vx_false_e);
+        if (interior == vx_true_e)
+        {
+            vx_int32 r;
+            memset(acc, 0, count * sizeof(vx_int32));
+            if (separable == vx_true_e)
+            {
+                vx_int32 *ring = &acc[count];
+                /* slide the ring of row passes down to the rows of the matrix around y */
+                if (computed < y - conv_radius_y)
+                    computed = y - conv_radius_y;
+                for (; computed <= y + conv_radius_y; computed++)
+                {
+                    vx_int32 *h = &ring[(computed % conv_height) * count];
+                    memset(h, 0, count * sizeof(vx_int32));
+                    vxMacTaps(vxFormatImagePatchAddress2d(src_base, 0, computed, &src_addr), src_format,
+                              row_taps, (vx_int32)conv_width, h, count);
+                }
+                for (r = 0; r < (vx_int32)conv_height; r++)
+                {
+                    vxMacRow_s32(&ring[((y - conv_radius_y + r) % conv_height) * count], col_taps[r], acc, count);
+                }
+            }
+            else
+            {
+                for (r = 0; r < (vx_int32)conv_height; r++)
+                {
+                    vxMacTaps(vxFormatImagePatchAddress2d(src_base, 0, y - conv_radius_y + r, &src_addr), src_format,
+                              &taps[r * conv_width], (vx_int32)conv_width, acc, count);
+                }
+            }
+            vxStoreConvolvedRow(acc, count, shift,
+                                vxFormatImagePatchAddress2d(dst_base, conv_radius_x, y, &dst_addr), dst_format);
+        }
         for (x = low_x; x < high_x; ++x)
         {
+            /* only the border columns are left in the interior rows */
+            if ((interior == vx_true_e) && (x == conv_radius_x))
+            {
+                x = (vx_int32)src_addr.dim_x - conv_radius_x - 1;
+                continue;
+            }
             sum = 0;
 
             if (src_format == VX_DF_IMAGE_U8)
@@ -114,6 +304,8 @@ vx_status vxConvolve(vx_image src, vx_convolution conv, vx_image dst, vx_border_
         }
     }
 
+    free(acc);
+
     status |= vxCommitConvolutionCoefficients(conv, NULL);
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
     status |= vxCommitImagePatch(dst, &rect, 0, &dst_addr, dst_base);
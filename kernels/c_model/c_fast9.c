@@ -22,29 +22,12 @@
  */
 
 #include <c_model.h>
-#include <stdio.h>
 
-#define PERMUTATIONS 16
-#define APERTURE 3
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
-static vx_uint8 indexes[PERMUTATIONS][9] = {
-    { 0, 1, 2, 3, 4, 5, 6, 7, 8},
-    {15, 0, 1, 2, 3, 4, 5, 6, 7},
-    {14,15, 0, 1, 2, 3, 4, 5, 6},
-    {13,14,15, 0, 1, 2, 3, 4, 5},
-    {12,13,14,15, 0, 1, 2, 3, 4},
-    {11,12,13,14,15, 0, 1, 2, 3},
-    {10,11,12,13,14,15, 0, 1, 2},
-    { 9,10,11,12,13,14,15, 0, 1},
-    { 8, 9,10,11,12,13,14,15, 0},
-    { 7, 8, 9,10,11,12,13,14,15},
-    { 6, 7, 8, 9,10,11,12,13,14},
-    { 5, 6, 7, 8, 9,10,11,12,13},
-    { 4, 5, 6, 7, 8, 9,10,11,12},
-    { 3, 4, 5, 6, 7, 8, 9,10,11},
-    { 2, 3, 4, 5, 6, 7, 8, 9,10},
-    { 1, 2, 3, 4, 5, 6, 7, 8, 9},
-};
+#define APERTURE 3
 
 /* offsets from "p" */
 static vx_int32 offsets[16][2] = {
@@ -66,72 +49,195 @@ static vx_int32 offsets[16][2] = {
     { -1, -3},
 };
 
+/*! \brief Whether a 16 bit mask of the ring has 9 contiguous bits set, wrapping around. */
+static VX_INLINE vx_bool vxHasArc9(vx_uint32 m)
+{
+    vx_uint32 r;
+    m |= m << 16;
+    r = m & (m >> 1);
+    r &= r >> 2;
+    r &= r >> 4;
+    r &= m >> 8;
+    return ((r & 0xFFFFu) != 0u ? vx_true_e : vx_false_e);
+}
 
-static vx_bool vxIsFastCorner(const vx_uint8* buf, vx_uint8 p, vx_uint8 tolerance)
+/*! \brief Returns the strength of the corner at p, or 0 if it is not one.
+ * \details The strength is the largest threshold at which the pixel is still a
+ * corner, which is the best over the 16 arcs of 9 pixels of the margin between p
+ * and the nearest pixel of the arc. The minima and maxima of the arcs are built up
+ * from those of shorter arcs.
+ */
+static vx_uint8 vxFast9Score(const vx_uint8 *p, const vx_int32 ring[16], vx_uint8 tolerance)
 {
-    vx_int32 i, a;
-    for (a = 0; a < PERMUTATIONS; a++)
+    vx_int32 v = p[0], d[24], lo[22], hi[22], k, score = 0;
+    vx_uint32 bright = 0u, dark = 0u;
+
+    /* the high speed test: an arc of 9 covers two neighbouring compass points */
+    vx_int32 c0 = p[ring[0]], c4 = p[ring[4]], c8 = p[ring[8]], c12 = p[ring[12]];
+    vx_int32 b0 = c0 > v + tolerance, b4 = c4 > v + tolerance, b8 = c8 > v + tolerance, b12 = c12 > v + tolerance;
+    vx_int32 d0 = c0 < v - tolerance, d4 = c4 < v - tolerance, d8 = c8 < v - tolerance, d12 = c12 < v - tolerance;
+    if (!((b0 & b4) | (b4 & b8) | (b8 & b12) | (b12 & b0) |
+          (d0 & d4) | (d4 & d8) | (d8 & d12) | (d12 & d0)))
+        return 0;
+
+    for (k = 0; k < 16; k++)
     {
-        vx_bool isacorner = vx_true_e;
-        for (i = 0; i < dimof(indexes[a]); i++)
-        {
-            vx_uint8 j = indexes[a][i];
-            vx_uint8 v = buf[j];
-            if (v <= (p + tolerance))
-            {
-                isacorner = vx_false_e;
-            }
-        }
-        if (isacorner == vx_true_e)
-            return isacorner;
-        isacorner = vx_true_e;
-        for (i = 0; i < dimof(indexes[a]); i++)
+        d[k] = p[ring[k]] - v;
+        bright |= (vx_uint32)(d[k] > tolerance) << k;
+        dark |= (vx_uint32)(d[k] < -tolerance) << k;
+    }
+    if (!vxHasArc9(bright) && !vxHasArc9(dark))
+        return 0;
+
+    for (k = 16; k < 24; k++)
+        d[k] = d[k - 16];
+    for (k = 0; k < 22; k++)
+    {
+        lo[k] = (d[k] < d[k+1] ? d[k] : d[k+1]);
+        hi[k] = (d[k] > d[k+1] ? d[k] : d[k+1]);
+    }
+    for (k = 0; k < 20; k++)
+    {
+        lo[k] = (lo[k] < lo[k+2] ? lo[k] : lo[k+2]);
+        hi[k] = (hi[k] > hi[k+2] ? hi[k] : hi[k+2]);
+    }
+    for (k = 0; k < 16; k++)
+    {
+        lo[k] = (lo[k] < lo[k+4] ? lo[k] : lo[k+4]);
+        hi[k] = (hi[k] > hi[k+4] ? hi[k] : hi[k+4]);
+    }
+    for (k = 0; k < 16; k++)
+    {
+        vx_int32 l = (lo[k] < d[k+8] ? lo[k] : d[k+8]) - 1;
+        vx_int32 h = -(hi[k] > d[k+8] ? hi[k] : d[k+8]) - 1;
+        if (l > score)
+            score = l;
+        if (h > score)
+            score = h;
+    }
+    return (vx_uint8)score;
+}
+
+/*! \brief Computes the corner strengths of row y of a U8 patch, 0 where there is none
+ * or where the ring would leave the image.
+ */
+static void vxFast9ScoreRow(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                            vx_int32 y, vx_uint8 tolerance, vx_uint8 *score)
+{
+    vx_int32 w = (vx_int32)src_addr->dim_x, h = (vx_int32)src_addr->dim_y;
+    vx_int32 x = APERTURE, ring[16], k;
+    const vx_uint8 *row;
+
+    memset(score, 0, w);
+    if ((y < APERTURE) || (y >= h - APERTURE))
+        return;
+    row = (const vx_uint8 *)vxFormatImagePatchAddress2d(src_base, 0, y, src_addr);
+    for (k = 0; k < 16; k++)
+        ring[k] = offsets[k][1] * src_addr->stride_y + offsets[k][0] * src_addr->stride_x;
+#if defined(__SSE2__)
+    if (src_addr->stride_x == 1)
+    {
+        /* rejects 16 pixels at a time with the high speed test, flipping the sign bits
+         * for the unsigned compares */
+        const __m128i flip = _mm_set1_epi8((char)0x80);
+        const __m128i t = _mm_set1_epi8((char)tolerance);
+        for (; x + 16 <= w - APERTURE; x += 16)
         {
-            vx_uint8 j = indexes[a][i];
-            vx_uint8 v = buf[j];
-            if (v >= (p - tolerance))
+            const vx_uint8 *p = &row[x];
+            __m128i c = _mm_loadu_si128((const __m128i *)p);
+            __m128i up = _mm_xor_si128(_mm_adds_epu8(c, t), flip);
+            __m128i down = _mm_xor_si128(_mm_subs_epu8(c, t), flip);
+            __m128i v0 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + ring[0])), flip);
+            __m128i v4 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + ring[4])), flip);
+            __m128i v8 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + ring[8])), flip);
+            __m128i v12 = _mm_xor_si128(_mm_loadu_si128((const __m128i *)(p + ring[12])), flip);
+            __m128i b0 = _mm_cmpgt_epi8(v0, up), b4 = _mm_cmpgt_epi8(v4, up);
+            __m128i b8 = _mm_cmpgt_epi8(v8, up), b12 = _mm_cmpgt_epi8(v12, up);
+            __m128i d0 = _mm_cmpgt_epi8(down, v0), d4 = _mm_cmpgt_epi8(down, v4);
+            __m128i d8 = _mm_cmpgt_epi8(down, v8), d12 = _mm_cmpgt_epi8(down, v12);
+            __m128i m = _mm_or_si128(_mm_or_si128(_mm_and_si128(b0, b4), _mm_and_si128(b4, b8)),
+                                     _mm_or_si128(_mm_and_si128(b8, b12), _mm_and_si128(b12, b0)));
+            vx_uint32 mask;
+            m = _mm_or_si128(m, _mm_or_si128(_mm_or_si128(_mm_and_si128(d0, d4), _mm_and_si128(d4, d8)),
+                                             _mm_or_si128(_mm_and_si128(d8, d12), _mm_and_si128(d12, d0))));
+            mask = (vx_uint32)_mm_movemask_epi8(m);
+            while (mask)
             {
-                isacorner = vx_false_e;
+                vx_int32 i = 0;
+                while (((mask >> i) & 1u) == 0u)
+                    i++;
+                mask &= mask - 1u;
+                score[x + i] = vxFast9Score(p + i, ring, tolerance);
             }
         }
-        if (isacorner == vx_true_e)
-            return isacorner;
     }
-    return vx_false_e;
+#endif
+    for (; x < w - APERTURE; x++)
+    {
+        score[x] = vxFast9Score(&row[x * src_addr->stride_x], ring, tolerance);
+    }
 }
 
-
-static vx_uint8 vxGetFastCornerStrength(vx_int32 x, vx_int32 y, void* src_base,
-                                        vx_imagepatch_addressing_t* src_addr,
-                                        vx_uint8 tolerance)
+vx_uint32 vxFast9Rows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                      vx_uint8 tolerance, vx_bool do_nonmax, vx_uint32 y0, vx_uint32 y1,
+                      vx_uint8 *scores, vx_keypoint_t *corners, vx_size capacity)
 {
-    if (x < APERTURE || y < APERTURE || x >= src_addr->dim_x - APERTURE || y >= src_addr->dim_y - APERTURE)
-        return 0;
-    {
-    vx_uint8 p = *(vx_uint8*)vxFormatImagePatchAddress2d(src_base, x, y, src_addr);
-    vx_uint8 buf[16];
-    vx_int32 j;
-    vx_uint8 a, b = 255;
+    vx_uint32 w = src_addr->dim_x, num_corners = 0u, x, y;
+    vx_uint8 *rows[3];
+    vx_keypoint_t kp;
 
-    for (j = 0; j < 16; j++)
+    memset(&kp, 0, sizeof(kp));
+    if (y0 >= y1)
+        return 0u;
+    rows[0] = &scores[0];
+    rows[1] = &scores[w];
+    rows[2] = &scores[2u * w];
+    if (do_nonmax)
     {
-        buf[j] = *(vx_uint8*)vxFormatImagePatchAddress2d(src_base, x+offsets[j][0], y+offsets[j][1], src_addr);
+        vxFast9ScoreRow(src_base, src_addr, (vx_int32)y0 - 1, tolerance, rows[0]);
+        vxFast9ScoreRow(src_base, src_addr, (vx_int32)y0, tolerance, rows[1]);
     }
-
-    if (!vxIsFastCorner(buf, p, tolerance))
-        return 0;
-
-    a = tolerance;
-    while (b - a > 1)
+    for (y = y0; y < y1; y++)
     {
-        vx_uint8 c = (a + b)/2;
-        if (vxIsFastCorner(buf, p, c))
-            a = c;
+        const vx_uint8 *above = rows[0], *cur = rows[1], *below = rows[2];
+        if (do_nonmax)
+            vxFast9ScoreRow(src_base, src_addr, (vx_int32)y + 1, tolerance, rows[2]);
         else
-            b = c;
-    }
-    return a;
+            vxFast9ScoreRow(src_base, src_addr, (vx_int32)y, tolerance, rows[1]);
+        for (x = APERTURE; x + APERTURE < w; x++)
+        {
+            vx_uint8 strength = cur[x];
+            if (strength == 0)
+            {
+                /* skips the pixels which are not corners a word at a time */
+                vx_uint64 word = 0;
+                while ((x + 8u + APERTURE < w) && (memcpy(&word, &cur[x + 1u], sizeof(word)), word == 0u))
+                    x += 8u;
+                continue;
+            }
+            if (do_nonmax &&
+                !(strength >= above[x-1] && strength >= above[x] && strength >= above[x+1] &&
+                  strength >= cur[x-1] && strength > cur[x+1] &&
+                  strength > below[x-1] && strength > below[x] && strength > below[x+1]))
+                continue;
+            if (num_corners < capacity)
+            {
+                kp.x = x;
+                kp.y = y;
+                kp.strength = strength;
+                corners[num_corners] = kp;
+            }
+            num_corners++;
+        }
+        if (do_nonmax)
+        {
+            vx_uint8 *first = rows[0];
+            rows[0] = rows[1];
+            rows[1] = rows[2];
+            rows[2] = first;
+        }
     }
+    return num_corners;
 }
 
 // nodeless version of the Fast9Corners kernel
@@ -146,7 +252,6 @@ vx_status vxFast9Corners(vx_image src, vx_scalar sens, vx_scalar nonm, vx_array
     vx_bool do_nonmax;
     vx_uint32 num_corners = 0;
     vx_size dst_capacity = 0;
-    vx_keypoint_t kp;
 
     vx_status status = vxGetValidRegionImage(src, &rect);
     status |= vxAccessScalarValue(sens, &b);
@@ -157,46 +262,27 @@ vx_status vxFast9Corners(vx_image src, vx_scalar sens, vx_scalar nonm, vx_array
     tolerance = (vx_uint8)b;
     status |= vxQueryArray(points, VX_ARRAY_ATTRIBUTE_CAPACITY, &dst_capacity, sizeof(dst_capacity));
 
-    memset(&kp, 0, sizeof(kp));
-
     if (status == VX_SUCCESS)
     {
         /*! \todo implement other Fast9 Corners border modes */
         if (bordermode->mode == VX_BORDER_MODE_UNDEFINED)
         {
-            vx_int32 y, x;
-            for (y = APERTURE; y < (vx_int32)(src_addr.dim_y - APERTURE); y++)
+            vx_uint8 *scores = (vx_uint8 *)malloc(3u * src_addr.dim_x);
+            vx_keypoint_t *corners = (vx_keypoint_t *)malloc((dst_capacity > 0 ? dst_capacity : 1) * sizeof(vx_keypoint_t));
+            if (scores && corners)
             {
-                for (x = APERTURE; x < (vx_int32)(src_addr.dim_x - APERTURE); x++)
-                {
-                    vx_uint8 strength = vxGetFastCornerStrength(x, y, src_base, &src_addr, tolerance);
-                    if (strength > 0)
-                    {
-                        if (do_nonmax)
-                        {
-                            if (strength >= vxGetFastCornerStrength(x-1, y-1, src_base, &src_addr, tolerance) &&
-                                strength >= vxGetFastCornerStrength(x, y-1, src_base, &src_addr, tolerance) &&
-                                strength >= vxGetFastCornerStrength(x+1, y-1, src_base, &src_addr, tolerance) &&
-                                strength >= vxGetFastCornerStrength(x-1, y, src_base, &src_addr, tolerance) &&
-                                strength >  vxGetFastCornerStrength(x+1, y, src_base, &src_addr, tolerance) &&
-                                strength >  vxGetFastCornerStrength(x-1, y+1, src_base, &src_addr, tolerance) &&
-                                strength >  vxGetFastCornerStrength(x, y+1, src_base, &src_addr, tolerance) &&
-                                strength >  vxGetFastCornerStrength(x+1, y+1, src_base, &src_addr, tolerance))
-                                ;
-                            else
-                                continue;
-                        }
-                        if (num_corners < dst_capacity)
-                        {
-                            kp.x = x;
-                            kp.y = y;
-                            kp.strength = strength;
-                            status |= vxAddArrayItems(points, 1, &kp, 0);
-                        }
-                        num_corners++;
-                    }
-                }
+                num_corners = vxFast9Rows(src_base, &src_addr, tolerance, do_nonmax, 0u, src_addr.dim_y,
+                                          scores, corners, dst_capacity);
+                vx_size count = (num_corners < dst_capacity ? num_corners : dst_capacity);
+                if (count > 0u)
+                    status |= vxAddArrayItems(points, count, corners, sizeof(vx_keypoint_t));
             }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+            free(scores);
+            free(corners);
         }
         else
         {
@@ -209,4 +295,3 @@ vx_status vxFast9Corners(vx_image src, vx_scalar sens, vx_scalar nonm, vx_array
 
     return status;
 }
-
@@ -26,18 +26,63 @@
 
 
 // helpers
-static int vx_uint8_compare(const void *p1, const void *p2)
+static vx_uint8 vx_min_u8(vx_uint8 a, vx_uint8 b)
 {
-    vx_uint8 a = *(vx_uint8 *)p1;
-    vx_uint8 b = *(vx_uint8 *)p2;
-    if (a > b)
-        return 1;
-    else if (a == b)
-        return 0;
-    else
-        return -1;
+    return (a < b ? a : b);
 }
 
+static vx_uint8 vx_max_u8(vx_uint8 a, vx_uint8 b)
+{
+    return (a > b ? a : b);
+}
+
+static vx_uint8 vx_median3_u8(vx_uint8 a, vx_uint8 b, vx_uint8 c)
+{
+    return vx_max_u8(vx_min_u8(a, b), vx_min_u8(vx_max_u8(a, b), c));
+}
+
+/* The median of a 3x3 neighborhood is the median of the largest of the column
+ * minimums, the median of the column medians and the smallest of the column maximums.
+ */
+static vx_uint8 vx_median9_u8(vx_uint8 v[9])
+{
+    vx_uint8 lo[3], md[3], hi[3];
+    vx_uint32 c;
+    for (c = 0u; c < 3u; c++)
+    {
+        vx_uint8 a = v[c], b = v[3 + c], d = v[6 + c];
+        lo[c] = vx_min_u8(vx_min_u8(a, b), d);
+        hi[c] = vx_max_u8(vx_max_u8(a, b), d);
+        md[c] = vx_median3_u8(a, b, d);
+    }
+    return vx_median3_u8(vx_max_u8(vx_max_u8(lo[0], lo[1]), lo[2]),
+                         vx_median3_u8(md[0], md[1], md[2]),
+                         vx_min_u8(vx_min_u8(hi[0], hi[1]), hi[2]));
+}
+
+/* Computes the medians of the interior of a row. Every column is sorted once and
+ * shared by the three windows which overlap it. Both loops are free of branches and
+ * of border checks, so the compiler can keep a vector of pixels in flight.
+ */
+static void vxMedian3x3Row(const vx_uint8 *top, const vx_uint8 *mid, const vx_uint8 *bot,
+                           vx_uint8 *lo, vx_uint8 *md, vx_uint8 *hi, vx_uint32 width, vx_uint8 *dst)
+{
+    vx_uint32 x;
+    for (x = 0u; x < width; x++)
+    {
+        vx_uint8 a = top[x], b = mid[x], c = bot[x];
+        lo[x] = vx_min_u8(vx_min_u8(a, b), c);
+        hi[x] = vx_max_u8(vx_max_u8(a, b), c);
+        md[x] = vx_median3_u8(a, b, c);
+    }
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_uint8 l = vx_max_u8(vx_max_u8(lo[x-1], lo[x]), lo[x+1]);
+        vx_uint8 m = vx_median3_u8(md[x-1], md[x], md[x+1]);
+        vx_uint8 h = vx_min_u8(vx_min_u8(hi[x-1], hi[x]), hi[x+1]);
+        dst[x] = vx_median3_u8(l, m, h);
+    }
+}
 
 // nodeless version of the Median3x3 kernel
 vx_status vxMedian3x3(vx_image src, vx_image dst, vx_border_mode_t *borders)
@@ -48,6 +93,7 @@ vx_status vxMedian3x3(vx_image src, vx_image dst, vx_border_mode_t *borders)
     vx_imagepatch_addressing_t src_addr, dst_addr;
     vx_rectangle_t rect;
     vx_uint32 low_x = 0, low_y = 0, high_x, high_y;
+    vx_uint8 *columns = NULL;
 
     vx_status status = vxGetValidRegionImage(src, &rect);
     status |= vxAccessImagePatch(src, &rect, 0, &src_addr, &src_base, VX_READ_ONLY);
@@ -63,19 +109,40 @@ vx_status vxMedian3x3(vx_image src, vx_image dst, vx_border_mode_t *borders)
         vxAlterRectangle(&rect, 1, 1, -1, -1);
     }
 
+    /* the interior rows are computed from the sorted columns of the patch */
+    if ((status == VX_SUCCESS) && (src_addr.dim_x >= 3u) && (src_addr.dim_y >= 3u) &&
+        (src_addr.stride_x == 1) && (dst_addr.stride_x == 1))
+    {
+        columns = (vx_uint8 *)malloc(3u * src_addr.dim_x);
+    }
+
     for (y = low_y; (y < high_y) && (status == VX_SUCCESS); y++)
     {
+        vx_bool interior = ((columns != NULL) && (y > 0u) && (y < src_addr.dim_y - 1u) ? vx_true_e : vx_false_e);
+        if (interior == vx_true_e)
+        {
+            vxMedian3x3Row(vxFormatImagePatchAddress2d(src_base, 0, y - 1u, &src_addr),
+                           vxFormatImagePatchAddress2d(src_base, 0, y, &src_addr),
+                           vxFormatImagePatchAddress2d(src_base, 0, y + 1u, &src_addr),
+                           &columns[0], &columns[src_addr.dim_x], &columns[2u * src_addr.dim_x],
+                           src_addr.dim_x, vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr));
+        }
         for (x = low_x; x < high_x; x++)
         {
             vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
             vx_uint8 values[9];
 
+            /* only the border columns are left in the interior rows */
+            if ((interior == vx_true_e) && (x == 1u))
+            {
+                x = src_addr.dim_x - 2u;
+                continue;
+            }
             vxReadRectangle(src_base, &src_addr, borders, VX_DF_IMAGE_U8, x, y, 1, 1, values);
-
-            qsort(values, dimof(values), sizeof(vx_uint8), vx_uint8_compare);
-            *dst = values[4]; /* pick the middle value */
+            *dst = vx_median9_u8(values);
         }
     }
+    free(columns);
 
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
     status |= vxCommitImagePatch(dst, &rect, 0, &dst_addr, dst_base);
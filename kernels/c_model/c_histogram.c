@@ -23,6 +23,57 @@
 
 #include <c_model.h>
 #include <stdio.h>
+#include <string.h>
+
+void vxHistogramRows(void *base, vx_imagepatch_addressing_t *addr, vx_df_image format,
+                     vx_uint32 y0, vx_uint32 y1, vx_size offset, vx_size range, vx_uint32 window_size,
+                     vx_uint32 *bins)
+{
+    vx_uint32 x, y, k;
+    if (format == VX_DF_IMAGE_U8)
+    {
+        /* count the values first, consecutive pixels in different lanes */
+        vx_uint32 lanes[C_HISTOGRAM_LANES][256];
+        memset(lanes, 0, sizeof(lanes));
+        for (y = y0; y < y1; y++)
+        {
+            const vx_uint8 *row = vxFormatImagePatchAddress2d(base, 0, y, addr);
+            for (x = 0; x + C_HISTOGRAM_LANES <= addr->dim_x; x += C_HISTOGRAM_LANES)
+            {
+                for (k = 0; k < C_HISTOGRAM_LANES; k++)
+                    lanes[k][row[x + k]]++;
+            }
+            for (; x < addr->dim_x; x++)
+                lanes[0][row[x]]++;
+        }
+        /* then gather the values into the bins */
+        for (x = 0; x < 256u; x++)
+        {
+            if ((offset <= (vx_size)x) && ((vx_size)x < (offset+range)))
+            {
+                vx_size index = (x - (vx_uint16)offset) / window_size;
+                for (k = 0; k < C_HISTOGRAM_LANES; k++)
+                    bins[index] += lanes[k][x];
+            }
+        }
+    }
+    else if (format == VX_DF_IMAGE_U16)
+    {
+        for (y = y0; y < y1; y++)
+        {
+            const vx_uint16 *row = vxFormatImagePatchAddress2d(base, 0, y, addr);
+            for (x = 0; x < addr->dim_x; x++)
+            {
+                vx_uint16 pixel = row[x];
+                if ((offset <= (vx_size)pixel) && ((vx_size)pixel < (offset+range)))
+                {
+                    vx_size index = (pixel - (vx_uint16)offset) / window_size;
+                    bins[index]++;
+                }
+            }
+        }
+    }
+}
 
 // nodeless version of the Histogram kernel
 vx_status vxHistogram(vx_image src, vx_distribution dist)
@@ -33,7 +84,6 @@ vx_status vxHistogram(vx_image src, vx_distribution dist)
     void* dist_ptr = NULL;
     vx_df_image format = 0;
     vx_uint32 x = 0;
-    vx_uint32 y = 0;
     vx_size offset = 0;
     vx_size range = 0;
     vx_size numBins = 0;
@@ -59,32 +109,8 @@ vx_status vxHistogram(vx_image src, vx_distribution dist)
             dist_tmp[x] = 0;
         }
 
-        for (y = 0; y < src_addr.dim_y; y++)
-        {
-            for (x = 0; x < src_addr.dim_x; x++)
-            {
-                if (format == VX_DF_IMAGE_U8)
-                {
-                    vx_uint8 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                    vx_uint8 pixel = *src_ptr;
-                    if ((offset <= (vx_size)pixel) && ((vx_size)pixel < (offset+range)))
-                    {
-                        vx_size index = (pixel - (vx_uint16)offset) / window_size;
-                        dist_tmp[index]++;
-                    }
-                }
-                else if (format == VX_DF_IMAGE_U16)
-                {
-                    vx_uint16 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                    vx_uint16 pixel = *src_ptr;
-                    if ((offset <= (vx_size)pixel) && ((vx_size)pixel < (offset+range)))
-                    {
-                        vx_size index = (pixel - (vx_uint16)offset) / window_size;
-                        dist_tmp[index]++;
-                    }
-                }
-            }
-        }
+        vxHistogramRows(src_base, &src_addr, format, 0, src_addr.dim_y, offset, range, window_size,
+                        (vx_uint32 *)dist_tmp);
     }
     status |= vxCommitDistribution(dist, dist_ptr);
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
@@ -92,10 +118,69 @@ vx_status vxHistogram(vx_image src, vx_distribution dist)
     return status;
 }
 
+void vxEqualizeTable(const vx_uint32 hist[256], vx_uint32 count, vx_uint8 table[256])
+{
+    /* for 16-bit support (U16 or S16), the code can be duplicated with NUM_BINS = 65536 and PIXEL = vx_uint16. */
+    #define NUM_BINS 256
+
+    vx_uint32 cdf[NUM_BINS] = {0};
+    vx_uint32 sum = 0, div, x;
+    vx_uint8 minv = 0xFF;
+
+    /* the smallest pixel value is the first bin in use */
+    for (x = 0; x < NUM_BINS; x++)
+    {
+        if (hist[x] > 0)
+        {
+            minv = (vx_uint8)x;
+            break;
+        }
+    }
+    /* calculate the cumulative distribution (summed histogram) */
+    for (x = 0; x < NUM_BINS; x++)
+    {
+        sum += hist[x];
+        cdf[x] = sum;
+    }
+    div = count - cdf[minv];
+    if( div > 0 )
+    {
+        /* make a LUT for replacing pixel values */
+        for (x = 0; x < NUM_BINS; x++)
+        {
+            uint32_t cdfx = cdf[x] - cdf[minv];
+            vx_float32 p = (vx_float32)cdfx/(vx_float32)div;
+            table[x] = (uint8_t)(p * 255.0f + 0.5f);
+        }
+    }
+    else
+    {
+        for (x = 0; x < NUM_BINS; x++)
+        {
+            table[x] = (vx_uint8)x;
+        }
+    }
+}
+
+void vxLookupRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                  void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                  vx_uint32 y0, vx_uint32 y1, const vx_uint8 table[256])
+{
+    vx_uint32 x, y;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *src = vxFormatImagePatchAddress2d(src_base, 0, y, src_addr);
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y, dst_addr);
+        for (x = 0; x < src_addr->dim_x; x++)
+        {
+            dst[x] = table[src[x]];
+        }
+    }
+}
+
 // nodeless version of the EqualizeHist kernel
 vx_status vxEqualizeHist(vx_image src, vx_image dst)
 {
-    vx_uint32 y, x;
     void *src_base = NULL;
     void *dst_base = NULL;
     vx_imagepatch_addressing_t src_addr, dst_addr;
@@ -107,62 +192,13 @@ vx_status vxEqualizeHist(vx_image src, vx_image dst)
     status |= vxAccessImagePatch(dst, &rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
     if (status == VX_SUCCESS)
     {
-        /* for 16-bit support (U16 or S16), the code can be duplicated with NUM_BINS = 65536 and PIXEL = vx_uint16. */
-        #define NUM_BINS 256
-
-        /* allocate a fixed-size temp array to store the image histogram & cumulative distribution */
-        vx_uint32 hist[NUM_BINS] = {0};
-        vx_uint32 cdf[NUM_BINS] = {0};
-        vx_uint32 sum = 0, div;
-        vx_uint8 minv = 0xFF;
+        /* the histogram only lives long enough to become the table of the second pass */
+        vx_uint32 hist[256] = {0};
+        vx_uint8 table[256];
 
-        /* calculate the distribution (histogram) */
-        for (y = 0; y < src_addr.dim_y; y++)
-        {
-            for (x = 0; x < src_addr.dim_x; x++)
-            {
-                vx_uint8 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                vx_uint8 pixel = (*src_ptr);
-                hist[pixel]++;
-                if (minv > pixel)
-                    minv = pixel;
-            }
-        }
-        /* calculate the cumulative distribution (summed histogram) */
-        for (x = 0; x < NUM_BINS; x++)
-        {
-            sum += hist[x];
-            cdf[x] = sum;
-        }
-        div = (src_addr.dim_x * src_addr.dim_y) - cdf[minv];
-        if( div > 0 )
-        {
-            /* recompute the histogram to be a LUT for replacing pixel values */
-            for (x = 0; x < NUM_BINS; x++)
-            {
-                uint32_t cdfx = cdf[x] - cdf[minv];
-                vx_float32 p = (vx_float32)cdfx/(vx_float32)div;
-                hist[x] = (uint8_t)(p * 255.0f + 0.5f);
-            }
-        }
-        else
-        {
-            for (x = 0; x < NUM_BINS; x++)
-            {
-                hist[x] = x;
-            }
-        }
-
-        /* map the src pixel values to the equalized pixel values */
-        for (y = 0; y < src_addr.dim_y; y++)
-        {
-            for (x = 0; x < src_addr.dim_x; x++)
-            {
-                vx_uint8 *src_ptr = vxFormatImagePatchAddress2d(src_base, x, y, &src_addr);
-                vx_uint8 *dst_ptr = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
-                *dst_ptr = hist[(*src_ptr)];
-            }
-        }
+        vxHistogramRows(src_base, &src_addr, VX_DF_IMAGE_U8, 0, src_addr.dim_y, 0, 256, 1, hist);
+        vxEqualizeTable(hist, src_addr.dim_x * src_addr.dim_y, table);
+        vxLookupRows(src_base, &src_addr, dst_base, &dst_addr, 0, src_addr.dim_y, table);
     }
 
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
@@ -170,4 +206,3 @@ vx_status vxEqualizeHist(vx_image src, vx_image dst)
 
     return status;
 }
-
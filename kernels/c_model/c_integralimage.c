@@ -22,11 +22,57 @@
  */
 
 #include <c_model.h>
+#include <stdlib.h>
 
-// nodeless version of the XXXX kernel
-vx_status vxIntegralImage(vx_image src, vx_image dst)
+void vxColumnSumRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                     vx_uint32 y0, vx_uint32 y1, vx_uint32 *sums)
+{
+    vx_uint32 y, x;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *pixels = vxFormatImagePatchAddress2d(src_base, 0, y, src_addr);
+        for (x = 0; x < src_addr->dim_x; x++)
+        {
+            sums[x] += pixels[x];
+        }
+    }
+}
+
+void vxIntegralRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                    void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                    vx_uint32 y0, vx_uint32 y1, const vx_uint32 *above)
 {
     vx_uint32 y, x;
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *pixels = vxFormatImagePatchAddress2d(src_base, 0, y, src_addr);
+        vx_uint32 *sums = vxFormatImagePatchAddress2d(dst_base, 0, y - y0, dst_addr);
+        vx_uint32 sum = 0;
+
+        /* each sum is the prefix sum of its row on top of the sum above it */
+        if (above == NULL)
+        {
+            for (x = 0; x < src_addr->dim_x; x++)
+            {
+                sum += pixels[x];
+                sums[x] = sum;
+            }
+        }
+        else
+        {
+            for (x = 0; x < src_addr->dim_x; x++)
+            {
+                sum += pixels[x];
+                sums[x] = above[x] + sum;
+            }
+        }
+        above = sums;
+    }
+}
+
+// nodeless version of the IntegralImage kernel
+vx_status vxIntegralImage(vx_image src, vx_image dst)
+{
     void *src_base = NULL;
     void *dst_base = NULL;
     vx_imagepatch_addressing_t src_addr, dst_addr;
@@ -36,33 +82,65 @@ vx_status vxIntegralImage(vx_image src, vx_image dst)
     status = vxGetValidRegionImage(src, &rect);
     status |= vxAccessImagePatch(src, &rect, 0, &src_addr, &src_base, VX_READ_ONLY);
     status |= vxAccessImagePatch(dst, &rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
-
-    for (y = 0; (y < src_addr.dim_y) && (status == VX_SUCCESS); y++)
+    if (status == VX_SUCCESS)
     {
-        vx_uint8 *pixels = vxFormatImagePatchAddress2d(src_base, 0, y, &src_addr);
-        vx_uint32 *sums = vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr);
+        vxIntegralRows(src_base, &src_addr, dst_base, &dst_addr, 0, src_addr.dim_y, NULL);
+    }
+    status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
+    status |= vxCommitImagePatch(dst, &rect, 0, &dst_addr, dst_base);
 
-        if (y == 0)
+    return status;
+}
+
+// nodeless version of the IntegralImage kernel which only produces the rows [y0, y1)
+vx_status vxIntegralImageRows(vx_image src, vx_image dst, vx_uint32 y0, vx_uint32 y1)
+{
+    void *src_base = NULL;
+    void *dst_base = NULL;
+    vx_imagepatch_addressing_t src_addr, dst_addr;
+    vx_rectangle_t src_rect, dst_rect;
+    vx_uint32 *above = NULL;
+    vx_uint32 x;
+
+    vx_status status = VX_SUCCESS;
+    status = vxGetValidRegionImage(src, &src_rect);
+    if (status != VX_SUCCESS)
+        return status;
+    if ((y0 >= y1) || (y1 > src_rect.end_y - src_rect.start_y))
+        return VX_ERROR_INVALID_PARAMETERS;
+    /* the source is read down to the last row, the destination is only written in the rows */
+    src_rect.end_y = src_rect.start_y + y1;
+    dst_rect = src_rect;
+    dst_rect.start_y += y0;
+    status |= vxAccessImagePatch(src, &src_rect, 0, &src_addr, &src_base, VX_READ_ONLY);
+    status |= vxAccessImagePatch(dst, &dst_rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
+    if (status == VX_SUCCESS)
+    {
+        /* the row above the first row is the prefix sum of the column sums above it */
+        if (y0 > 0)
         {
-            sums[0] = pixels[0];
-            for (x = 1; x < src_addr.dim_x; x++)
+            above = (vx_uint32 *)calloc(src_addr.dim_x, sizeof(vx_uint32));
+            if (above)
             {
-                sums[x] = sums[x-1] + pixels[x];
+                vxColumnSumRows(src_base, &src_addr, 0, y0, above);
+                for (x = 1; x < src_addr.dim_x; x++)
+                {
+                    above[x] += above[x-1];
+                }
             }
-        }
-        else
-        {
-            vx_uint32 *prev_sums = vxFormatImagePatchAddress2d(dst_base, 0, y-1, &dst_addr);
-            sums[0] = prev_sums[0] + pixels[0];
-            for (x = 1; x < src_addr.dim_x; x++)
+            else
             {
-                sums[x] = pixels[x] + sums[x-1] + prev_sums[x] - prev_sums[x-1];
+                status = VX_ERROR_NO_MEMORY;
             }
         }
+        if (status == VX_SUCCESS)
+        {
+            vxIntegralRows(src_base, &src_addr, dst_base, &dst_addr, y0, y1, above);
+        }
+        free(above);
     }
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
-    status |= vxCommitImagePatch(dst, &rect, 0, &dst_addr, dst_base);
+    status |= vxCommitImagePatch(dst, &dst_rect, 0, &dst_addr, dst_base);
 
     return status;
 }
-
@@ -32,10 +32,48 @@
  */
 #define C_MAX_CONVOLUTION_DIM (15)
 
+/*! \brief Marks the row buffers of the row operations as not aliased so their loops vectorize.
+ */
+#if defined(_MSC_VER)
+#define VX_RESTRICT __restrict
+#else
+#define VX_RESTRICT restrict
+#endif
+
+/*! \brief Lets a generic row operation be specialized into each of its callers.
+ */
+#ifndef VX_INLINE
+#if defined(_WIN32) && !defined(__GNUC__)
+#define VX_INLINE _inline
+#else
+#define VX_INLINE inline
+#endif
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+/*! \brief The row operations of the 3x3 filters. Each produces the columns [1, width-1)
+ * of one row, a row pass over a row of the source and a column pass over three rows of
+ * row pass results. The division of the convolutions is a multiply by mult and a right
+ * shift by shift of the magnitude of the sum.
+ */
+typedef struct _vx_row_ops_t {
+    void (*convolve_row)(const vx_uint8 *src, vx_uint32 width, const vx_int32 k[3], vx_int32 *dst);
+    void (*convolve_column_u8)(const vx_int32 *r0, const vx_int32 *r1, const vx_int32 *r2,
+                               vx_uint32 width, const vx_int32 k[3], vx_uint32 mult, vx_uint32 shift, vx_uint8 *dst);
+    void (*convolve_column_s16)(const vx_int32 *r0, const vx_int32 *r1, const vx_int32 *r2,
+                                vx_uint32 width, const vx_int32 k[3], vx_uint32 mult, vx_uint32 shift, vx_int16 *dst);
+    void (*erode_row)(const vx_uint8 *src, vx_uint32 width, vx_uint8 *dst);
+    void (*erode_column)(const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint8 *dst);
+    void (*dilate_row)(const vx_uint8 *src, vx_uint32 width, vx_uint8 *dst);
+    void (*dilate_column)(const vx_uint8 *r0, const vx_uint8 *r1, const vx_uint8 *r2, vx_uint32 width, vx_uint8 *dst);
+} vx_row_ops_t;
+
+/*! \brief Returns the row operations for the instruction set of the host CPU. */
+const vx_row_ops_t *vxGetRowOps(void);
+
 vx_status vxAbsDiff(vx_image in1, vx_image in2, vx_image output);
 
 vx_status vxAccumulate(vx_image input, vx_image accum);
@@ -62,14 +100,74 @@ vx_status vxConvolution3x3(vx_image src, vx_image dst, vx_int16 conv[3][3], cons
 vx_status vxFast9Corners(vx_image src, vx_scalar sens, vx_scalar nonm,
                          vx_array points, vx_scalar num_corners, vx_border_mode_t *bordermode);
 
+/*! \brief Finds the FAST9 corners of the rows [y0, y1) of a U8 patch in raster order.
+ * \details Returns the number of corners found and stores the first capacity of them in
+ * corners. scores is scratch space for 3 rows of the patch. The rows next to the band
+ * are read for the non-maximum suppression, so bands of an image can be searched
+ * concurrently and their corners appended in order.
+ */
+vx_uint32 vxFast9Rows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                      vx_uint8 tolerance, vx_bool do_nonmax, vx_uint32 y0, vx_uint32 y1,
+                      vx_uint8 *scores, vx_keypoint_t *corners, vx_size capacity);
+
 vx_status vxMedian3x3(vx_image src, vx_image dst, vx_border_mode_t *bordermode);
 vx_status vxBox3x3(vx_image src, vx_image dst, vx_border_mode_t *bordermode);
 vx_status vxGaussian3x3(vx_image src, vx_image dst, vx_border_mode_t *bordermode);
 
+/*! \brief The number of sub-histograms consecutive pixels are counted in by \ref vxHistogramRows,
+ * so runs of equal pixels do not wait on the increments of one counter.
+ */
+#define C_HISTOGRAM_LANES (4)
+
+/*! \brief Adds the pixels of the rows [y0, y1) of a U8 or U16 patch to the bins of a distribution.
+ * \details Each call only touches its own bins, so the rows of an image can be counted
+ * into separate bins concurrently and the bins added together afterwards.
+ */
+void vxHistogramRows(void *base, vx_imagepatch_addressing_t *addr, vx_df_image format,
+                     vx_uint32 y0, vx_uint32 y1, vx_size offset, vx_size range, vx_uint32 window_size,
+                     vx_uint32 *bins);
+
+/*! \brief Computes the table which equalizes a 256 bin histogram of count pixels. */
+void vxEqualizeTable(const vx_uint32 hist[256], vx_uint32 count, vx_uint8 table[256]);
+
+/*! \brief Replaces the pixels of the rows [y0, y1) of a U8 patch by their entries in a table. */
+void vxLookupRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                  void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                  vx_uint32 y0, vx_uint32 y1, const vx_uint8 table[256]);
+
 vx_status vxHistogram(vx_image src, vx_distribution dist);
 vx_status vxEqualizeHist(vx_image src, vx_image dst);
 
+/*! \brief Adds the pixels of the rows [y0, y1) of a U8 patch to the sums of its columns. */
+void vxColumnSumRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                     vx_uint32 y0, vx_uint32 y1, vx_uint32 *sums);
+
+/*! \brief Computes the rows [y0, y1) of the integral image of a U8 patch.
+ * \details dst_base points at the row y0 of the destination. above is the row y0-1 of
+ * the integral image, or NULL when y0 is 0, which is the prefix sum of the column sums
+ * of the rows above y0. With it, bands of rows are independent of each other.
+ */
+void vxIntegralRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                    void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                    vx_uint32 y0, vx_uint32 y1, const vx_uint32 *above);
+
 vx_status vxIntegralImage(vx_image src, vx_image dst);
+
+/*! \brief Only produces the rows [y0, y1) of the integral image, for a consumer which
+ * requests the image a band at a time.
+ */
+vx_status vxIntegralImageRows(vx_image src, vx_image dst, vx_uint32 y0, vx_uint32 y1);
+/*! \brief Computes the rows [y0, y1) of a level of a Gaussian pyramid from the level above it.
+ * \details Destination pixel (x, y) is the 5x5 Gaussian of the source around (xs[x], ys[y]),
+ * which must lie inside of the source, so only the surviving pixels are filtered. half
+ * says that xs[x] is 2x+1. column is scratch space for the source width plus 4.
+ */
+void vxGaussianPyramidRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                           void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                           const vx_int32 *xs, const vx_int32 *ys, vx_bool half,
+                           vx_uint32 y0, vx_uint32 y1,
+                           const vx_border_mode_t *borders, vx_int32 *column);
+
 vx_status vxTableLookup(vx_image src, vx_lut lut, vx_image dst);
 
 vx_status vxMeanStdDev(vx_image input, vx_scalar mean, vx_scalar stddev);
@@ -86,7 +184,43 @@ vx_status vxOpticalFlowPyrLK(/*p1, p2, p3...*/);
 
 vx_status vxPhase(vx_image grad_x, vx_image grad_y, vx_image output);
 
-vx_status vxScaleImage(vx_image src_image, vx_image dst_image, vx_scalar stype, vx_border_mode_t *bordermode, vx_float64 *interm, vx_size size);
+/*! \brief The sampling of one axis of a scale.
+ * \details Destination pixel i reads the source pixels [start[i], start[i] + taps)
+ * weighted by weights[i * taps + k], which sum to 1 << 11. The destination pixels
+ * [lo, hi) are the ones whose taps all lie inside of the source.
+ */
+typedef struct _vx_scale_axis_t {
+    vx_uint32 taps;
+    vx_uint32 lo;
+    vx_uint32 hi;
+    vx_int32 *start;
+    vx_int16 *weights;
+} vx_scale_axis_t;
+
+/*! \brief The polyphase tables of a scale, built once by \ref vxScaleTables into a
+ * single block of \ref vxScaleTablesSize bytes.
+ */
+typedef struct _vx_scale_tables_t {
+    vx_enum type;
+    vx_uint32 src_width;
+    vx_uint32 src_height;
+    vx_uint32 dst_width;
+    vx_uint32 dst_height;
+    vx_scale_axis_t x;
+    vx_scale_axis_t y;
+} vx_scale_tables_t;
+
+/*! \brief Returns the bytes the tables of a scale need, or 0 when it can not be done. */
+vx_size vxScaleTablesSize(vx_enum type, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2);
+
+/*! \brief Builds the tables of a scale from w1 x h1 to w2 x h2 into size bytes at tables. */
+vx_status vxScaleTables(vx_enum type, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2,
+                        vx_scale_tables_t *tables, vx_size size);
+
+/*! \brief Scales an image with the tables of the node, or with its own when they
+ * were built for another scale.
+ */
+vx_status vxScaleImage(vx_image src_image, vx_image dst_image, vx_scalar stype, vx_border_mode_t *bordermode, vx_scale_tables_t *tables, vx_size size);
 
 vx_status vxSobel3x3(vx_image input, vx_image grad_x, vx_image grad_y, vx_border_mode_t *bordermode);
 
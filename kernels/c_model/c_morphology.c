@@ -22,6 +22,15 @@
  */
 
 #include <c_model.h>
+#include <stdlib.h>
+
+static vx_uint8 min_op(vx_uint8 a, vx_uint8 b) {
+    return a < b ? a : b;
+}
+
+static vx_uint8 max_op(vx_uint8 a, vx_uint8 b) {
+    return a > b ? a : b;
+}
 
 static vx_status vxMorphology3x3(vx_image src, vx_image dst, vx_uint8 (*op)(vx_uint8, vx_uint8), const vx_border_mode_t *borders)
 {
@@ -30,6 +39,12 @@ static vx_status vxMorphology3x3(vx_image src, vx_image dst, vx_uint8 (*op)(vx_u
     void *dst_base = NULL;
     vx_imagepatch_addressing_t src_addr, dst_addr;
     vx_rectangle_t rect;
+    const vx_row_ops_t *ops = vxGetRowOps();
+    void (*row_op)(const vx_uint8 *, vx_uint32, vx_uint8 *) = (op == min_op ? ops->erode_row : ops->dilate_row);
+    void (*column_op)(const vx_uint8 *, const vx_uint8 *, const vx_uint8 *, vx_uint32, vx_uint8 *) =
+        (op == min_op ? ops->erode_column : ops->dilate_column);
+    vx_uint8 *rows = NULL;
+    vx_uint32 computed = 0u;
 
     vx_status status = vxGetValidRegionImage(src, &rect);
     status |= vxAccessImagePatch(src, &rect, 0, &src_addr, &src_base, VX_READ_ONLY);
@@ -46,14 +61,46 @@ static vx_status vxMorphology3x3(vx_image src, vx_image dst, vx_uint8 (*op)(vx_u
         low_y += 1; high_y -= 1;
     }
 
+    /* the interior rows are computed with a row pass per source row, kept for the
+     * three output rows which use it, and a column pass.
+     */
+    if ((status == VX_SUCCESS) && (src_addr.dim_x >= 3u) && (src_addr.dim_y >= 3u) &&
+        (src_addr.stride_x == 1) && (dst_addr.stride_x == 1))
+    {
+        rows = (vx_uint8 *)malloc(3u * src_addr.dim_x);
+    }
+
     for (y = low_y; (y < high_y) && (status == VX_SUCCESS); y++)
     {
+        vx_bool interior = ((rows != NULL) && (y > 0u) && (y < src_addr.dim_y - 1u) ? vx_true_e : vx_false_e);
+        if (interior == vx_true_e)
+        {
+            vx_uint8 *r[3];
+            /* slide the window of row passes down to the rows around y */
+            if (computed < y - 1u)
+                computed = y - 1u;
+            for (; computed <= y + 1u; computed++)
+            {
+                row_op(vxFormatImagePatchAddress2d(src_base, 0, computed, &src_addr),
+                       src_addr.dim_x, &rows[(computed % 3u) * src_addr.dim_x]);
+            }
+            r[0] = &rows[((y - 1u) % 3u) * src_addr.dim_x];
+            r[1] = &rows[(y % 3u) * src_addr.dim_x];
+            r[2] = &rows[((y + 1u) % 3u) * src_addr.dim_x];
+            column_op(r[0], r[1], r[2], src_addr.dim_x, vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr));
+        }
         for (x = low_x; x < high_x; x++)
         {
             vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
             vx_uint8 pixels[9], m;
             vx_uint32 i;
 
+            /* only the border columns are left in the interior rows */
+            if ((interior == vx_true_e) && (x == 1u))
+            {
+                x = src_addr.dim_x - 2u;
+                continue;
+            }
             vxReadRectangle(src_base, &src_addr, borders, VX_DF_IMAGE_U8, x, y, 1, 1, &pixels);
 
             m = pixels[0];
@@ -63,6 +110,7 @@ static vx_status vxMorphology3x3(vx_image src, vx_image dst, vx_uint8 (*op)(vx_u
             *dst = m;
         }
     }
+    free(rows);
 
     status |= vxCommitImagePatch(src, NULL, 0, &src_addr, src_base);
     status |= vxCommitImagePatch(dst, &rect, 0, &dst_addr, dst_base);
@@ -70,14 +118,6 @@ static vx_status vxMorphology3x3(vx_image src, vx_image dst, vx_uint8 (*op)(vx_u
     return status;
 }
 
-static vx_uint8 min_op(vx_uint8 a, vx_uint8 b) {
-    return a < b ? a : b;
-}
-
-static vx_uint8 max_op(vx_uint8 a, vx_uint8 b) {
-    return a > b ? a : b;
-}
-
 // nodeless version of the Erode3x3 kernel
 vx_status vxErode3x3(vx_image src, vx_image dst, vx_border_mode_t *bordermode)
 {
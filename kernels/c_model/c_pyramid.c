@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The levels of a Gaussian pyramid, filtered and decimated in one pass.
+ */
+
+#include <c_model.h>
+
+/*! \brief The 5x5 Gaussian of the pyramid is the outer product of these taps over 256. */
+static const vx_int32 gaussian5[5] = {1, 4, 6, 4, 1};
+
+void vxGaussianPyramidRows(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                           void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                           const vx_int32 *xs, const vx_int32 *ys, vx_bool half,
+                           vx_uint32 y0, vx_uint32 y1,
+                           const vx_border_mode_t *borders, vx_int32 *column)
+{
+    vx_int32 width = (vx_int32)src_addr->dim_x, height = (vx_int32)src_addr->dim_y;
+    vx_int32 constant = (borders->mode == VX_BORDER_MODE_CONSTANT ? (vx_int32)borders->constant_value : 0);
+    vx_int32 * VX_RESTRICT v = &column[2];
+    vx_uint32 x, y;
+    vx_int32 j;
+
+    for (y = y0; y < y1; y++)
+    {
+        const vx_uint8 *r[5];
+        vx_int32 k[5], bias = 0;
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y, dst_addr);
+
+        /* filter the whole source row the destination row samples vertically; rows
+         * beyond the edges are constant or replicated, and UNDEFINED replicates them */
+        for (j = 0; j < 5; j++)
+        {
+            vx_int32 sy = ys[y] + j - 2;
+            k[j] = gaussian5[j];
+            if ((sy < 0) || (sy >= height))
+            {
+                if (borders->mode == VX_BORDER_MODE_CONSTANT)
+                {
+                    bias += k[j] * constant;
+                    k[j] = 0;
+                }
+                sy = (sy < 0 ? 0 : height - 1);
+            }
+            r[j] = vxFormatImagePatchAddress2d(src_base, 0, sy, src_addr);
+        }
+        for (x = 0u; x < (vx_uint32)width; x++)
+        {
+            v[x] = k[0] * r[0][x] + k[1] * r[1][x] + k[2] * r[2][x] + k[3] * r[3][x] + k[4] * r[4][x] + bias;
+        }
+        if (borders->mode == VX_BORDER_MODE_CONSTANT)
+        {
+            v[-2] = v[-1] = v[width] = v[width + 1] = 16 * constant;
+        }
+        else
+        {
+            v[-2] = v[-1] = v[0];
+            v[width] = v[width + 1] = v[width - 1];
+        }
+
+        /* then only the columns which survive the decimation horizontally */
+        if (half)
+        {
+            for (x = 0u; x < dst_addr->dim_x; x++)
+            {
+                const vx_int32 *c = &v[2*x + 1];
+                dst[x] = (vx_uint8)((c[-2] + 4 * c[-1] + 6 * c[0] + 4 * c[1] + c[2]) >> 8);
+            }
+        }
+        else
+        {
+            for (x = 0u; x < dst_addr->dim_x; x++)
+            {
+                const vx_int32 *c = &v[xs[x]];
+                dst[x] = (vx_uint8)((c[-2] + 4 * c[-1] + 6 * c[0] + 4 * c[1] + c[2]) >> 8);
+            }
+        }
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The row operations of the 3x3 filters.
+ * \details This file is included by c_vector.c once per instruction set, with
+ * VX_ROW_NAME renaming each function and VX_ROW_TARGET selecting the instruction
+ * set it is compiled for. Each operation produces the columns [1, width-1) of a
+ * row and has no branches in its loop, so the compiler vectorizes it for the
+ * instruction set.
+ */
+
+static VX_ROW_TARGET void VX_ROW_NAME(convolve_row)(const vx_uint8 * VX_RESTRICT src, vx_uint32 width,
+                                                   const vx_int32 k[3], vx_int32 * VX_RESTRICT dst)
+{
+    vx_int32 k0 = k[0], k1 = k[1], k2 = k[2];
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        dst[x] = (k0 * src[x-1]) + (k1 * src[x]) + (k2 * src[x+1]);
+    }
+}
+
+static VX_ROW_TARGET void VX_ROW_NAME(convolve_column_u8)(const vx_int32 * VX_RESTRICT r0,
+                                                         const vx_int32 * VX_RESTRICT r1,
+                                                         const vx_int32 * VX_RESTRICT r2,
+                                                         vx_uint32 width, const vx_int32 k[3],
+                                                         vx_uint32 mult, vx_uint32 shift,
+                                                         vx_uint8 * VX_RESTRICT dst)
+{
+    vx_int32 k0 = k[0], k1 = k[1], k2 = k[2];
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_int32 sum = (k0 * r0[x]) + (k1 * r1[x]) + (k2 * r2[x]);
+        vx_uint32 a = (vx_uint32)(sum < 0 ? -sum : sum);
+        vx_int32 q = (vx_int32)((a * mult) >> shift);
+        q = (sum < 0 ? -q : q);
+        dst[x] = (vx_uint8)(q < 0 ? 0 : (q > UINT8_MAX ? UINT8_MAX : q));
+    }
+}
+
+static VX_ROW_TARGET void VX_ROW_NAME(convolve_column_s16)(const vx_int32 * VX_RESTRICT r0,
+                                                          const vx_int32 * VX_RESTRICT r1,
+                                                          const vx_int32 * VX_RESTRICT r2,
+                                                          vx_uint32 width, const vx_int32 k[3],
+                                                          vx_uint32 mult, vx_uint32 shift,
+                                                          vx_int16 * VX_RESTRICT dst)
+{
+    vx_int32 k0 = k[0], k1 = k[1], k2 = k[2];
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_int32 sum = (k0 * r0[x]) + (k1 * r1[x]) + (k2 * r2[x]);
+        vx_uint32 a = (vx_uint32)(sum < 0 ? -sum : sum);
+        vx_int32 q = (vx_int32)((a * mult) >> shift);
+        q = (sum < 0 ? -q : q);
+        dst[x] = (vx_int16)(q < INT16_MIN ? INT16_MIN : (q > INT16_MAX ? INT16_MAX : q));
+    }
+}
+
+static VX_ROW_TARGET void VX_ROW_NAME(erode_row)(const vx_uint8 * VX_RESTRICT src, vx_uint32 width,
+                                                vx_uint8 * VX_RESTRICT dst)
+{
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_uint8 m = (src[x-1] < src[x] ? src[x-1] : src[x]);
+        dst[x] = (m < src[x+1] ? m : src[x+1]);
+    }
+}
+
+static VX_ROW_TARGET void VX_ROW_NAME(erode_column)(const vx_uint8 * VX_RESTRICT r0,
+                                                   const vx_uint8 * VX_RESTRICT r1,
+                                                   const vx_uint8 * VX_RESTRICT r2,
+                                                   vx_uint32 width, vx_uint8 * VX_RESTRICT dst)
+{
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_uint8 m = (r0[x] < r1[x] ? r0[x] : r1[x]);
+        dst[x] = (m < r2[x] ? m : r2[x]);
+    }
+}
+
+static VX_ROW_TARGET void VX_ROW_NAME(dilate_row)(const vx_uint8 * VX_RESTRICT src, vx_uint32 width,
+                                                 vx_uint8 * VX_RESTRICT dst)
+{
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_uint8 m = (src[x-1] > src[x] ? src[x-1] : src[x]);
+        dst[x] = (m > src[x+1] ? m : src[x+1]);
+    }
+}
+
+static VX_ROW_TARGET void VX_ROW_NAME(dilate_column)(const vx_uint8 * VX_RESTRICT r0,
+                                                    const vx_uint8 * VX_RESTRICT r1,
+                                                    const vx_uint8 * VX_RESTRICT r2,
+                                                    vx_uint32 width, vx_uint8 * VX_RESTRICT dst)
+{
+    vx_uint32 x;
+    for (x = 1u; x < width - 1u; x++)
+    {
+        vx_uint8 m = (r0[x] > r1[x] ? r0[x] : r1[x]);
+        dst[x] = (m > r2[x] ? m : r2[x]);
+    }
+}
+
+static const vx_row_ops_t VX_ROW_NAME(ops) = {
+    VX_ROW_NAME(convolve_row),
+    VX_ROW_NAME(convolve_column_u8),
+    VX_ROW_NAME(convolve_column_s16),
+    VX_ROW_NAME(erode_row),
+    VX_ROW_NAME(erode_column),
+    VX_ROW_NAME(dilate_row),
+    VX_ROW_NAME(dilate_column),
+};
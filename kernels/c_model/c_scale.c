@@ -22,6 +22,7 @@
  */
 
 #include <c_model.h>
+#include <stdlib.h>
 
 // helpers
 
@@ -31,11 +32,15 @@
  * that the sample areas for adjacent output pixels be disjoint, nor that
  * the pixels be weighted evenly."
  *
- * The existing implementation of AREA can use too much heap in certain
- * circumstances, so disabling for now, and using NEAREST_NEIGHBOR instead,
- * as it also passes conformance for AREA interpolation.
+ * AREA averages the source pixels each destination pixel covers, weighted
+ * by how much of them it covers. When the image grows along either axis
+ * there is nothing to average, so AREA falls back to NEAREST_NEIGHBOR, which
+ * also passes conformance for AREA interpolation.
  */
-#define AREA_SCALE_ENABLE 0 /* TODO enable this again after changing implementation in sample/targets/vx_scale.c */
+
+/*! \brief The fractional bits of the polyphase weights. */
+#define SCALE_BITS  (11)
+#define SCALE_ONE   (1 << SCALE_BITS)
 
 static vx_bool read_pixel(void *base, vx_imagepatch_addressing_t *addr,
         vx_int32 x, vx_int32 y, const vx_border_mode_t *borders, vx_uint8 *pixel)
@@ -64,172 +69,431 @@ static vx_bool read_pixel(void *base, vx_imagepatch_addressing_t *addr,
     return vx_true_e;
 }
 
+/*! \brief Returns how a scale samples, which is the requested type unless AREA
+ * would have to grow the image.
+ */
+static vx_enum vxScaleMode(vx_enum type, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2)
+{
+    if ((type == VX_INTERPOLATION_TYPE_AREA) && ((w2 > w1) || (h2 > h1)))
+        return VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR;
+    return type;
+}
 
-static vx_status vxNearestScaling(vx_image src_image, vx_image dst_image, const vx_border_mode_t *borders)
+/*! \brief Returns the number of source pixels each destination pixel reads along an axis. */
+static vx_uint32 vxScaleTaps(vx_enum mode, vx_uint32 n1, vx_uint32 n2)
 {
-    vx_status status = VX_SUCCESS;
-    vx_int32 x1,y1,x2,y2;
-    void *src_base = NULL, *dst_base = NULL;
-    vx_rectangle_t src_rect, dst_rect;
-    vx_imagepatch_addressing_t src_addr, dst_addr;
-    vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
-    vx_float32 wr, hr;
+    vx_uint32 taps = 1u;
+    if (mode == VX_INTERPOLATION_TYPE_BILINEAR)
+    {
+        taps = 2u;
+    }
+    else if (mode == VX_INTERPOLATION_TYPE_AREA)
+    {
+        vx_float64 r = (vx_float64)n1 / (vx_float64)n2;
+        vx_uint32 i;
+        for (i = 0u; i < n2; i++)
+        {
+            vx_uint32 first = (vx_uint32)floor(i * r);
+            vx_uint32 last = (vx_uint32)ceil((i + 1) * r);
+            if (last > n1)
+                last = n1;
+            if (last - first > taps)
+                taps = last - first;
+        }
+    }
+    return taps;
+}
 
-    vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
-    vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
-    vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
-    vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+/*! \brief Fills in the taps of one axis and finds the destination pixels whose taps
+ * all lie inside of the source. NEAREST and BILINEAR compute their source positions
+ * exactly like the per pixel scalers so that both sample the same pixels.
+ */
+static void vxScaleAxis(vx_enum mode, vx_uint32 n1, vx_uint32 n2, vx_scale_axis_t *axis)
+{
+    vx_float32 ratio = (vx_float32)n1 / (vx_float32)n2;
+    vx_uint32 i, k, taps = axis->taps;
 
-    src_rect.start_x = src_rect.start_y = 0;
-    src_rect.end_x = w1;
-    src_rect.end_y = h1;
+    axis->lo = n2;
+    axis->hi = 0u;
+    for (i = 0u; i < n2; i++)
+    {
+        vx_int32 *start = &axis->start[i];
+        vx_int16 *w = &axis->weights[i * taps];
+        if (mode == VX_INTERPOLATION_TYPE_AREA)
+        {
+            /* the overlap of each source pixel with [i, i + 1) scaled to the source */
+            vx_float64 r = (vx_float64)n1 / (vx_float64)n2;
+            vx_float64 begin = i * r, end = (i + 1) * r;
+            vx_int32 sum = 0, largest = 0;
+            *start = (vx_int32)floor(begin);
+            if (*start + taps > n1)
+                *start = (vx_int32)(n1 - taps);
+            for (k = 0u; k < taps; k++)
+            {
+                vx_float64 a = (*start + (vx_int32)k > begin ? *start + (vx_int32)k : begin);
+                vx_float64 b = (*start + (vx_int32)k + 1 < end ? *start + (vx_int32)k + 1 : end);
+                w[k] = (vx_int16)(b > a ? floor((b - a) / r * SCALE_ONE + 0.5) : 0);
+                sum += w[k];
+                if (w[k] > w[largest])
+                    largest = k;
+            }
+            /* the weights must sum to exactly one */
+            w[largest] += (vx_int16)(SCALE_ONE - sum);
+        }
+        else
+        {
+            vx_float32 src = ((vx_float32)i + 0.5f) * ratio - 0.5f;
+            vx_float32 src_min = floorf(src);
+            *start = (vx_int32)src_min;
+            if (mode == VX_INTERPOLATION_TYPE_BILINEAR)
+            {
+                w[1] = (vx_int16)((src - src_min) * SCALE_ONE + 0.5f);
+                w[0] = (vx_int16)(SCALE_ONE - w[1]);
+            }
+            else
+            {
+                if (src - src_min >= 0.5f)
+                    (*start)++;
+                w[0] = SCALE_ONE;
+            }
+        }
+        if ((*start >= 0) && (*start + taps <= n1))
+        {
+            if (axis->lo > i)
+                axis->lo = i;
+            axis->hi = i + 1u;
+        }
+    }
+    if (axis->lo > axis->hi)
+        axis->lo = axis->hi;
+}
 
-    dst_rect.start_x = dst_rect.start_y = 0;
-    dst_rect.end_x = w2;
-    dst_rect.end_y = h2;
+vx_size vxScaleTablesSize(vx_enum type, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2)
+{
+    vx_enum mode = vxScaleMode(type, w1, h1, w2, h2);
+    if ((w1 == 0u) || (h1 == 0u) || (w2 == 0u) || (h2 == 0u) ||
+        ((mode != VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) &&
+         (mode != VX_INTERPOLATION_TYPE_BILINEAR) &&
+         (mode != VX_INTERPOLATION_TYPE_AREA)))
+        return 0ul;
+    return sizeof(vx_scale_tables_t) +
+           (w2 + h2) * sizeof(vx_int32) +
+           (w2 * vxScaleTaps(mode, w1, w2) + h2 * vxScaleTaps(mode, h1, h2)) * sizeof(vx_int16);
+}
 
-    status = VX_SUCCESS;
-    status |= vxAccessImagePatch(src_image, &src_rect, 0, &src_addr, &src_base, VX_READ_ONLY);
-    status |= vxAccessImagePatch(dst_image, &dst_rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
+vx_status vxScaleTables(vx_enum type, vx_uint32 w1, vx_uint32 h1, vx_uint32 w2, vx_uint32 h2,
+                        vx_scale_tables_t *tables, vx_size size)
+{
+    vx_enum mode = vxScaleMode(type, w1, h1, w2, h2);
+    vx_size needed = vxScaleTablesSize(type, w1, h1, w2, h2);
+    vx_uint8 *next = (vx_uint8 *)&tables[1];
+
+    if ((needed == 0ul) || (tables == NULL) || (size < needed))
+        return VX_ERROR_INVALID_PARAMETERS;
+
+    tables->type = type;
+    tables->src_width = w1;
+    tables->src_height = h1;
+    tables->dst_width = w2;
+    tables->dst_height = h2;
+    tables->x.taps = vxScaleTaps(mode, w1, w2);
+    tables->y.taps = vxScaleTaps(mode, h1, h2);
+    /* the starts come first so that they stay aligned */
+    tables->x.start = (vx_int32 *)next;
+    next += w2 * sizeof(vx_int32);
+    tables->y.start = (vx_int32 *)next;
+    next += h2 * sizeof(vx_int32);
+    tables->x.weights = (vx_int16 *)next;
+    next += w2 * tables->x.taps * sizeof(vx_int16);
+    tables->y.weights = (vx_int16 *)next;
+    vxScaleAxis(mode, w1, w2, &tables->x);
+    vxScaleAxis(mode, h1, h2, &tables->y);
+    return VX_SUCCESS;
+}
 
-    wr = (vx_float32)w1/(vx_float32)w2;
-    hr = (vx_float32)h1/(vx_float32)h2;
+static void vxNearestPixel(void *src_base, vx_imagepatch_addressing_t *src_addr, const vx_scale_tables_t *tables,
+                           vx_uint32 x2, vx_uint32 y2, const vx_border_mode_t *borders, vx_uint8 *dst)
+{
+    vx_uint8 v = 0;
+    if (vx_true_e == read_pixel(src_base, src_addr, tables->x.start[x2], tables->y.start[y2], borders, &v))
+        *dst = v;
+}
 
-    for (y2 = 0; y2 < h2; y2++)
+static void vxBilinearPixel(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                            vx_float32 wr, vx_float32 hr, vx_int32 x2, vx_int32 y2,
+                            const vx_border_mode_t *borders, vx_uint8 *dst)
+{
+    vx_uint8 tl = 0, tr = 0, bl = 0, br = 0;
+    vx_float32 x_src = ((vx_float32)x2+0.5f)*wr - 0.5f;
+    vx_float32 y_src = ((vx_float32)y2+0.5f)*hr - 0.5f;
+    vx_float32 x_min = floorf(x_src);
+    vx_float32 y_min = floorf(y_src);
+    vx_int32 x1 = (vx_int32)x_min;
+    vx_int32 y1 = (vx_int32)y_min;
+    vx_float32 s = x_src - x_min;
+    vx_float32 t = y_src - y_min;
+    vx_bool defined_tl = read_pixel(src_base, src_addr, x1 + 0, y1 + 0, borders, &tl);
+    vx_bool defined_tr = read_pixel(src_base, src_addr, x1 + 1, y1 + 0, borders, &tr);
+    vx_bool defined_bl = read_pixel(src_base, src_addr, x1 + 0, y1 + 1, borders, &bl);
+    vx_bool defined_br = read_pixel(src_base, src_addr, x1 + 1, y1 + 1, borders, &br);
+    vx_bool defined = defined_tl & defined_tr & defined_bl & defined_br;
+    if (defined == vx_false_e)
     {
-        for (x2 = 0; x2 < w2; x2++)
+        vx_bool defined_any = defined_tl | defined_tr | defined_bl | defined_br;
+        if (defined_any)
         {
-            vx_uint8 v = 0;
-            vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x2, y2, &dst_addr);
-            vx_float32 x_src = ((vx_float32)x2+0.5f)*wr - 0.5f;
-            vx_float32 y_src = ((vx_float32)y2+0.5f)*hr - 0.5f;
-            vx_float32 x_min = floorf(x_src);
-            vx_float32 y_min = floorf(y_src);
-            x1 = (vx_int32)x_min;
-            y1 = (vx_int32)y_min;
-            if (x_src - x_min >= 0.5f)
-                x1++;
-            if (y_src - y_min >= 0.5f)
-                y1++;
-            //printf("x2,y2={%u,%u} => x1,y1={%u,%u}\n", x2,y2,x1,y1);
-            if(dst && vx_true_e == read_pixel(src_base, &src_addr, x1, y1, borders, &v))
-                *dst = v;
+            if ((defined_tl == vx_false_e || defined_tr == vx_false_e) && fabs(t - 1.0) <= 0.001)
+                defined_tl = defined_tr = vx_true_e;
+            else if ((defined_bl == vx_false_e || defined_br == vx_false_e) && fabs(t - 0.0) <= 0.001)
+                defined_bl = defined_br = vx_true_e;
+            if ((defined_tl == vx_false_e || defined_bl == vx_false_e) && fabs(s - 1.0) <= 0.001)
+                defined_tl = defined_bl = vx_true_e;
+            else if ((defined_tr == vx_false_e || defined_br == vx_false_e) && fabs(s - 0.0) <= 0.001)
+                defined_tr = defined_br = vx_true_e;
+            defined = defined_tl & defined_tr & defined_bl & defined_br;
         }
     }
-    status |= vxCommitImagePatch(src_image, NULL, 0, &src_addr, src_base);
-    status |= vxCommitImagePatch(dst_image, &dst_rect, 0, &dst_addr, dst_base);
-    return VX_SUCCESS;
+    if (defined == vx_true_e)
+    {
+        vx_float32 ref =
+                (1 - s) * (1 - t) * tl +
+                (    s) * (1 - t) * tr +
+                (1 - s) * (    t) * bl +
+                (    s) * (    t) * br;
+        vx_uint8 ref_8u;
+        if (ref > 255)
+            ref_8u = 255;
+        // numbers are non-negative
+        //else if (ref < 0)
+        //    ref_8u = 0;
+        else
+            ref_8u = (vx_uint8)ref;
+        if (dst)
+            *dst = ref_8u;
+    }
 }
 
-static vx_status vxBilinearScaling(vx_image src_image, vx_image dst_image, const vx_border_mode_t *borders)
+static void vxNearestScaling(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                             void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                             const vx_scale_tables_t *tables, const vx_border_mode_t *borders)
 {
-    vx_status status = VX_SUCCESS;
-    vx_int32 x2,y2;
-    void *src_base = NULL, *dst_base = NULL;
-    vx_rectangle_t src_rect, dst_rect;
-    vx_imagepatch_addressing_t src_addr, dst_addr;
-    vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
-    vx_float32 wr, hr;
-
-    vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
-    vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
-    vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
-    vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
-
-    src_rect.start_x = src_rect.start_y = 0;
-    src_rect.end_x = w1;
-    src_rect.end_y = h1;
-
-    dst_rect.start_x = dst_rect.start_y = 0;
-    dst_rect.end_x = w2;
-    dst_rect.end_y = h2;
+    const vx_int32 *xs = tables->x.start;
+    vx_uint32 x2, y2;
+    for (y2 = 0u; y2 < tables->dst_height; y2++)
+    {
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y2, dst_addr);
+        vx_uint32 lo = tables->x.lo, hi = tables->x.hi;
+        if ((y2 < tables->y.lo) || (y2 >= tables->y.hi))
+            lo = hi = tables->dst_width;
+        else
+        {
+            const vx_uint8 *src = vxFormatImagePatchAddress2d(src_base, 0, tables->y.start[y2], src_addr);
+            for (x2 = lo; x2 < hi; x2++)
+                dst[x2] = src[xs[x2]];
+        }
+        for (x2 = 0u; x2 < lo; x2++)
+            vxNearestPixel(src_base, src_addr, tables, x2, y2, borders, &dst[x2]);
+        for (x2 = hi; x2 < tables->dst_width; x2++)
+            vxNearestPixel(src_base, src_addr, tables, x2, y2, borders, &dst[x2]);
+    }
+}
 
-    status = VX_SUCCESS;
-    status |= vxAccessImagePatch(src_image, &src_rect, 0, &src_addr, &src_base, VX_READ_ONLY);
-    status |= vxAccessImagePatch(dst_image, &dst_rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
+/*! \brief Filters the columns [lo, hi) of one source row with the horizontal taps. */
+static void vxScaleRowH(const vx_uint8 *src, const vx_scale_axis_t *axis, vx_int32 * VX_RESTRICT row)
+{
+    const vx_int32 * VX_RESTRICT start = axis->start;
+    const vx_int16 * VX_RESTRICT w = axis->weights;
+    vx_uint32 x, k, lo = axis->lo, hi = axis->hi, taps = axis->taps;
+    if (taps == 2u)
+    {
+        for (x = lo; x < hi; x++)
+        {
+            const vx_uint8 *s = &src[start[x]];
+            row[x] = w[2*x + 0] * s[0] + w[2*x + 1] * s[1];
+        }
+    }
+    else
+    {
+        for (x = lo; x < hi; x++)
+        {
+            const vx_uint8 *s = &src[start[x]];
+            vx_int32 sum = 0;
+            for (k = 0u; k < taps; k++)
+                sum += w[x * taps + k] * s[k];
+            row[x] = sum;
+        }
+    }
+}
 
-    wr = (vx_float32)w1/(vx_float32)w2;
-    hr = (vx_float32)h1/(vx_float32)h2;
+/*! \brief Runs a separable polyphase filter over the destination pixels whose taps
+ * all lie inside of the source, keeping the horizontally filtered source rows in a
+ * ring so that each is filtered only once. BILINEAR truncates like the per pixel
+ * scaler, which covers the edges, and AREA rounds.
+ */
+static vx_status vxPolyphaseScaling(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                                    void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                                    const vx_scale_tables_t *tables, vx_enum mode,
+                                    const vx_border_mode_t *borders)
+{
+    const vx_scale_axis_t *ax = &tables->x, *ay = &tables->y;
+    vx_uint32 taps = ay->taps, width = tables->dst_width, k, x2, y2;
+    vx_int32 bias = (mode == VX_INTERPOLATION_TYPE_AREA ? 1 << (2 * SCALE_BITS - 1) : 0);
+    vx_float32 wr = (vx_float32)tables->src_width / (vx_float32)tables->dst_width;
+    vx_float32 hr = (vx_float32)tables->src_height / (vx_float32)tables->dst_height;
+    vx_int32 *rows = (vx_int32 *)malloc(taps * width * sizeof(vx_int32));
+    vx_int32 *tags = (vx_int32 *)malloc(taps * sizeof(vx_int32));
+    const vx_int32 **taprows = (const vx_int32 **)malloc(taps * sizeof(vx_int32 *));
+
+    if ((rows == NULL) || (tags == NULL) || (taprows == NULL))
+    {
+        free(rows);
+        free(tags);
+        free((void *)taprows);
+        return VX_ERROR_NO_MEMORY;
+    }
+    for (k = 0u; k < taps; k++)
+        tags[k] = -1;
 
-    for (y2 = 0; y2 < h2; y2++)
+    for (y2 = 0u; y2 < tables->dst_height; y2++)
     {
-        for (x2 = 0; x2 < w2; x2++)
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y2, dst_addr);
+        vx_uint32 lo = ax->lo, hi = ax->hi;
+        if ((y2 < ay->lo) || (y2 >= ay->hi))
+            lo = hi = width;
+        else
         {
-            vx_uint8 tl = 0, tr = 0, bl = 0, br = 0;
-            vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x2, y2, &dst_addr);
-            vx_float32 x_src = ((vx_float32)x2+0.5f)*wr - 0.5f;
-            vx_float32 y_src = ((vx_float32)y2+0.5f)*hr - 0.5f;
-            vx_float32 x_min = floorf(x_src);
-            vx_float32 y_min = floorf(y_src);
-            vx_int32 x1 = (vx_int32)x_min;
-            vx_int32 y1 = (vx_int32)y_min;
-            vx_float32 s = x_src - x_min;
-            vx_float32 t = y_src - y_min;
-            vx_bool defined_tl = read_pixel(src_base, &src_addr, x1 + 0, y1 + 0, borders, &tl);
-            vx_bool defined_tr = read_pixel(src_base, &src_addr, x1 + 1, y1 + 0, borders, &tr);
-            vx_bool defined_bl = read_pixel(src_base, &src_addr, x1 + 0, y1 + 1, borders, &bl);
-            vx_bool defined_br = read_pixel(src_base, &src_addr, x1 + 1, y1 + 1, borders, &br);
-            vx_bool defined = defined_tl & defined_tr & defined_bl & defined_br;
-            if (defined == vx_false_e)
+            const vx_int16 *wy = &ay->weights[y2 * taps];
+            /* source row y1 lives in slot y1 % taps until a later row needs the slot */
+            for (k = 0u; k < taps; k++)
             {
-                vx_bool defined_any = defined_tl | defined_tr | defined_bl | defined_br;
-                if (defined_any)
+                vx_int32 y1 = ay->start[y2] + (vx_int32)k;
+                vx_uint32 slot = (vx_uint32)y1 % taps;
+                if (tags[slot] != y1)
                 {
-                    if ((defined_tl == vx_false_e || defined_tr == vx_false_e) && fabs(t - 1.0) <= 0.001)
-                        defined_tl = defined_tr = vx_true_e;
-                    else if ((defined_bl == vx_false_e || defined_br == vx_false_e) && fabs(t - 0.0) <= 0.001)
-                        defined_bl = defined_br = vx_true_e;
-                    if ((defined_tl == vx_false_e || defined_bl == vx_false_e) && fabs(s - 1.0) <= 0.001)
-                        defined_tl = defined_bl = vx_true_e;
-                    else if ((defined_tr == vx_false_e || defined_br == vx_false_e) && fabs(s - 0.0) <= 0.001)
-                        defined_tr = defined_br = vx_true_e;
-                    defined = defined_tl & defined_tr & defined_bl & defined_br;
+                    vxScaleRowH(vxFormatImagePatchAddress2d(src_base, 0, y1, src_addr), ax, &rows[slot * width]);
+                    tags[slot] = y1;
                 }
+                taprows[k] = &rows[slot * width];
+            }
+            if (taps == 2u)
+            {
+                const vx_int32 *r0 = taprows[0], *r1 = taprows[1];
+                vx_int32 w0 = wy[0], w1 = wy[1];
+                for (x2 = lo; x2 < hi; x2++)
+                    dst[x2] = (vx_uint8)((w0 * r0[x2] + w1 * r1[x2] + bias) >> (2 * SCALE_BITS));
             }
-            if (defined == vx_true_e)
+            else
             {
-                vx_float32 ref =
-                        (1 - s) * (1 - t) * tl +
-                        (    s) * (1 - t) * tr +
-                        (1 - s) * (    t) * bl +
-                        (    s) * (    t) * br;
-                vx_uint8 ref_8u;
-                if (ref > 255)
-                    ref_8u = 255;
-                // numbers are non-negative
-                //else if (ref < 0)
-                //    ref_8u = 0;
-                else
-                    ref_8u = (vx_uint8)ref;
-                if (dst)
-                    *dst = ref_8u;
+                for (x2 = lo; x2 < hi; x2++)
+                {
+                    vx_int32 sum = bias;
+                    for (k = 0u; k < taps; k++)
+                        sum += wy[k] * taprows[k][x2];
+                    dst[x2] = (vx_uint8)(sum >> (2 * SCALE_BITS));
+                }
             }
         }
+        /* only BILINEAR has taps outside of the source */
+        for (x2 = 0u; x2 < lo; x2++)
+            vxBilinearPixel(src_base, src_addr, wr, hr, x2, y2, borders, &dst[x2]);
+        for (x2 = hi; x2 < width; x2++)
+            vxBilinearPixel(src_base, src_addr, wr, hr, x2, y2, borders, &dst[x2]);
     }
-    status |= vxCommitImagePatch(src_image, NULL, 0, &src_addr, src_base);
-    status |= vxCommitImagePatch(dst_image, &dst_rect, 0, &dst_addr, dst_base);
+
+    free(rows);
+    free(tags);
+    free((void *)taprows);
     return VX_SUCCESS;
 }
 
-#if AREA_SCALE_ENABLE
-static vx_status vxAreaScaling(vx_image src_image, vx_image dst_image, const vx_border_mode_t *borders, vx_float64 *interm, vx_size size)
+/*! \brief Halves the image by averaging 2x2 blocks, which is exactly what BILINEAR
+ * samples at that ratio and what AREA covers. BILINEAR truncates and AREA rounds.
+ */
+static void vxHalveScaling(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                           void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                           vx_uint32 w2, vx_uint32 h2, vx_uint32 bias)
+{
+    vx_uint32 x2, y2;
+    for (y2 = 0u; y2 < h2; y2++)
+    {
+        const vx_uint8 *r0 = vxFormatImagePatchAddress2d(src_base, 0, 2*y2 + 0, src_addr);
+        const vx_uint8 *r1 = vxFormatImagePatchAddress2d(src_base, 0, 2*y2 + 1, src_addr);
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y2, dst_addr);
+        for (x2 = 0u; x2 < w2; x2++)
+            dst[x2] = (vx_uint8)((r0[2*x2] + r0[2*x2 + 1] + r1[2*x2] + r1[2*x2 + 1] + bias) >> 2);
+    }
+}
+
+/*! \brief Quarters the image. BILINEAR samples the middle 2x2 of each 4x4 block
+ * at this ratio while AREA averages all of it.
+ */
+static void vxQuarterScaling(void *src_base, vx_imagepatch_addressing_t *src_addr,
+                             void *dst_base, vx_imagepatch_addressing_t *dst_addr,
+                             vx_uint32 w2, vx_uint32 h2, vx_enum mode)
+{
+    vx_uint32 x2, y2;
+    for (y2 = 0u; y2 < h2; y2++)
+    {
+        const vx_uint8 *r0 = vxFormatImagePatchAddress2d(src_base, 0, 4*y2 + 0, src_addr);
+        const vx_uint8 *r1 = vxFormatImagePatchAddress2d(src_base, 0, 4*y2 + 1, src_addr);
+        const vx_uint8 *r2 = vxFormatImagePatchAddress2d(src_base, 0, 4*y2 + 2, src_addr);
+        const vx_uint8 *r3 = vxFormatImagePatchAddress2d(src_base, 0, 4*y2 + 3, src_addr);
+        vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y2, dst_addr);
+        if (mode == VX_INTERPOLATION_TYPE_AREA)
+        {
+            for (x2 = 0u; x2 < w2; x2++)
+            {
+                vx_uint32 x = 4*x2;
+                vx_uint32 sum = r0[x] + r0[x+1] + r0[x+2] + r0[x+3] +
+                                r1[x] + r1[x+1] + r1[x+2] + r1[x+3] +
+                                r2[x] + r2[x+1] + r2[x+2] + r2[x+3] +
+                                r3[x] + r3[x+1] + r3[x+2] + r3[x+3];
+                dst[x2] = (vx_uint8)((sum + 8u) >> 4);
+            }
+        }
+        else
+        {
+            for (x2 = 0u; x2 < w2; x2++)
+            {
+                vx_uint32 x = 4*x2;
+                dst[x2] = (vx_uint8)((r1[x+1] + r1[x+2] + r2[x+1] + r2[x+2]) >> 2);
+            }
+        }
+    }
+}
+
+// nodeless version of the ScaleImage kernel
+vx_status vxScaleImage(vx_image src_image, vx_image dst_image, vx_scalar stype, vx_border_mode_t *bordermode, vx_scale_tables_t *tables, vx_size size)
 {
-    vx_status status = VX_SUCCESS;
+    vx_status status = VX_FAILURE;
+    vx_enum type = 0, mode;
     void *src_base = NULL, *dst_base = NULL;
     vx_rectangle_t src_rect, dst_rect;
     vx_imagepatch_addressing_t src_addr, dst_addr;
-    vx_uint32 by, bx, y, x, yi, xi, gcd_w, gcd_h, r1w, r1h, r2w, r2h, r_w, b_w, b_h;
     vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
+    vx_scale_tables_t *local = NULL;
 
-    /*! \bug Should ScaleImage use the valid region of the image
-     * as the scaling information or the width,height? If it uses the valid
-     * region, should is scale the valid region within bounds of the
-     * image?
-     */
+    vxAccessScalarValue(stype, &type);
     vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
     vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
     vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
     vxQueryImage(dst_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+    mode = vxScaleMode(type, w1, h1, w2, h2);
+
+    /* the tables are normally built when the node is initialized */
+    if ((tables == NULL) || (size < sizeof(vx_scale_tables_t)) || (tables->type != type) ||
+        (tables->src_width != w1) || (tables->src_height != h1) ||
+        (tables->dst_width != w2) || (tables->dst_height != h2))
+    {
+        size = vxScaleTablesSize(type, w1, h1, w2, h2);
+        if (size == 0ul)
+            return VX_ERROR_INVALID_PARAMETERS;
+        local = (vx_scale_tables_t *)malloc(size);
+        if (local == NULL)
+            return VX_ERROR_NO_MEMORY;
+        vxScaleTables(type, w1, h1, w2, h2, local, size);
+        tables = local;
+    }
 
     src_rect.start_x = src_rect.start_y = 0;
     src_rect.end_x = w1;
@@ -242,117 +506,21 @@ static vx_status vxAreaScaling(vx_image src_image, vx_image dst_image, const vx_
     status = VX_SUCCESS;
     status |= vxAccessImagePatch(src_image, &src_rect, 0, &src_addr, &src_base, VX_READ_ONLY);
     status |= vxAccessImagePatch(dst_image, &dst_rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
-
-    /* compute the Resize block sizes and the intermediate block size */
-    gcd_w = math_gcd(w1, w2);
-    gcd_h = math_gcd(h1, h2);
-    r1w = w1 / gcd_w;
-    r2w = w2 / gcd_w;
-    r1h = h1 / gcd_h;
-    r2h = h2 / gcd_h;
-    r_w = r1w * r2w;
-    b_w = w1 / r1w;
-    b_h = h1 / r1h;
-
-    /*
+    if (status == VX_SUCCESS)
     {
-        vx_uint32 r_h = r1h * r2h;
-        printf("%ux%u => %ux%u :: r1:%ux%u => r2:%ux%u (%p:%ux%u) blocks:%ux%u\n",
-               w1,h1, w2,h2, r1w,r1h, r2w,r2h, interm, r_w,r_h, b_w,b_h);
+        if (mode == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+            vxNearestScaling(src_base, &src_addr, dst_base, &dst_addr, tables, bordermode);
+        else if ((w1 == 2*w2) && (h1 == 2*h2))
+            vxHalveScaling(src_base, &src_addr, dst_base, &dst_addr, w2, h2,
+                           (mode == VX_INTERPOLATION_TYPE_AREA ? 2u : 0u));
+        else if ((w1 == 4*w2) && (h1 == 4*h2))
+            vxQuarterScaling(src_base, &src_addr, dst_base, &dst_addr, w2, h2, mode);
+        else
+            status = vxPolyphaseScaling(src_base, &src_addr, dst_base, &dst_addr, tables, mode, bordermode);
     }
-    */
-
-    /* iterate over each block */
-    for (by = 0; by < b_h; by++)
-    {
-        for (bx = 0; bx < b_w; bx++)
-        {
-            /* convert source image to intermediate */
-            for (y = 0; y < r1h; y++)
-            {
-                for (x = 0; x < r1w; x++)
-                {
-                    vx_uint32 i = (((by * r1h) + y) * src_addr.stride_y) +
-                                  (((bx * r1w) + x) * src_addr.stride_x);
-                    vx_uint8 pixel = ((vx_uint8 *)src_base)[i];
-                    for (yi = 0; yi < r2h; yi++)
-                    {
-                        for (xi = 0; xi < r2w; xi++)
-                        {
-                            vx_uint32 k = ((((y * r2h) + yi) * r_w) +
-                                            ((x * r2w) + xi));
-                            interm[k] = (vx_float64)pixel / (vx_float64)(r2w*r2h);
-                        }
-                    }
-                }
-            }
-
-            /* convert the intermediate into the destination */
-            for (y = 0; y < r2h; y++)
-            {
-                for (x = 0; x < r2w; x++)
-                {
-                    uint32_t sum32 = 0;
-                    vx_float64 sum = 0.0f;
-                    vx_uint32 i = (((by * r2h) + y) * dst_addr.stride_y) +
-                                  (((bx * r2w) + x) * dst_addr.stride_x);
-                    vx_uint8 *dst = &((vx_uint8 *)dst_base)[i];
-                    /* sum intermediate into destination */
-                    for (yi = 0; yi < r1h; yi++)
-                    {
-                        for (xi = 0; xi < r1w; xi++)
-                        {
-                            vx_uint32 k = ((((y * r1h) + yi) * r_w) +
-                                            ((x * r1w) + xi));
-                            sum += interm[k];
-                        }
-                    }
-                    /* rescale the output value */
-                    sum32 = (vx_uint32)(sum * (r2w*r2h)/(r1w*r1h));
-                    sum32 = (sum32 > 255?255:sum32);
-                    *dst = (vx_uint8)sum32;
-                }
-            }
-        }
-    }
-
     status |= vxCommitImagePatch(src_image, NULL, 0, &src_addr, src_base);
     status |= vxCommitImagePatch(dst_image, &dst_rect, 0, &dst_addr, dst_base);
-    return VX_SUCCESS;
-}
-#endif
-
-// nodeless version of the ScaleImage kernel
-vx_status vxScaleImage(vx_image src_image, vx_image dst_image, vx_scalar stype, vx_border_mode_t *bordermode, vx_float64 *interm, vx_size size)
-{
-    vx_status status = VX_FAILURE;
-    vx_enum type = 0;
-
-    vxAccessScalarValue(stype, &type);
-    if (interm && size)
-    {
-        if (type == VX_INTERPOLATION_TYPE_BILINEAR)
-        {
-            status = vxBilinearScaling(src_image, dst_image, bordermode);
-        }
-        else if (type == VX_INTERPOLATION_TYPE_AREA)
-        {
-#if AREA_SCALE_ENABLE // TODO FIX THIS
-            status = vxAreaScaling(src_image, dst_image, bordermode, interm, size);
-#else
-            status = vxNearestScaling(src_image, dst_image, bordermode);
-#endif
-        }
-        else if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
-        {
-            status = vxNearestScaling(src_image, dst_image, bordermode);
-        }
-    }
-    else
-    {
-        status = VX_ERROR_NO_RESOURCES;
-    }
 
+    free(local);
     return status;
 }
-
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief The row operations of the 3x3 filters, selected for the host CPU at runtime.
+ * \details The baseline variant is compiled for the instruction set of the build,
+ * which includes SSE2 on x86-64 and NEON on AArch64. With GCC or Clang on x86 an
+ * AVX2 variant is also compiled and chosen when the CPU reports AVX2.
+ */
+
+#include <c_model.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define VX_ROW_AVX2
+#endif
+
+#define VX_ROW_NAME(name) vx_##name##_base
+#define VX_ROW_TARGET
+#include "c_rows.h"
+#undef VX_ROW_NAME
+#undef VX_ROW_TARGET
+
+#if defined(VX_ROW_AVX2)
+#define VX_ROW_NAME(name) vx_##name##_avx2
+#define VX_ROW_TARGET __attribute__((target("avx2")))
+#include "c_rows.h"
+#undef VX_ROW_NAME
+#undef VX_ROW_TARGET
+#endif
+
+const vx_row_ops_t *vxGetRowOps(void)
+{
+#if defined(VX_ROW_AVX2)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return &vx_ops_avx2;
+#endif
+    return &vx_ops_base;
+}
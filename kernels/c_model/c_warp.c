@@ -22,6 +22,7 @@
  */
 
 #include <c_model.h>
+#include <stdlib.h>
 
 static vx_bool read_pixel(void *base, vx_imagepatch_addressing_t *addr,
                           vx_float32 x, vx_float32 y, const vx_border_mode_t *borders, vx_uint8 *pixel)
@@ -66,8 +67,186 @@ static void transform_perspective(vx_uint32 dst_x, vx_uint32 dst_y, const vx_flo
     *src_y = (dst_x * m[1] + dst_y * m[4] + m[7]) / z;
 }
 
+/*! \brief The fractional bits of the source coordinates on the fast path. */
+#define WARP_SHIFT          (16)
+/*! \brief The fractional bits of the bilinear weights, taken from the top of the coordinate fraction. */
+#define WARP_WEIGHT_BITS    (11)
+#define WARP_WEIGHT_ONE     (1 << WARP_WEIGHT_BITS)
+/*! \brief How far in pixels a coordinate on the fast path stays from the edges of the source,
+ * which covers the rounding of the single precision coordinates.
+ */
+#define WARP_MARGIN         (1.0/64.0)
+
+static void warp_pixel(void *src_base, vx_imagepatch_addressing_t *src_addr, vx_rectangle_t *src_rect,
+                       vx_uint32 x, vx_uint32 y, const vx_float32 m[], transform_f transform,
+                       vx_enum type, const vx_border_mode_t *borders, vx_uint8 *dst)
+{
+    vx_float32 xf;
+    vx_float32 yf;
+    transform(x, y, m, &xf, &yf);
+    xf -= (vx_float32)src_rect->start_x;
+    yf -= (vx_float32)src_rect->start_y;
+
+    if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
+    {
+        read_pixel(src_base, src_addr, xf, yf, borders, dst);
+    }
+    else if (type == VX_INTERPOLATION_TYPE_BILINEAR)
+    {
+        vx_uint8 tl = 0, tr = 0, bl = 0, br = 0;
+        vx_bool defined = vx_true_e;
+        defined &= read_pixel(src_base, src_addr, floorf(xf), floorf(yf), borders, &tl);
+        defined &= read_pixel(src_base, src_addr, floorf(xf) + 1, floorf(yf), borders, &tr);
+        defined &= read_pixel(src_base, src_addr, floorf(xf), floorf(yf) + 1, borders, &bl);
+        defined &= read_pixel(src_base, src_addr, floorf(xf) + 1, floorf(yf) + 1, borders, &br);
+        if (defined)
+        {
+            vx_float32 ar = xf - floorf(xf);
+            vx_float32 ab = yf - floorf(yf);
+            vx_float32 al = 1.0f - ar;
+            vx_float32 at = 1.0f - ab;
+            *dst = tl * al * at + tr * ar * at + bl * al * ab + br * ar * ab;
+        }
+    }
+}
+
+/*! \brief Narrows the real interval [*x0, *x1] to where c0 + c1 * x >= 0. */
+static void warp_clip(vx_float64 c0, vx_float64 c1, vx_float64 *x0, vx_float64 *x1)
+{
+    if (c1 > 0.0)
+    {
+        vx_float64 x = -c0 / c1;
+        if (x > *x0)
+            *x0 = x;
+    }
+    else if (c1 < 0.0)
+    {
+        vx_float64 x = -c0 / c1;
+        if (x < *x1)
+            *x1 = x;
+    }
+    else if (c0 < 0.0)
+    {
+        *x1 = *x0 - 1.0;
+    }
+}
+
+/*! \brief Computes the columns [*xs, *xe) of the destination row y whose whole sampling
+ * footprint lies inside the source, so that they need no border handling.
+ * \details Along a row each source coordinate is (p + q * x) / (pz + qz * x), so keeping
+ * it in [lo, hi] is a pair of linear constraints on x as long as the denominator stays
+ * positive, and the columns that meet all of them form a single span.
+ */
+static void warp_span(const vx_float32 m[], vx_bool perspective, vx_uint32 y, vx_uint32 width,
+                      const vx_rectangle_t *src_rect, const vx_imagepatch_addressing_t *src_addr,
+                      vx_enum type, vx_uint32 *xs, vx_uint32 *xe)
+{
+    /* bilinear also reads the pixel to the right and below */
+    vx_float64 edge = (type == VX_INTERPOLATION_TYPE_BILINEAR ? 1.0 : 0.0);
+    vx_float64 lo_x = (vx_float64)src_rect->start_x + WARP_MARGIN;
+    vx_float64 lo_y = (vx_float64)src_rect->start_y + WARP_MARGIN;
+    vx_float64 hi_x = (vx_float64)src_rect->start_x + src_addr->dim_x - edge - WARP_MARGIN;
+    vx_float64 hi_y = (vx_float64)src_rect->start_y + src_addr->dim_y - edge - WARP_MARGIN;
+    vx_float64 px, qx, py, qy, pz = 1.0, qz = 0.0;
+    vx_float64 x0 = 0.0, x1 = (vx_float64)width - 1.0;
+
+    *xs = *xe = 0u;
+    if (perspective)
+    {
+        px = y * (vx_float64)m[3] + m[6];
+        py = y * (vx_float64)m[4] + m[7];
+        pz = y * (vx_float64)m[5] + m[8];
+        qx = m[0];
+        qy = m[1];
+        qz = m[2];
+        if ((pz <= 0.0) || (pz + qz * x1 <= 0.0))
+            return;
+    }
+    else
+    {
+        px = y * (vx_float64)m[2] + m[4];
+        py = y * (vx_float64)m[3] + m[5];
+        qx = m[0];
+        qy = m[1];
+    }
+    warp_clip(px - lo_x * pz, qx - lo_x * qz, &x0, &x1);
+    warp_clip(hi_x * pz - px, hi_x * qz - qx, &x0, &x1);
+    warp_clip(py - lo_y * pz, qy - lo_y * qz, &x0, &x1);
+    warp_clip(hi_y * pz - py, hi_y * qz - qy, &x0, &x1);
+    if (x0 <= x1)
+    {
+        *xs = (vx_uint32)ceil(x0);
+        *xe = (vx_uint32)floor(x1) + 1u;
+        if (*xe > width)
+            *xe = width;
+        if (*xs > *xe)
+            *xs = *xe;
+    }
+}
+
+/*! \brief Computes the source coordinates of the columns [xs, xe) of the destination row y,
+ * scaled by scale. The products are summed in the same order as the per pixel transforms so
+ * that both paths sample the same pixels, and the loops have no branches so that they vectorize.
+ */
+static void warp_coords(const vx_float32 m[], vx_bool perspective, vx_uint32 y, vx_uint32 xs, vx_uint32 xe,
+                        const vx_rectangle_t *src_rect, vx_float32 scale,
+                        vx_int32 * VX_RESTRICT cx, vx_int32 * VX_RESTRICT cy)
+{
+    vx_float32 ox = (vx_float32)src_rect->start_x;
+    vx_float32 oy = (vx_float32)src_rect->start_y;
+    vx_int32 x;
+    if (perspective)
+    {
+        vx_float32 tx = y * m[3], ty = y * m[4], tz = y * m[5];
+        for (x = (vx_int32)xs; x < (vx_int32)xe; x++)
+        {
+            vx_float32 z = x * m[2] + tz + m[8];
+            cx[x] = (vx_int32)(((x * m[0] + tx + m[6]) / z - ox) * scale);
+            cy[x] = (vx_int32)(((x * m[1] + ty + m[7]) / z - oy) * scale);
+        }
+    }
+    else
+    {
+        vx_float32 tx = y * m[2], ty = y * m[3];
+        for (x = (vx_int32)xs; x < (vx_int32)xe; x++)
+        {
+            cx[x] = (vx_int32)((x * m[0] + tx + m[4] - ox) * scale);
+            cy[x] = (vx_int32)((x * m[1] + ty + m[5] - oy) * scale);
+        }
+    }
+}
+
+static void warp_row_nearest(const vx_uint8 *src, const vx_imagepatch_addressing_t *src_addr,
+                             const vx_int32 *cx, const vx_int32 *cy, vx_uint32 xs, vx_uint32 xe,
+                             vx_uint8 *dst)
+{
+    vx_int32 sx = src_addr->stride_x, sy = src_addr->stride_y;
+    vx_uint32 x;
+    for (x = xs; x < xe; x++)
+    {
+        dst[x] = src[cy[x] * sy + cx[x] * sx];
+    }
+}
+
+static void warp_row_bilinear(const vx_uint8 *src, const vx_imagepatch_addressing_t *src_addr,
+                              const vx_int32 *cx, const vx_int32 *cy, vx_uint32 xs, vx_uint32 xe,
+                              vx_uint8 *dst)
+{
+    vx_int32 sx = src_addr->stride_x, sy = src_addr->stride_y;
+    vx_uint32 x;
+    for (x = xs; x < xe; x++)
+    {
+        const vx_uint8 *s = &src[(cy[x] >> WARP_SHIFT) * sy + (cx[x] >> WARP_SHIFT) * sx];
+        vx_uint32 ar = (cx[x] >> (WARP_SHIFT - WARP_WEIGHT_BITS)) & (WARP_WEIGHT_ONE - 1);
+        vx_uint32 ab = (cy[x] >> (WARP_SHIFT - WARP_WEIGHT_BITS)) & (WARP_WEIGHT_ONE - 1);
+        vx_uint32 top = s[0] * (WARP_WEIGHT_ONE - ar) + s[sx] * ar;
+        vx_uint32 bottom = s[sy] * (WARP_WEIGHT_ONE - ar) + s[sy + sx] * ar;
+        dst[x] = (vx_uint8)((top * (WARP_WEIGHT_ONE - ab) + bottom * ab) >> (2 * WARP_WEIGHT_BITS));
+    }
+}
+
 static vx_status vxWarpGeneric(vx_image src_image, vx_matrix matrix, vx_scalar stype, vx_image dst_image,
-                               const vx_border_mode_t *borders, transform_f transform)
+                               const vx_border_mode_t *borders, vx_bool perspective)
 {
     vx_status status = VX_SUCCESS;
     void *src_base = NULL;
@@ -76,6 +255,7 @@ static vx_status vxWarpGeneric(vx_image src_image, vx_matrix matrix, vx_scalar s
     vx_uint32 dst_width, dst_height;
     vx_rectangle_t src_rect;
     vx_rectangle_t dst_rect;
+    transform_f transform = (perspective ? transform_perspective : transform_affine);
 
     vx_float32 m[9];
     vx_enum type = 0;
@@ -99,42 +279,42 @@ static vx_status vxWarpGeneric(vx_image src_image, vx_matrix matrix, vx_scalar s
 
     if (status == VX_SUCCESS)
     {
+        /* the fast path keeps the coordinates in fixed point, so it needs them to fit */
+        vx_int32 *coords = NULL;
+        vx_float32 scale = (type == VX_INTERPOLATION_TYPE_BILINEAR ? (vx_float32)(1 << WARP_SHIFT) : 1.0f);
+        if ((src_addr.dim_x < (1u << (31 - WARP_SHIFT))) && (src_addr.dim_y < (1u << (31 - WARP_SHIFT))) &&
+            ((type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR) || (type == VX_INTERPOLATION_TYPE_BILINEAR)))
+        {
+            coords = (vx_int32 *)malloc(2u * dst_addr.dim_x * sizeof(vx_int32));
+        }
+
         for (y = 0u; y < dst_addr.dim_y; y++)
         {
-            for (x = 0u; x < dst_addr.dim_x; x++)
+            vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr);
+            vx_uint32 xs = 0u, xe = 0u;
+
+            if (coords)
+                warp_span(m, perspective, y, dst_addr.dim_x, &src_rect, &src_addr, type, &xs, &xe);
+
+            for (x = 0u; x < xs; x++)
+                warp_pixel(src_base, &src_addr, &src_rect, x, y, m, transform, type, borders, &dst[x]);
+
+            if (xs < xe)
             {
-                vx_uint8 *dst = vxFormatImagePatchAddress2d(dst_base, x, y, &dst_addr);
-
-                vx_float32 xf;
-                vx_float32 yf;
-                transform(x, y, m, &xf, &yf);
-                xf -= (vx_float32)src_rect.start_x;
-                yf -= (vx_float32)src_rect.start_y;
-
-                if (type == VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR)
-                {
-                    read_pixel(src_base, &src_addr, xf, yf, borders, dst);
-                }
-                else if (type == VX_INTERPOLATION_TYPE_BILINEAR)
-                {
-                    vx_uint8 tl = 0, tr = 0, bl = 0, br = 0;
-                    vx_bool defined = vx_true_e;
-                    defined &= read_pixel(src_base, &src_addr, floorf(xf), floorf(yf), borders, &tl);
-                    defined &= read_pixel(src_base, &src_addr, floorf(xf) + 1, floorf(yf), borders, &tr);
-                    defined &= read_pixel(src_base, &src_addr, floorf(xf), floorf(yf) + 1, borders, &bl);
-                    defined &= read_pixel(src_base, &src_addr, floorf(xf) + 1, floorf(yf) + 1, borders, &br);
-                    if (defined)
-                    {
-                        vx_float32 ar = xf - floorf(xf);
-                        vx_float32 ab = yf - floorf(yf);
-                        vx_float32 al = 1.0f - ar;
-                        vx_float32 at = 1.0f - ab;
-                        *dst = tl * al * at + tr * ar * at + bl * al * ab + br * ar * ab;
-                    }
-                }
+                vx_int32 *cx = coords, *cy = &coords[dst_addr.dim_x];
+                warp_coords(m, perspective, y, xs, xe, &src_rect, scale, cx, cy);
+                if (type == VX_INTERPOLATION_TYPE_BILINEAR)
+                    warp_row_bilinear(src_base, &src_addr, cx, cy, xs, xe, dst);
+                else
+                    warp_row_nearest(src_base, &src_addr, cx, cy, xs, xe, dst);
             }
+
+            for (x = xe; x < dst_addr.dim_x; x++)
+                warp_pixel(src_base, &src_addr, &src_rect, x, y, m, transform, type, borders, &dst[x]);
         }
 
+        free(coords);
+
         /*! \todo compute maximum area rectangle */
     }
 
@@ -148,11 +328,11 @@ static vx_status vxWarpGeneric(vx_image src_image, vx_matrix matrix, vx_scalar s
 // nodeless version of the WarpAffine kernel
 vx_status vxWarpAffine(vx_image src_image, vx_matrix matrix, vx_scalar stype, vx_image dst_image, const vx_border_mode_t *borders)
 {
-    return vxWarpGeneric(src_image, matrix, stype, dst_image, borders, transform_affine);
+    return vxWarpGeneric(src_image, matrix, stype, dst_image, borders, vx_false_e);
 }
 
 // nodeless version of the WarpPerspective kernel
 vx_status vxWarpPerspective(vx_image src_image, vx_matrix matrix, vx_scalar stype, vx_image dst_image, const vx_border_mode_t *borders)
 {
-    return vxWarpGeneric(src_image, matrix, stype, dst_image, borders, transform_perspective);
+    return vxWarpGeneric(src_image, matrix, stype, dst_image, borders, vx_true_e);
 }
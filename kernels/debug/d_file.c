@@ -191,6 +191,8 @@ vx_status vxFReadImage(vx_array file, vx_image output)
 
     for (p = 0; p < planes; p++)
     {
+        /* map each plane, a pointer left from the previous plane would be copied into */
+        src = NULL;
         status = vxAccessImagePatch(output, &rect, p, &addr, (void **)&src, VX_WRITE_ONLY);
         if (status == VX_SUCCESS)
         {
@@ -59,6 +59,15 @@ const vx_char extensions[] =
 #endif
 #if defined(EXPERIMENTAL_USE_VARIANTS)
     OPENVX_KHR_VARIANTS" "
+#endif
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+    OPENVX_EXT_PIPELINING" "
+#endif
+#if defined(EXPERIMENTAL_USE_MEMORY_PLAN)
+    OPENVX_EXT_MEMORY_PLAN" "
+#endif
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    OPENVX_EXT_IMAGE_HANDLE" "
 #endif
     " ";
 
@@ -101,6 +110,8 @@ static vx_bool vxWorkerNode(vx_threadpool_worker_t *worker)
     }
     // collect the specific results.
     worker->data->v3 = (vx_value_t)action;
+    // hand the node back to the graph executor to release its successors.
+    vxPostNodeCompletion(node->graph, worker->data);
     return ret;
 }
 
@@ -108,28 +119,97 @@ static vx_value_t vxWorkerGraph(void *arg)
 {
     vx_processor_t *proc = (vx_processor_t *)arg;
     VX_PRINT(VX_ZONE_CONTEXT, "Starting thread!\n");
-    while (proc->running == vx_true_e)
+    for (;;)
     {
         vx_graph g = 0;
         vx_status s = VX_FAILURE;
-        vx_value_set_t *data = NULL;
-        if (vxReadQueue(&proc->input, &data) == vx_true_e)
+
+        vxSemWait(&proc->lock);
+        if (proc->running == vx_false_e)
+        {
+            vxSemPost(&proc->lock);
+            break;
+        }
+        if (proc->count > 0u)
+        {
+            g = proc->queue[proc->start];
+            proc->start = (proc->start + 1u) % proc->capacity;
+            proc->count--;
+        }
+        else
         {
-            g = (vx_graph)data->v1;
-            // s = (vx_status)v2;
-            VX_PRINT(VX_ZONE_CONTEXT, "Read graph=" VX_FMT_REF ", status=%d\n",g,s);
+            /* only reset under the lock, so a submission can't be missed */
+            vxResetEvent(&proc->available);
+        }
+        vxSemPost(&proc->lock);
+
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+        if (g && g->pipelineDepth > 1u)
+        {
+            /* the frames report their own completion */
+            VX_PRINT(VX_ZONE_CONTEXT, "Read pipelined graph=" VX_FMT_REF "\n", g);
+            vxExecutePipeline(g);
+        }
+        else
+#endif
+        if (g)
+        {
+            VX_PRINT(VX_ZONE_CONTEXT, "Read graph=" VX_FMT_REF "\n", g);
             s = vxProcessGraph(g);
-            VX_PRINT(VX_ZONE_CONTEXT, "Writing graph=" VX_FMT_REF ", status=%d\n",g,s);
-            data->v1 = (vx_value_t)g;
-            data->v2 = (vx_status)s;
-            if (vxWriteQueue(&proc->output, data) == vx_false_e)
-                VX_PRINT(VX_ZONE_ERROR, "Failed to write graph=" VX_FMT_REF " status=%d\n", g, s);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+            vxReleaseGraphHandles(&g->held);
+#endif
+            VX_PRINT(VX_ZONE_CONTEXT, "Completed graph=" VX_FMT_REF ", status=%d\n", g, s);
+            g->scheduledStatus = s;
+            vxSetEvent(&g->scheduledEvent);
+        }
+        else
+        {
+            vxWaitEvent(&proc->available, VX_INT_FOREVER);
         }
     }
     VX_PRINT(VX_ZONE_CONTEXT,"Stopping thread!\n");
     return 0;
 }
 
+VX_INT_API vx_bool vxSubmitGraph(vx_context context, vx_graph graph)
+{
+    vx_processor_t *proc = &context->proc;
+    vx_bool ret = vx_true_e;
+    vxSemWait(&proc->lock);
+    if (proc->count == proc->capacity)
+    {
+        /* grow the ring, unwrapping the entries into the new queue */
+        vx_uint32 q, capacity = (proc->capacity ? proc->capacity * 2u : VX_INT_GRAPH_QUEUE_DEPTH);
+        vx_graph *queue = (vx_graph *)calloc(capacity, sizeof(vx_graph));
+        if (queue)
+        {
+            for (q = 0u; q < proc->count; q++)
+            {
+                queue[q] = proc->queue[(proc->start + q) % proc->capacity];
+            }
+            free(proc->queue);
+            proc->queue = queue;
+            proc->capacity = capacity;
+            proc->start = 0u;
+            VX_PRINT(VX_ZONE_CONTEXT, "Graph queue grew to %u entries\n", capacity);
+        }
+        else
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Failed to grow the graph queue!\n");
+            ret = vx_false_e;
+        }
+    }
+    if (ret == vx_true_e)
+    {
+        proc->queue[(proc->start + proc->count) % proc->capacity] = graph;
+        proc->count++;
+        vxSetEvent(&proc->available);
+    }
+    vxSemPost(&proc->lock);
+    return ret;
+}
+
 VX_INT_API vx_bool vxIsValidType(vx_enum type)
 {
     vx_bool ret = vx_false_e;
@@ -220,6 +300,8 @@ VX_INT_API vx_bool vxAddAccessor(vx_context context,
 {
     vx_uint32 a;
     vx_bool worked = vx_false_e;
+    /* nodes of concurrently executing graphs share the accessor list */
+    vxSemWait(&context->base.lock);
     for (a = 0u; a < dimof(context->accessors); a++)
     {
         if (context->accessors[a].used == vx_false_e)
@@ -229,7 +311,7 @@ VX_INT_API vx_bool vxAddAccessor(vx_context context,
             {
                 context->accessors[a].ptr = malloc(size);
                 if (context->accessors[a].ptr == NULL)
-                    return vx_false_e;
+                    break;
                 context->accessors[a].allocated = vx_true_e;
             }
             else
@@ -245,6 +327,7 @@ VX_INT_API vx_bool vxAddAccessor(vx_context context,
             break;
         }
     }
+    vxSemPost(&context->base.lock);
     return worked;
 }
 
@@ -252,6 +335,7 @@ VX_INT_API vx_bool vxFindAccessor(vx_context context, void *ptr, vx_uint32 *pInd
 {
     vx_uint32 a;
     vx_bool worked = vx_false_e;
+    vxSemWait(&context->base.lock);
     for (a = 0u; a < dimof(context->accessors); a++)
     {
         if (context->accessors[a].used == vx_true_e)
@@ -265,6 +349,7 @@ VX_INT_API vx_bool vxFindAccessor(vx_context context, void *ptr, vx_uint32 *pInd
             }
         }
     }
+    vxSemPost(&context->base.lock);
     return worked;
 }
 
@@ -272,11 +357,13 @@ VX_INT_API void vxRemoveAccessor(vx_context context, vx_uint32 index)
 {
     if (index < dimof(context->accessors))
     {
+        vxSemWait(&context->base.lock);
         if (context->accessors[index].allocated == vx_true_e)
         {
             free(context->accessors[index].ptr);
         }
         memset(&context->accessors[index], 0, sizeof(vx_external_t));
+        vxSemPost(&context->base.lock);
         VX_PRINT(VX_ZONE_CONTEXT, "Removed accessors[%u]\n", index);
     }
 }
@@ -318,6 +405,8 @@ VX_API_ENTRY vx_context VX_API_CALL vxCreateContext()
                                                   sizeof(vx_work_t),
                                                   vxWorkerNode,
                                                   context);
+            vxCreateSem(&context->ref_lock, 1);
+            vxInitMemoryPool(context);
             vxCreateConstErrors(context);
 
             /* load all targets */
@@ -332,6 +421,10 @@ VX_API_ENTRY vx_context VX_API_CALL vxCreateContext()
             if (context->num_targets == 0)
             {
                 VX_PRINT(VX_ZONE_ERROR, "No targets loaded!\n");
+                vxDestroySem(&context->ref_lock);
+                vxDeinitMemoryPool(context);
+                free(context->reftable);
+                free(context->reffree);
                 free(context);
                 vxSemPost(&context_lock);
                 return 0;
@@ -383,11 +476,19 @@ VX_API_ENTRY vx_context VX_API_CALL vxCreateContext()
                 }
             }
 
-            // create the internal thread which processes graphs for asynchronous mode.
-            vxInitQueue(&context->proc.input);
-            vxInitQueue(&context->proc.output);
+            // create the internal threads which process graphs for asynchronous mode.
+            vxCreateSem(&context->proc.lock, 1);
+            vxInitEvent(&context->proc.available, vx_false_e);
             context->proc.running = vx_true_e;
-            context->proc.thread = vxCreateThread(vxWorkerGraph, &context->proc);
+            context->proc.threads = (vx_thread_t *)calloc(VX_INT_GRAPH_PROCESSORS, sizeof(vx_thread_t));
+            if (context->proc.threads)
+            {
+                for (p = 0u; p < VX_INT_GRAPH_PROCESSORS; p++)
+                {
+                    context->proc.threads[p] = vxCreateThread(vxWorkerGraph, &context->proc);
+                }
+                context->proc.numThreads = VX_INT_GRAPH_PROCESSORS;
+            }
             single_context = context;
         }
     }
@@ -413,12 +514,20 @@ VX_API_ENTRY vx_status VX_API_CALL vxReleaseContext(vx_context *c)
     {
         if (vxDecrementReference(&context->base, VX_EXTERNAL) == 0)
         {
-            vxDestroyThreadpool(&context->workers);
+            /* stop the graph processors before the workers they issue nodes to */
+            vxSemWait(&context->proc.lock);
             context->proc.running = vx_false_e;
-            vxPopQueue(&context->proc.input);
-            vxJoinThread(context->proc.thread, NULL);
-            vxDeinitQueue(&context->proc.output);
-            vxDeinitQueue(&context->proc.input);
+            vxSetEvent(&context->proc.available);
+            vxSemPost(&context->proc.lock);
+            for (t = 0u; t < context->proc.numThreads; t++)
+            {
+                vxJoinThread(context->proc.threads[t], NULL);
+            }
+            free(context->proc.threads);
+            free(context->proc.queue);
+            vxDeinitEvent(&context->proc.available);
+            vxDestroySem(&context->proc.lock);
+            vxDestroyThreadpool(&context->workers);
 
             /* Deregister any log callbacks if there is any registered */
             vxRegisterLogCallback(context, NULL, vx_false_e);
@@ -433,7 +542,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxReleaseContext(vx_context *c)
              *   4. This garbage collection must be done before the targets are released since some of
              *      these external references may have internal references to target kernels.
              */
-            for (r = 0; r < VX_INT_MAX_REF; r++)
+            for (r = 0; r < context->num_reftable; r++)
             {
                 vx_reference_t *ref = context->reftable[r];
 
@@ -485,7 +594,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxReleaseContext(vx_context *c)
                     vxRemoveAccessor(context, a);
 
             /* By now, all external and internal references should be removed */
-            for (r = 0; r < VX_INT_MAX_REF; r++)
+            for (r = 0; r < context->num_reftable; r++)
             {
                 if(context->reftable[r])
                     VX_PRINT(VX_ZONE_ERROR,"Reference %d not removed\n", r);
@@ -494,6 +603,10 @@ VX_API_ENTRY vx_status VX_API_CALL vxReleaseContext(vx_context *c)
             /*! \internal wipe away the context memory first */
             /* Normally destroy sem is part of release reference, but can't for context */
             vxDestroySem(&((vx_reference )context)->lock);
+            vxDestroySem(&context->ref_lock);
+            vxDeinitMemoryPool(context);
+            free(context->reftable);
+            free(context->reffree);
             memset(context, 0, sizeof(vx_context_t));
             free((void *)context);
             vxDestroySem(&global_lock);
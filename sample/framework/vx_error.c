@@ -55,7 +55,8 @@ vx_error_t *vxGetErrorObject(vx_context_t *context, vx_status status)
 {
     vx_error_t *error = NULL;
     vx_size i = 0ul;
-    for (i = 0ul; i < context->num_references; i++)
+    vxSemWait(&context->ref_lock);
+    for (i = 0ul; i < context->num_reftable; i++)
     {
         if (context->reftable[i] == NULL)
             continue;
@@ -70,6 +71,7 @@ vx_error_t *vxGetErrorObject(vx_context_t *context, vx_status status)
             error = NULL;
         }
     }
+    vxSemPost(&context->ref_lock);
     return error;
 }
 
@@ -417,7 +417,8 @@ void vxContaminateGraphs(vx_reference ref)
         /*! \internal Scan the entire context for graphs which may contain
          * this reference and mark them as unverified.
          */
-        for (r = 0u; r < context->num_references; r++)
+        vxSemWait(&context->ref_lock);
+        for (r = 0u; r < context->num_reftable; r++)
         {
             if (context->reftable[r] == NULL)
                 continue;
@@ -445,9 +446,634 @@ void vxContaminateGraphs(vx_reference ref)
                 }
             }
         }
+        vxSemPost(&context->ref_lock);
     }
 }
 
+/*! \brief Determines if a parameter of the graph is a virtual image or array of
+ * this graph which nothing else in the graph aliases (ROIs) and which carries no
+ * state across executions (bidirectional use). The storage of such objects can
+ * be chosen freely by the graph, per pipelined frame or by the memory planner.
+ */
+static vx_bool vxIsPrivateVirtual(vx_graph graph, vx_reference ref)
+{
+    vx_uint32 n, p;
+    if ((ref == NULL) || (ref->is_virtual == vx_false_e) || (ref->scope != (vx_reference_t *)graph))
+        return vx_false_e;
+    if (ref->type == VX_TYPE_IMAGE)
+    {
+        vx_image img = (vx_image)ref;
+        if (img->parent && img->parent != img)
+            return vx_false_e;
+    }
+    else if (ref->type != VX_TYPE_ARRAY)
+    {
+        return vx_false_e;
+    }
+    for (n = 0u; n < graph->numNodes; n++)
+    {
+        for (p = 0u; p < graph->nodes[n]->kernel->signature.num_parameters; p++)
+        {
+            vx_reference other = graph->nodes[n]->parameters[p];
+            if (other == NULL)
+                continue;
+            if ((other == ref) &&
+                (graph->nodes[n]->kernel->signature.directions[p] == VX_BIDIRECTIONAL))
+                return vx_false_e;
+            if ((other != ref) && (other->type == VX_TYPE_IMAGE) && (ref->type == VX_TYPE_IMAGE))
+            {
+                vx_image img = (vx_image)other;
+                while (img->parent && img->parent != img)
+                {
+                    img = img->parent;
+                    if (img == (vx_image)ref)
+                        return vx_false_e;
+                }
+            }
+        }
+    }
+    return vx_true_e;
+}
+
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+/*! \brief Creates and allocates a copy of a virtual object for another pipelined frame. */
+static vx_reference vxCreatePipelineVirtual(vx_graph graph, vx_reference ref)
+{
+    vx_reference copy = NULL;
+    if (ref->type == VX_TYPE_IMAGE)
+    {
+        vx_image img = (vx_image)ref;
+        copy = (vx_reference)vxCreateVirtualImage(graph, img->width, img->height, img->format);
+        if ((vxGetStatus(copy) != VX_SUCCESS) || (vxAllocateImage((vx_image)copy) == vx_false_e))
+        {
+            vxReleaseReferenceInt(&copy, VX_TYPE_IMAGE, VX_EXTERNAL, NULL);
+        }
+    }
+    else if (ref->type == VX_TYPE_ARRAY)
+    {
+        vx_array arr = (vx_array)ref;
+        copy = (vx_reference)vxCreateVirtualArray(graph, arr->item_type, arr->capacity);
+        if ((vxGetStatus(copy) != VX_SUCCESS) || (vxAllocateArray((vx_array)copy) == vx_false_e))
+        {
+            vxReleaseReferenceInt(&copy, VX_TYPE_ARRAY, VX_EXTERNAL, NULL);
+        }
+    }
+    return copy;
+}
+#endif
+
+/*! \brief Computes a topological order of the nodes of the graph and the ancestry
+ * of each node, where ancestors[n*numNodes + m] is set if node m precedes node n.
+ * \pre The successors of the nodes are computed and the graph has no cycle.
+ * \return The ancestry matrix which the caller frees, or NULL when out of memory.
+ */
+static vx_uint8 *vxComputeAncestors(vx_graph graph, vx_uint32 order[])
+{
+    vx_uint32 numNodes = graph->numNodes;
+    vx_uint32 n, s, i, head = 0u, tail = 0u;
+    vx_uint8 *ancestors = (vx_uint8 *)calloc(numNodes * numNodes, sizeof(vx_uint8));
+    vx_uint32 *pending = (vx_uint32 *)calloc(numNodes, sizeof(vx_uint32));
+    if ((ancestors == NULL) || (pending == NULL))
+    {
+        free(ancestors);
+        free(pending);
+        return NULL;
+    }
+    for (n = 0u; n < numNodes; n++)
+    {
+        pending[n] = graph->nodes[n]->numPredecessors;
+        if (pending[n] == 0u)
+            order[tail++] = n;
+    }
+    while (head < tail)
+    {
+        vx_node_t *node = graph->nodes[order[head]];
+        for (s = 0u; s < node->numSuccessors; s++)
+        {
+            vx_uint32 next = node->successors[s];
+            for (i = 0u; i < numNodes; i++)
+                ancestors[next*numNodes + i] |= ancestors[order[head]*numNodes + i];
+            ancestors[next*numNodes + order[head]] = 1u;
+            if (--pending[next] == 0u)
+                order[tail++] = next;
+        }
+        head++;
+    }
+    free(pending);
+    return ancestors;
+}
+
+/*! \brief A virtual object placed by the memory planner. */
+typedef struct _vx_plan_object_t {
+    vx_reference ref;
+    vx_memory_t *memory;
+    /*! \brief The index of the node which writes the object. */
+    vx_uint32    producer;
+    /*! \brief The aligned number of bytes of all planes. */
+    vx_size      size;
+    /*! \brief The index of the slab the object is placed in. */
+    vx_uint32    slab;
+} vx_plan_object_t;
+
+/*! \brief A region of the arena which objects with disjoint lifetimes share. */
+typedef struct _vx_plan_slab_t {
+    vx_size      offset;
+    vx_size      size;
+    /*! \brief The object which was placed in the slab last. */
+    vx_uint32    last;
+} vx_plan_slab_t;
+
+static vx_memory_t *vxGetPlannableMemory(vx_reference ref)
+{
+    if (ref->type == VX_TYPE_IMAGE)
+        return &((vx_image)ref)->memory;
+    else if ((ref->type == VX_TYPE_ARRAY) && (((vx_array)ref)->capacity > 0))
+        return &((vx_array)ref)->memory;
+    return NULL;
+}
+
+/*! \brief Unbinds the objects placed by \ref vxPlanGraphMemory and frees the arena. */
+static void vxReleaseMemoryPlan(vx_graph graph)
+{
+    vx_uint32 i;
+    for (i = 0u; i < graph->numPlanned; i++)
+    {
+        vx_reference ref = graph->planned[i];
+        vxFreeMemory(graph->base.context, vxGetPlannableMemory(ref));
+        vxReleaseReferenceInt(&ref, ref->type, VX_INTERNAL, NULL);
+    }
+    if (graph->planned)
+        free(graph->planned);
+    if (graph->arena)
+        free(graph->arena);
+    graph->planned = NULL;
+    graph->numPlanned = 0u;
+    graph->arena = NULL;
+    graph->plannedBytes = 0u;
+    graph->naiveBytes = 0u;
+}
+
+/*! \brief Places the private virtual objects of the graph into one arena.
+ * \details An object may reuse the slab of another object once every node which
+ * uses the other object is an ancestor of the node which writes it. Ancestry,
+ * rather than a position in one topological order, is what keeps the plan valid
+ * when independent branches of the graph execute in parallel. Objects are placed
+ * in topological order of their producers into the best fitting free slab. The
+ * nodes of a tile fused chain count as executing when the head of the chain does.
+ */
+static vx_status vxPlanGraphMemory(vx_graph graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 numNodes = graph->numNodes;
+    vx_uint32 n, p, o, s, i, numObjects = 0u, numSlabs = 0u;
+    vx_uint8 *ancestors = NULL;
+    vx_uint32 *order = NULL, *host = NULL;
+    vx_plan_object_t *objects = NULL;
+    vx_plan_slab_t *slabs = NULL;
+    vx_uint8 *base = NULL;
+
+    vxReleaseMemoryPlan(graph);
+#if defined(EXPERIMENTAL_USE_OPENCL)
+    /* the OpenCL target maps each allocation on its own */
+    return status;
+#endif
+    if (numNodes == 0u)
+        return status;
+
+    order = (vx_uint32 *)calloc(numNodes, sizeof(vx_uint32));
+    host = (vx_uint32 *)calloc(numNodes, sizeof(vx_uint32));
+    ancestors = order ? vxComputeAncestors(graph, order) : NULL;
+    objects = (vx_plan_object_t *)calloc(numNodes * VX_INT_MAX_PARAMS, sizeof(vx_plan_object_t));
+    slabs = (vx_plan_slab_t *)calloc(numNodes * VX_INT_MAX_PARAMS, sizeof(vx_plan_slab_t));
+    if (!ancestors || !order || !host || !objects || !slabs)
+    {
+        status = VX_ERROR_NO_MEMORY;
+        goto exit;
+    }
+
+    /* the index of the node during whose execution each node executes */
+    for (n = 0u; n < numNodes; n++)
+    {
+        host[n] = n;
+    }
+#ifdef OPENVX_KHR_TILING
+    for (n = 0u; n < numNodes; n++)
+    {
+        vx_node_t *next = NULL;
+        if (graph->nodes[n]->tileFused == vx_true_e)
+            continue;
+        for (next = graph->nodes[n]->tileNext; next != NULL; next = next->tileNext)
+        {
+            for (i = 0u; i < numNodes; i++)
+            {
+                if (graph->nodes[i] == next)
+                    host[i] = n;
+            }
+        }
+    }
+#endif
+
+    /* gather the written private virtual objects, in order of their producers */
+    for (i = 0u; i < numNodes; i++)
+    {
+        vx_node_t *node = graph->nodes[order[i]];
+        for (p = 0u; p < node->kernel->signature.num_parameters; p++)
+        {
+            vx_reference ref = node->parameters[p];
+            vx_memory_t *memory = NULL;
+            if ((node->kernel->signature.directions[p] != VX_OUTPUT) ||
+                (vxIsPrivateVirtual(graph, ref) == vx_false_e))
+                continue;
+            memory = vxGetPlannableMemory(ref);
+            if ((memory == NULL) || (memory->allocated == vx_true_e))
+                continue;
+            objects[numObjects].ref = ref;
+            objects[numObjects].memory = memory;
+            objects[numObjects].producer = order[i];
+            objects[numObjects].size = 0u;
+            for (o = 0u; o < (vx_uint32)memory->nptrs; o++)
+            {
+                vx_size size = vxComputeMemoryLayout(memory, o);
+                objects[numObjects].size += (size + VX_INT_ARENA_ALIGNMENT - 1) & ~(vx_size)(VX_INT_ARENA_ALIGNMENT - 1);
+            }
+            graph->naiveBytes += objects[numObjects].size;
+            numObjects++;
+        }
+    }
+
+    for (o = 0u; o < numObjects; o++)
+    {
+        vx_uint32 best = numSlabs;
+        for (s = 0u; s < numSlabs; s++)
+        {
+            vx_reference last = objects[slabs[s].last].ref;
+            vx_bool free_slab = vx_true_e;
+            /* every user of the last occupant must precede the new producer */
+            for (n = 0u; (n < numNodes) && (free_slab == vx_true_e); n++)
+            {
+                for (p = 0u; p < graph->nodes[n]->kernel->signature.num_parameters; p++)
+                {
+                    if ((graph->nodes[n]->parameters[p] == last) &&
+                        (ancestors[host[objects[o].producer]*numNodes + host[n]] == 0u))
+                    {
+                        free_slab = vx_false_e;
+                        break;
+                    }
+                }
+            }
+            if (free_slab == vx_false_e)
+                continue;
+            /* prefer the smallest slab which fits, else grow the largest one */
+            if (best == numSlabs)
+                best = s;
+            else if (slabs[s].size >= objects[o].size)
+            {
+                if ((slabs[best].size < objects[o].size) || (slabs[s].size < slabs[best].size))
+                    best = s;
+            }
+            else if ((slabs[best].size < objects[o].size) && (slabs[s].size > slabs[best].size))
+                best = s;
+        }
+        if (best == numSlabs)
+        {
+            slabs[numSlabs].size = 0u;
+            numSlabs++;
+        }
+        if (slabs[best].size < objects[o].size)
+            slabs[best].size = objects[o].size;
+        slabs[best].last = o;
+        objects[o].slab = best;
+    }
+
+    for (s = 0u; s < numSlabs; s++)
+    {
+        slabs[s].offset = graph->plannedBytes;
+        graph->plannedBytes += slabs[s].size;
+    }
+
+    if (numObjects > 0u)
+    {
+        graph->arena = (vx_uint8 *)calloc(1, graph->plannedBytes + VX_INT_ARENA_ALIGNMENT);
+        graph->planned = (vx_reference *)calloc(numObjects, sizeof(vx_reference));
+        if ((graph->arena == NULL) || (graph->planned == NULL))
+        {
+            status = VX_ERROR_NO_MEMORY;
+            goto exit;
+        }
+        base = (vx_uint8 *)(((vx_size)graph->arena + VX_INT_ARENA_ALIGNMENT - 1) & ~(vx_size)(VX_INT_ARENA_ALIGNMENT - 1));
+    }
+    for (o = 0u; o < numObjects; o++)
+    {
+        vx_uint8 *ptrs[VX_PLANE_MAX] = {NULL};
+        vx_size offset = slabs[objects[o].slab].offset;
+        for (p = 0u; p < (vx_uint32)objects[o].memory->nptrs; p++)
+        {
+            ptrs[p] = base + offset;
+            offset += (vxComputeMemoryLayout(objects[o].memory, p) + VX_INT_ARENA_ALIGNMENT - 1) & ~(vx_size)(VX_INT_ARENA_ALIGNMENT - 1);
+        }
+        vxBindMemory(graph->base.context, objects[o].memory, ptrs);
+        vxIncrementReference(objects[o].ref, VX_INTERNAL);
+        graph->planned[graph->numPlanned++] = objects[o].ref;
+    }
+    VX_PRINT(VX_ZONE_GRAPH, "Planned %u objects into %u slabs, "VX_FMT_SIZE" bytes instead of "VX_FMT_SIZE"\n",
+             numObjects, numSlabs, graph->plannedBytes, graph->naiveBytes);
+
+exit:
+    if (status != VX_SUCCESS)
+        vxReleaseMemoryPlan(graph);
+    free(ancestors);
+    free(order);
+    free(host);
+    free(objects);
+    free(slabs);
+    return status;
+}
+
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+/*! \brief Releases the per frame state created by \ref vxPreparePipeline. */
+static void vxReleasePipeline(vx_graph graph)
+{
+    vx_uint32 f, v, i;
+    for (f = 0u; f < VX_INT_MAX_PIPELINE_DEPTH; f++)
+    {
+        vx_graph_frame_t *frame = &graph->frames[f];
+        for (v = 0u; v < frame->numVirtuals; v++)
+        {
+            vx_reference copy = frame->virtuals[2u*v + 1u];
+            vxReleaseReferenceInt(&copy, copy->type, VX_EXTERNAL, NULL);
+        }
+        if (frame->virtuals)
+            free(frame->virtuals);
+        if (frame->nodes)
+            free(frame->nodes);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+        vxReleaseGraphHandles(&frame->held);
+#endif
+        frame->virtuals = NULL;
+        frame->numVirtuals = 0u;
+        frame->nodes = NULL;
+    }
+    for (i = 0u; i < VX_INT_MAX_PARAMS; i++)
+    {
+        if (graph->parameters[i].ref)
+            vxReleaseReferenceInt(&graph->parameters[i].ref, graph->parameters[i].ref->type, VX_INTERNAL, NULL);
+    }
+}
+
+/*! \brief Builds the frame ring of a pipelined graph. Each slot binds the nodes
+ * to their own copies of the virtual objects, the first slot uses the originals.
+ */
+static vx_status vxPreparePipeline(vx_graph graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 f, n, p, i;
+
+    vxReleasePipeline(graph);
+    for (n = 0u; n < graph->numNodes; n++)
+    {
+        graph->nodes[n]->writesShared = vx_false_e;
+    }
+    if (graph->pipelineDepth <= 1u)
+    {
+        return status;
+    }
+
+    for (f = 0u; (f < graph->pipelineDepth) && (status == VX_SUCCESS); f++)
+    {
+        vx_graph_frame_t *frame = &graph->frames[f];
+        frame->nodes = (vx_frame_node_t *)calloc(graph->numNodes, sizeof(vx_frame_node_t));
+        frame->virtuals = (vx_reference *)calloc(2u * graph->numNodes * VX_INT_MAX_PARAMS, sizeof(vx_reference));
+        if ((frame->nodes == NULL) || (frame->virtuals == NULL))
+        {
+            status = VX_ERROR_NO_MEMORY;
+            break;
+        }
+        for (n = 0u; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
+        {
+            vx_node_t *node = graph->nodes[n];
+            for (p = 0u; p < node->kernel->signature.num_parameters; p++)
+            {
+                vx_reference ref = node->parameters[p];
+                vx_reference copy = NULL;
+                vx_bool isVirtual = vxIsPrivateVirtual(graph, ref);
+                if (ref && (isVirtual == vx_false_e) && (node->kernel->signature.directions[p] != VX_INPUT))
+                {
+                    /* frames overwrite the same object, see vxIsFrameNodeReady */
+                    node->writesShared = vx_true_e;
+                }
+                if ((f == 0u) || (isVirtual == vx_false_e))
+                {
+                    frame->nodes[n].parameters[p] = ref;
+                    continue;
+                }
+                /* the same virtual object is shared by its producer and consumers */
+                for (i = 0u; i < frame->numVirtuals; i++)
+                {
+                    if (frame->virtuals[2u*i] == ref)
+                    {
+                        copy = frame->virtuals[2u*i + 1u];
+                        break;
+                    }
+                }
+                if (copy == NULL)
+                {
+                    copy = vxCreatePipelineVirtual(graph, ref);
+                    if (copy == NULL)
+                    {
+                        status = VX_ERROR_NO_MEMORY;
+                        vxAddLogEntry(&graph->base, status, "Failed to create the frame %u copy of node[%u] %s parameter[%u]\n",
+                            f, n, node->kernel->name, p);
+                        break;
+                    }
+                    frame->virtuals[2u*frame->numVirtuals] = ref;
+                    frame->virtuals[2u*frame->numVirtuals + 1u] = copy;
+                    frame->numVirtuals++;
+                }
+                frame->nodes[n].parameters[p] = copy;
+            }
+        }
+        VX_PRINT(VX_ZONE_GRAPH, "Frame slot %u has %u virtual copies\n", f, frame->numVirtuals);
+    }
+
+    /* the graph parameters are captured from here on each schedule */
+    for (i = 0u; (i < graph->numParams) && (status == VX_SUCCESS); i++)
+    {
+        if (graph->parameters[i].node == NULL)
+            continue;
+        graph->parameters[i].ref = graph->parameters[i].node->parameters[graph->parameters[i].index];
+        if (graph->parameters[i].ref)
+            vxIncrementReference(graph->parameters[i].ref, VX_INTERNAL);
+    }
+
+    if (status != VX_SUCCESS)
+    {
+        vxReleasePipeline(graph);
+    }
+    return status;
+}
+#endif
+
+#ifdef OPENVX_KHR_TILING
+/*! \brief Determines if a tiling node may join the end of a tile fused chain by
+ * consuming the image which the last node of the chain writes. The node has to
+ * work on images of the same size, and everything else it reads has to be done
+ * before the head of the chain starts, since the head executes the whole chain.
+ */
+static vx_bool vxCanJoinTileChain(vx_graph graph, vx_uint8 *ancestors,
+                                  vx_uint32 chain[], vx_uint32 length,
+                                  vx_uint32 m, vx_image link)
+{
+    vx_uint32 numNodes = graph->numNodes;
+    vx_node_t *node = graph->nodes[m];
+    vx_node_t *head = graph->nodes[chain[0]];
+    vx_uint32 c, k, p, o, s;
+
+    if ((node->kernel->tiling_function == NULL) ||
+        (node->tileFused == vx_true_e) || (node->tileNext != NULL) ||
+        (node->affinity != head->affinity) ||
+        (node->child != NULL))
+        return vx_false_e;
+    for (p = 0u; p < node->kernel->signature.num_parameters; p++)
+    {
+        vx_reference ref = node->parameters[p];
+        if ((ref == NULL) || (ref->type != VX_TYPE_IMAGE))
+            continue;
+        if ((((vx_image)ref)->width != link->width) || (((vx_image)ref)->height != link->height))
+            return vx_false_e;
+        if ((node->kernel->signature.directions[p] != VX_INPUT) || (ref == (vx_reference)link))
+            continue;
+        /* nothing else may come from the chain, it is produced a strip at a time */
+        for (c = 0u; c < length; c++)
+        {
+            vx_node_t *member = graph->nodes[chain[c]];
+            for (o = 0u; o < member->kernel->signature.num_parameters; o++)
+            {
+                if ((member->kernel->signature.directions[o] != VX_INPUT) &&
+                    (vxCheckWriteDependency(ref, member->parameters[o]) == vx_true_e))
+                    return vx_false_e;
+            }
+        }
+    }
+    /* the other producers have to be done before the head starts */
+    for (k = 0u; k < numNodes; k++)
+    {
+        if (k == chain[length-1])
+            continue;
+        for (s = 0u; s < graph->nodes[k]->numSuccessors; s++)
+        {
+            if ((graph->nodes[k]->successors[s] == m) &&
+                (ancestors[chain[0]*numNodes + k] == 0u))
+                return vx_false_e;
+        }
+    }
+    return vx_true_e;
+}
+
+/*! \brief Finds the tiling node which can continue a tile fused chain, which is
+ * the only consumer of a single plane private virtual image written by the last
+ * node of the chain.
+ * \return The index of the node or UINT32_MAX.
+ */
+static vx_uint32 vxFindTileChainSuccessor(vx_graph graph, vx_uint8 *ancestors,
+                                          vx_uint32 chain[], vx_uint32 length)
+{
+    vx_node_t *last = graph->nodes[chain[length-1]];
+    vx_uint32 p, n, q;
+    for (p = 0u; p < last->kernel->signature.num_parameters; p++)
+    {
+        vx_reference ref = last->parameters[p];
+        vx_uint32 consumer = UINT32_MAX;
+        vx_bool single = vx_true_e;
+        if ((last->kernel->signature.directions[p] != VX_OUTPUT) ||
+            (ref == NULL) || (ref->type != VX_TYPE_IMAGE) ||
+            (((vx_image)ref)->planes != 1u) ||
+            (vxIsPrivateVirtual(graph, ref) == vx_false_e))
+            continue;
+        for (n = 0u; (n < graph->numNodes) && (single == vx_true_e); n++)
+        {
+            if (graph->nodes[n] == last)
+                continue;
+            for (q = 0u; q < graph->nodes[n]->kernel->signature.num_parameters; q++)
+            {
+                if (graph->nodes[n]->parameters[q] != ref)
+                    continue;
+                if ((graph->nodes[n]->kernel->signature.directions[q] != VX_INPUT) ||
+                    ((consumer != UINT32_MAX) && (consumer != n)))
+                {
+                    single = vx_false_e;
+                    break;
+                }
+                consumer = n;
+            }
+        }
+        if ((single == vx_true_e) && (consumer != UINT32_MAX) &&
+            (vxCanJoinTileChain(graph, ancestors, chain, length, consumer, (vx_image)ref) == vx_true_e))
+            return consumer;
+    }
+    return UINT32_MAX;
+}
+
+/*! \brief Links chains of tiling nodes which are connected through virtual images.
+ * \details The head of a chain walks the image once and runs every node of the
+ * chain on each strip, so the strips of the intermediate images are consumed while
+ * they are still in the cache. The other nodes of the chain return immediately
+ * when they are executed. Pipelined graphs bind the parameters of each node
+ * per frame when the node is issued, so their nodes are not linked.
+ */
+static vx_status vxLinkTileChains(vx_graph graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 numNodes = graph->numNodes;
+    vx_uint32 chain[VX_INT_MAX_TILE_CHAIN];
+    vx_uint32 *order = NULL;
+    vx_uint8 *ancestors = NULL;
+    vx_uint32 i, length, next;
+
+    for (i = 0u; i < numNodes; i++)
+    {
+        graph->nodes[i]->tileNext = NULL;
+        graph->nodes[i]->tileFused = vx_false_e;
+        graph->nodes[i]->tileDone = vx_false_e;
+    }
+    if ((numNodes < 2u) || (graph->pipelineDepth > 1u))
+        return status;
+
+    order = (vx_uint32 *)calloc(numNodes, sizeof(vx_uint32));
+    ancestors = order ? vxComputeAncestors(graph, order) : NULL;
+    if (ancestors == NULL)
+    {
+        free(order);
+        return VX_ERROR_NO_MEMORY;
+    }
+    /* in topological order, so that a chain is always found from its head */
+    for (i = 0u; i < numNodes; i++)
+    {
+        vx_node_t *head = graph->nodes[order[i]];
+        if ((head->kernel->tiling_function == NULL) ||
+            (head->tileFused == vx_true_e) ||
+            (head->child != NULL))
+            continue;
+        chain[0] = order[i];
+        length = 1u;
+        while ((length < VX_INT_MAX_TILE_CHAIN) &&
+               ((next = vxFindTileChainSuccessor(graph, ancestors, chain, length)) != UINT32_MAX))
+        {
+            graph->nodes[chain[length-1]]->tileNext = graph->nodes[next];
+            graph->nodes[next]->tileFused = vx_true_e;
+            chain[length++] = next;
+        }
+        if (length > 1u)
+        {
+            VX_PRINT(VX_ZONE_GRAPH, "Node[%u] %s heads a tile fused chain of %u nodes\n",
+                     order[i], head->kernel->name, length);
+        }
+    }
+    free(ancestors);
+    free(order);
+    return status;
+}
+#endif
+
 /******************************************************************************/
 /* PUBLIC FUNCTIONS */
 /******************************************************************************/
@@ -466,8 +1092,19 @@ VX_API_ENTRY vx_graph VX_API_CALL vxCreateGraph(vx_context c)
         graph = (vx_graph)vxCreateReference(context, VX_TYPE_GRAPH, VX_EXTERNAL, &context->base);
         if (graph && graph->base.type == VX_TYPE_GRAPH)
         {
+            vx_uint32 f;
             vxInitPerf(&graph->perf);
             vxCreateSem(&graph->lock, 1);
+            vxCreateSem(&graph->completionLock, 1);
+            vxInitEvent(&graph->completionEvent, vx_false_e);
+            vxInitEvent(&graph->scheduledEvent, vx_false_e);
+            vxInitEvent(&graph->pipelineStopped, vx_false_e);
+            vxSetEvent(&graph->pipelineStopped);
+            for (f = 0u; f < VX_INT_MAX_PIPELINE_DEPTH; f++)
+            {
+                vxInitEvent(&graph->frames[f].done, vx_false_e);
+            }
+            graph->pipelineDepth = 1u;
             VX_PRINT(VX_ZONE_GRAPH,"Created Graph %p\n", graph);
             vxPrintReference((vx_reference_t *)graph);
         }
@@ -480,8 +1117,43 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetGraphAttribute(vx_graph graph, vx_enum a
     vx_status status = VX_SUCCESS;
     if (vxIsValidSpecificReference(&graph->base, VX_TYPE_GRAPH) == vx_true_e)
     {
-        /*! \todo there are no settable attributes in this implementation yet... */
-        status = VX_ERROR_NOT_SUPPORTED;
+        switch (attribute)
+        {
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+            case VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3))
+                {
+                    vx_uint32 depth = *(vx_uint32 *)ptr;
+                    if ((depth == 0u) || (depth > VX_INT_MAX_PIPELINE_DEPTH))
+                    {
+                        status = VX_ERROR_INVALID_VALUE;
+                    }
+                    else
+                    {
+                        vxSemWait(&graph->completionLock);
+                        if ((graph->numFrames > 0u) || (graph->pipelineActive == vx_true_e))
+                        {
+                            status = VX_ERROR_GRAPH_SCHEDULED;
+                        }
+                        else if (depth != graph->pipelineDepth)
+                        {
+                            graph->pipelineDepth = depth;
+                            graph->verified = vx_false_e;
+                        }
+                        vxSemPost(&graph->completionLock);
+                    }
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+#endif
+            default:
+                /*! \todo there are few settable attributes in this implementation yet... */
+                status = VX_ERROR_NOT_SUPPORTED;
+                break;
+        }
     }
     else
     {
@@ -540,6 +1212,40 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribut
                     status = VX_ERROR_INVALID_PARAMETERS;
                 }
                 break;
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+            case VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH:
+                if (VX_CHECK_PARAM(ptr, size, vx_uint32, 0x3))
+                {
+                    *(vx_uint32 *)ptr = graph->pipelineDepth;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+#endif
+#if defined(EXPERIMENTAL_USE_MEMORY_PLAN)
+            case VX_GRAPH_ATTRIBUTE_PLANNED_MEMORY:
+                if (VX_CHECK_PARAM(ptr, size, vx_size, 0x3))
+                {
+                    *(vx_size *)ptr = graph->plannedBytes;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+            case VX_GRAPH_ATTRIBUTE_NAIVE_MEMORY:
+                if (VX_CHECK_PARAM(ptr, size, vx_size, 0x3))
+                {
+                    *(vx_size *)ptr = graph->naiveBytes;
+                }
+                else
+                {
+                    status = VX_ERROR_INVALID_PARAMETERS;
+                }
+                break;
+#endif
             default:
                 status = VX_ERROR_NOT_SUPPORTED;
                 break;
@@ -555,6 +1261,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribut
 void vxDestructGraph(vx_reference ref)
 {
     vx_graph graph = (vx_graph)ref;
+    vx_uint32 f;
     while (graph->numNodes)
     {
         vx_node node = (vx_node)graph->nodes[0];
@@ -567,8 +1274,23 @@ void vxDestructGraph(vx_reference ref)
         }
         vxRemoveNodeInt(&graph->nodes[0]);
     }
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+    vxReleasePipeline(graph);
+#endif
+    vxReleaseMemoryPlan(graph);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    vxReleaseGraphHandles(&graph->held);
+#endif
     // execution lock?
     vxDestroySem(&graph->lock);
+    vxDestroySem(&graph->completionLock);
+    vxDeinitEvent(&graph->completionEvent);
+    vxDeinitEvent(&graph->scheduledEvent);
+    vxDeinitEvent(&graph->pipelineStopped);
+    for (f = 0u; f < VX_INT_MAX_PIPELINE_DEPTH; f++)
+    {
+        vxDeinitEvent(&graph->frames[f].done);
+    }
 }
 
 VX_API_ENTRY vx_status VX_API_CALL vxReleaseGraph(vx_graph *g)
@@ -924,10 +1646,148 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
             }
         }
 
+        VX_PRINT(VX_ZONE_GRAPH,"#################################\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Dependency Determination Phase! (%d)\n", status);
+        VX_PRINT(VX_ZONE_GRAPH,"#################################\n");
+
+        memset(graph->heads, 0, sizeof(graph->heads));
+        graph->numHeads = 0;
+
+        for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
+        {
+            vx_node_t *node = graph->nodes[n];
+            if (node->successors)
+                free(node->successors);
+            /* a node can't have more successors than there are other nodes */
+            node->successors = (vx_uint32 *)calloc(graph->numNodes, sizeof(vx_uint32));
+            node->numSuccessors = 0;
+            node->numPredecessors = 0;
+            if (node->successors == NULL)
+            {
+                status = VX_ERROR_NO_MEMORY;
+                vxAddLogEntry(&graph->base, status, "Failed to allocate the successor list of node[%u] %s\n", n, node->kernel->name);
+            }
+        }
+
+        /* an edge exists from n1 to n if n1 writes to anything that n reads. The
+         * edges are computed once here so that execution never has to rescan the
+         * parameters of the graph.
+         */
+        for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
+        {
+            uint32_t n1,p1;
+
+            /* ring loop over the node array, checking every node but this nth node. */
+            for (n1 = vxNextNode(graph, n); n1 != n; n1 = vxNextNode(graph, n1))
+            {
+                vx_bool isAPredecessor = vx_false_e;
+
+                for (p = 0; p < graph->nodes[n]->kernel->signature.num_parameters && isAPredecessor == vx_false_e; p++)
+                {
+                    if ((graph->nodes[n]->kernel->signature.directions[p] != VX_INPUT) ||
+                        (graph->nodes[n]->parameters[p] == NULL))
+                        continue;
+
+                    for (p1 = 0; p1 < graph->nodes[n1]->kernel->signature.num_parameters && isAPredecessor == vx_false_e; p1++)
+                    {
+                        if (graph->nodes[n1]->kernel->signature.directions[p1] != VX_INPUT)
+                        {
+                            VX_PRINT(VX_ZONE_GRAPH,"Checking input nodes[%u].parameter[%u] to nodes[%u].parameters[%u]\n", n, p, n1, p1);
+                            /* if the parameter is referenced elsewhere */
+                            if (vxCheckWriteDependency(graph->nodes[n]->parameters[p], graph->nodes[n1]->parameters[p1]))
+                            {
+                                VX_PRINT(VX_ZONE_GRAPH,"\tnodes[%u].parameter[%u] referenced in nodes[%u].parameter[%u]\n", n,p,n1,p1);
+                                isAPredecessor = vx_true_e; /* this will cause the parameter loops to break too. */
+                            }
+                        }
+                    }
+                }
+
+                if (isAPredecessor == vx_true_e)
+                {
+                    graph->nodes[n1]->successors[graph->nodes[n1]->numSuccessors++] = n;
+                    graph->nodes[n]->numPredecessors++;
+                }
+            }
+
+            /* nodes with no predecessor go in the head list */
+            if (graph->nodes[n]->numPredecessors == 0)
+            {
+                VX_PRINT(VX_ZONE_GRAPH,"Found a head in node[%u] => %s\n", n, graph->nodes[n]->kernel->name);
+                graph->heads[graph->numHeads++] = n;
+            }
+        }
+
+        /* graph has a cycle as there are no starting points! */
+        if ((graph->numHeads == 0) && (status == VX_SUCCESS))
+        {
+            status = VX_ERROR_INVALID_GRAPH;
+            VX_PRINT(VX_ZONE_ERROR,"Graph has no heads!\n");
+            vxAddLogEntry(&graph->base, status, "Cycle: Graph has no head nodes!\n");
+        }
+
+        VX_PRINT(VX_ZONE_GRAPH,"##############\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Cycle Checking (%d)\n", status);
+        VX_PRINT(VX_ZONE_GRAPH,"##############\n");
+
+        vxClearVisitation(graph);
+
+        /* cycle checking by traversal of the graph from heads to tails */
+        for (h = 0; h < graph->numHeads; h++)
+        {
+            vx_status cycle_status = vxTraverseGraph(graph, VX_INT_MAX_NODES, graph->heads[h]);
+            if (cycle_status != VX_SUCCESS)
+            {
+                status = cycle_status;
+                VX_PRINT(VX_ZONE_ERROR,"Cycle found in graph!");
+                vxAddLogEntry(&graph->base, status, "Cycle: Graph has a cycle!\n");
+                goto exit;
+            }
+        }
+
+        VX_PRINT(VX_ZONE_GRAPH,"############################\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Checking for Unvisited Nodes (%d)\n", status);
+        VX_PRINT(VX_ZONE_GRAPH,"############################\n");
+
+        for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
+        {
+            if (graph->nodes[n]->visited == vx_false_e)
+            {
+                VX_PRINT(VX_ZONE_ERROR, "UNVISITED: %s node[%u]\n", graph->nodes[n]->kernel->name, n);
+                status = VX_ERROR_INVALID_GRAPH;
+                vxAddLogEntry(&graph->base, status, "Node %s: unvisited!\n", graph->nodes[n]->kernel->name);
+            }
+        }
+
+        vxClearVisitation(graph);
+
+        if (hasACycle == vx_true_e)
+        {
+            status = VX_ERROR_INVALID_GRAPH;
+            vxAddLogEntry(&graph->base, status, "Cycle: Graph has a cycle!\n");
+            goto exit;
+        }
+
+#ifdef OPENVX_KHR_TILING
+        VX_PRINT(VX_ZONE_GRAPH,"#################\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Tile Fusion Phase (%d)\n", status);
+        VX_PRINT(VX_ZONE_GRAPH,"#################\n");
+
+        if (status == VX_SUCCESS)
+        {
+            status = vxLinkTileChains(graph);
+        }
+
+#endif
         VX_PRINT(VX_ZONE_GRAPH,"########################\n");
         VX_PRINT(VX_ZONE_GRAPH,"Memory Allocation Phase! (%d)\n", status);
         VX_PRINT(VX_ZONE_GRAPH,"########################\n");
 
+        if (status == VX_SUCCESS)
+        {
+            status = vxPlanGraphMemory(graph);
+        }
+
         /* now make sure each parameter is backed by memory. */
         for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
         {
@@ -1016,102 +1876,20 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
             }
         }
 
-        VX_PRINT(VX_ZONE_GRAPH,"###############################\n");
-        VX_PRINT(VX_ZONE_GRAPH,"Head Nodes Determination Phase! (%d)\n", status);
-        VX_PRINT(VX_ZONE_GRAPH,"###############################\n");
-
-        memset(graph->heads, 0, sizeof(graph->heads));
-        graph->numHeads = 0;
-
-        /* now traverse the graph and put nodes with no predecessor in the head list */
-        for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
-        {
-            uint32_t n1,p1;
-            vx_bool isAHead = vx_true_e; /* assume every node is a head until proven otherwise */
-
-            for (p = 0; p < graph->nodes[n]->kernel->signature.num_parameters && isAHead == vx_true_e; p++)
-            {
-                if ((graph->nodes[n]->kernel->signature.directions[p] == VX_INPUT) &&
-                    (graph->nodes[n]->parameters[p] != NULL))
-                {
-                    /* ring loop over the node array, checking every node but this nth node. */
-                    for (n1 = vxNextNode(graph, n);
-                         (n1 != n) && (isAHead == vx_true_e);
-                         n1 = vxNextNode(graph, n1))
-                    {
-                        for (p1 = 0; p1 < graph->nodes[n1]->kernel->signature.num_parameters && isAHead == vx_true_e; p1++)
-                        {
-                            if (graph->nodes[n1]->kernel->signature.directions[p1] != VX_INPUT)
-                            {
-                                VX_PRINT(VX_ZONE_GRAPH,"Checking input nodes[%u].parameter[%u] to nodes[%u].parameters[%u]\n", n, p, n1, p1);
-                                /* if the parameter is referenced elsewhere */
-                                if (vxCheckWriteDependency(graph->nodes[n]->parameters[p], graph->nodes[n1]->parameters[p1]))
-                                {
-                                    VX_PRINT(VX_ZONE_GRAPH,"\tnodes[%u].parameter[%u] referenced in nodes[%u].parameter[%u]\n", n,p,n1,p1);
-                                    isAHead = vx_false_e; /* this will cause all the loops to break too. */
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-
-            if (isAHead == vx_true_e)
-            {
-                VX_PRINT(VX_ZONE_GRAPH,"Found a head in node[%u] => %s\n", n, graph->nodes[n]->kernel->name);
-                graph->heads[graph->numHeads++] = n;
-            }
-        }
-
-        /* graph has a cycle as there are no starting points! */
-        if ((graph->numHeads == 0) && (status == VX_SUCCESS))
-        {
-            status = VX_ERROR_INVALID_GRAPH;
-            VX_PRINT(VX_ZONE_ERROR,"Graph has no heads!\n");
-            vxAddLogEntry(&graph->base, status, "Cycle: Graph has no head nodes!\n");
-        }
-
-        VX_PRINT(VX_ZONE_GRAPH,"##############\n");
-        VX_PRINT(VX_ZONE_GRAPH,"Cycle Checking (%d)\n", status);
-        VX_PRINT(VX_ZONE_GRAPH,"##############\n");
-
-        vxClearVisitation(graph);
-
-        /* cycle checking by traversal of the graph from heads to tails */
-        for (h = 0; h < graph->numHeads; h++)
-        {
-            vx_status cycle_status = vxTraverseGraph(graph, VX_INT_MAX_NODES, graph->heads[h]);
-            if (cycle_status != VX_SUCCESS)
-            {
-                status = cycle_status;
-                VX_PRINT(VX_ZONE_ERROR,"Cycle found in graph!");
-                vxAddLogEntry(&graph->base, status, "Cycle: Graph has a cycle!\n");
-                goto exit;
-            }
-        }
-
-        VX_PRINT(VX_ZONE_GRAPH,"############################\n");
-        VX_PRINT(VX_ZONE_GRAPH,"Checking for Unvisited Nodes (%d)\n", status);
-        VX_PRINT(VX_ZONE_GRAPH,"############################\n");
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+        VX_PRINT(VX_ZONE_GRAPH,"##########################\n");
+        VX_PRINT(VX_ZONE_GRAPH,"Pipeline Preparation Phase (%d)\n", status);
+        VX_PRINT(VX_ZONE_GRAPH,"##########################\n");
 
-        for (n = 0; (n < graph->numNodes) && (status == VX_SUCCESS); n++)
+        if (status == VX_SUCCESS)
         {
-            if (graph->nodes[n]->visited == vx_false_e)
+            status = vxPreparePipeline(graph);
+            if (status != VX_SUCCESS)
             {
-                VX_PRINT(VX_ZONE_ERROR, "UNVISITED: %s node[%u]\n", graph->nodes[n]->kernel->name, n);
-                status = VX_ERROR_INVALID_GRAPH;
-                vxAddLogEntry(&graph->base, status, "Node %s: unvisited!\n", graph->nodes[n]->kernel->name);
+                VX_PRINT(VX_ZONE_ERROR, "Failed to prepare the pipeline of depth %u\n", graph->pipelineDepth);
             }
         }
-
-        vxClearVisitation(graph);
-
-        if (hasACycle == vx_true_e)
-        {
-            status = VX_ERROR_INVALID_GRAPH;
-            vxAddLogEntry(&graph->base, status, "Cycle: Graph has a cycle!\n");
-            goto exit;
-        }
+#endif
 
         VX_PRINT(VX_ZONE_GRAPH,"#########################\n");
         VX_PRINT(VX_ZONE_GRAPH,"Target Verification Phase (%d)\n", status);
@@ -1229,186 +2007,795 @@ exit:
     }
     else
     {
-        status = VX_ERROR_INVALID_REFERENCE;
+        status = VX_ERROR_INVALID_REFERENCE;
+    }
+    VX_PRINT(VX_ZONE_GRAPH,"Returning status %d\n", status);
+
+    return status;
+}
+
+void vxPostNodeCompletion(vx_graph graph, vx_value_set_t *work)
+{
+    vxSemWait(&graph->completionLock);
+    graph->completed[graph->numCompleted++] = work;
+    vxSetEvent(&graph->completionEvent);
+    vxSemPost(&graph->completionLock);
+}
+
+/*! \brief Blocks until at least one node has completed on the threadpool, then
+ * moves the completed work items into the caller's list.
+ */
+static vx_uint32 vxCollectNodeCompletions(vx_graph graph, vx_value_set_t *completed[VX_INT_MAX_REF])
+{
+    vx_uint32 numCompleted = 0u;
+    do {
+        vxSemWait(&graph->completionLock);
+        numCompleted = graph->numCompleted;
+        memcpy(completed, graph->completed, numCompleted * sizeof(vx_value_set_t *));
+        graph->numCompleted = 0u;
+        /* only reset under the lock when empty, so that a set can't be lost */
+        if (numCompleted == 0u)
+            vxResetEvent(&graph->completionEvent);
+        vxSemPost(&graph->completionLock);
+        if (numCompleted == 0u)
+            vxWaitEvent(&graph->completionEvent, VX_INT_FOREVER);
+    } while (numCompleted == 0u);
+    return numCompleted;
+}
+
+/*! \brief Decrements the pending count of each successor of a retired node and
+ * appends the ones which have no more pending predecessors to the ready list.
+ */
+static void vxReleaseSuccessors(vx_graph graph, vx_uint32 index, vx_uint32 ready[VX_INT_MAX_REF], vx_uint32 *numReady)
+{
+    vx_uint32 s;
+    vx_node_t *node = graph->nodes[index];
+    for (s = 0u; s < node->numSuccessors; s++)
+    {
+        vx_node_t *next = graph->nodes[node->successors[s]];
+        if (--next->numPending == 0u)
+        {
+            VX_PRINT(VX_ZONE_GRAPH, "ready: node[%u] = %s\n", node->successors[s], next->kernel->name);
+            ready[(*numReady)++] = node->successors[s];
+        }
+    }
+}
+
+/*! \brief The number of graphs the calling thread is executing, graphs on other threads don't nest. */
+static VX_THREAD_LOCAL vx_uint32 executing = 0u;
+
+vx_bool vxIsExecutingGraph(vx_context_t *context)
+{
+    if ((executing > 0u) || (vxIsThreadpoolWorker(context->workers) == vx_true_e))
+        return vx_true_e;
+    else
+        return vx_false_e;
+}
+
+/*! \brief Determines if the application holds an access to an image parameter
+ * of a node which the node would wait for. The application may be waiting for
+ * the graph itself, so such a graph fails instead of executing.
+ * \param [in] node The node.
+ * \param [in] parameters The references which replace the node's own for one
+ * execution where they are set, or NULL.
+ */
+static vx_bool vxIsNodeHeldByApplication(vx_node_t *node, vx_reference parameters[])
+{
+    vx_uint32 p;
+    for (p = 0u; p < node->kernel->signature.num_parameters; p++)
+    {
+        vx_reference ref = ((parameters && parameters[p]) ? parameters[p] : node->parameters[p]);
+        vx_enum usage = (node->kernel->signature.directions[p] == VX_INPUT ? VX_READ_ONLY : VX_READ_AND_WRITE);
+        if (ref && (ref->type == VX_TYPE_IMAGE) &&
+            (vxIsImageHeldByApplication((vx_image)ref, usage) == vx_true_e))
+            return vx_true_e;
+    }
+    return vx_false_e;
+}
+
+/*! \brief Executes a node on the calling thread. */
+static vx_action vxExecuteNodeInline(vx_graph graph, vx_uint32 n)
+{
+    vx_action action = VX_ACTION_CONTINUE;
+    vx_node_t *node = graph->nodes[n];
+    vx_target_t *target = &graph->base.context->targets[node->affinity];
+    vx_uint32 p;
+
+    /* turn on access to virtual memory */
+    for (p = 0u; p < node->kernel->signature.num_parameters; p++) {
+        if (node->parameters[p] == NULL) continue;
+        if (node->parameters[p]->is_virtual == vx_true_e) {
+            node->parameters[p]->is_accessible = vx_true_e;
+        }
+    }
+
+    VX_PRINT(VX_ZONE_GRAPH, "Calling Node[%u] %s:%s\n",
+             n, target->name, node->kernel->name);
+
+    action = target->funcs.process(target, &node, 0, 1);
+
+    VX_PRINT(VX_ZONE_GRAPH, "Returned Node[%u] %s:%s Action %d\n",
+             n, target->name, node->kernel->name, action);
+
+    /* turn off access to virtual memory */
+    for (p = 0u; p < node->kernel->signature.num_parameters; p++) {
+        if (node->parameters[p] == NULL) continue;
+        if (node->parameters[p]->is_virtual == vx_true_e) {
+            node->parameters[p]->is_accessible = vx_false_e;
+        }
+    }
+    return action;
+}
+
+static vx_status vxExecuteGraph(vx_graph graph, vx_uint32 depth)
+{
+    vx_status status = VX_SUCCESS;
+    vx_action action = VX_ACTION_CONTINUE;
+    vx_uint32 n, numReady, nextReady, numRetired;
+    vx_uint32 ready[VX_INT_MAX_REF];
+#if defined(OPENVX_USE_SMP)
+    vx_bool parallel = vx_false_e;
+    vx_uint32 c, numIssued, numCompleted;
+    vx_value_set_t workitems[VX_INT_MAX_REF];
+    vx_value_set_t *completed[VX_INT_MAX_REF];
+#endif
+    if (vxIsValidReference(&graph->base) == vx_false_e)
+    {
+        return VX_ERROR_INVALID_REFERENCE;
+    }
+    if (graph->verified == vx_false_e)
+    {
+        status = vxVerifyGraph((vx_graph)graph);
+        if (status != VX_SUCCESS)
+        {
+            return status;
+        }
+    }
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        if (vxIsNodeHeldByApplication(graph->nodes[n], NULL) == vx_true_e)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Node[%u] %s uses an image the application is accessing!\n", n, graph->nodes[n]->kernel->name);
+            vxAddLogEntry(&graph->base, VX_ERROR_NO_RESOURCES, "Node[%u] %s uses an image the application is accessing!\n", n, graph->nodes[n]->kernel->name);
+            return VX_ERROR_NO_RESOURCES;
+        }
+    }
+#if defined(OPENVX_USE_SMP)
+    /* child graphs executed by a node on a worker must not wait on the workers */
+    if (depth == 1 && graph->should_serialize == vx_false_e &&
+        vxIsThreadpoolWorker(graph->base.context->workers) == vx_false_e)
+    {
+        parallel = vx_true_e;
+    }
+#endif
+restart:
+    VX_PRINT(VX_ZONE_GRAPH,"************************\n");
+    VX_PRINT(VX_ZONE_GRAPH,"*** PROCESSING GRAPH ***\n");
+    VX_PRINT(VX_ZONE_GRAPH,"************************\n");
+
+    vxClearVisitation(graph);
+    vxClearExecution(graph);
+    vxStartCapture(&graph->perf);
+
+    /* every node waits on all of its predecessors, the heads are ready now */
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        graph->nodes[n]->numPending = graph->nodes[n]->numPredecessors;
+    }
+    memcpy(ready, graph->heads, graph->numHeads * sizeof(vx_uint32));
+    numReady = graph->numHeads;
+    nextReady = 0u;
+    numRetired = 0u;
+    action = VX_ACTION_CONTINUE;
+#if defined(OPENVX_USE_SMP)
+    numIssued = 0u;
+    graph->numCompleted = 0u;
+    vxResetEvent(&graph->completionEvent);
+#endif
+
+    while (numRetired < graph->numNodes)
+    {
+#if defined(OPENVX_USE_SMP)
+        if (parallel == vx_true_e)
+        {
+            /* dispatch everything which became ready since the last completion */
+            for (; (nextReady < numReady) && (action == VX_ACTION_CONTINUE); nextReady++)
+            {
+                vx_node_t *node = graph->nodes[ready[nextReady]];
+                vx_value_set_t *work = &workitems[ready[nextReady]];
+                vx_target target = &graph->base.context->targets[node->affinity];
+                vxPrintNode(node);
+                work->v1 = (vx_value_t)target;
+                work->v2 = (vx_value_t)node;
+                work->v3 = (vx_value_t)VX_ACTION_CONTINUE;
+                VX_PRINT(VX_ZONE_GRAPH, "Scheduling work on %s for %s\n", target->name, node->kernel->name);
+                if (vxIssueThreadpool(graph->base.context->workers, work, 1) == vx_true_e)
+                {
+                    numIssued++;
+                }
+                else if (numIssued > numRetired)
+                {
+                    /* the queues are full, retry once something completes */
+                    VX_PRINT(VX_ZONE_GRAPH, "Threadpool full, deferring node[%u] %s\n", ready[nextReady], node->kernel->name);
+                    break;
+                }
+                else
+                {
+                    VX_PRINT(VX_ZONE_ERROR, "Failed to issue node[%u] %s!\n", ready[nextReady], node->kernel->name);
+                    action = VX_ACTION_ABANDON;
+                }
+            }
+
+            /* nothing in flight means nothing will ever become ready */
+            if (numIssued == numRetired)
+            {
+                break;
+            }
+
+            numCompleted = vxCollectNodeCompletions(graph, completed);
+            for (c = 0u; c < numCompleted; c++)
+            {
+                vx_action a = (vx_action)completed[c]->v3;
+                n = (vx_uint32)(completed[c] - workitems);
+                numRetired++;
+                VX_PRINT(VX_ZONE_GRAPH, "Retired node[%u] %s with action %d\n", n, graph->nodes[n]->kernel->name, a);
+                if (a != VX_ACTION_CONTINUE)
+                {
+                    VX_PRINT(VX_ZONE_WARNING, "Workitem[%u] returned action code %d\n", n, a);
+                    /* let the in-flight nodes drain, but issue nothing new */
+                    if (action == VX_ACTION_CONTINUE)
+                        action = a;
+                }
+                else if (action == VX_ACTION_CONTINUE)
+                {
+                    vxReleaseSuccessors(graph, n, ready, &numReady);
+                }
+            }
+        }
+        else
+#endif
+        {
+            vx_node_t *node = NULL;
+
+            if ((action != VX_ACTION_CONTINUE) || (nextReady == numReady))
+            {
+                break;
+            }
+
+            n = ready[nextReady++];
+            node = graph->nodes[n];
+            vxPrintNode(node);
+
+            if (node->executed == vx_true_e)
+            {
+                VX_PRINT(VX_ZONE_ERROR, "Multiple executions attempted!\n");
+                break;
+            }
+
+            action = vxExecuteNodeInline(graph, n);
+
+            numRetired++;
+            if (action == VX_ACTION_CONTINUE)
+            {
+                vxReleaseSuccessors(graph, n, ready, &numReady);
+            }
+        }
+    }
+
+    if (action == VX_ACTION_RESTART)
+    {
+        goto restart;
+    }
+    if (action == VX_ACTION_ABANDON)
+    {
+        status = VX_ERROR_GRAPH_ABANDONED;
+    }
+    vxStopCapture(&graph->perf);
+    vxClearVisitation(graph);
+
+    VX_PRINT(VX_ZONE_GRAPH,"Process returned status %d\n", status);
+    for (n = 0; n < graph->numNodes; n++)
+    {
+        VX_PRINT(VX_ZONE_PERF,"nodes[%u] %s[%d] last:"VX_FMT_TIME"ms avg:"VX_FMT_TIME"ms min:"VX_FMT_TIME"ms\n",
+                 n,
+                 graph->nodes[n]->kernel->name,
+                 graph->nodes[n]->kernel->enumeration,
+                 vxTimeToMS(graph->nodes[n]->perf.tmp),
+                 vxTimeToMS(graph->nodes[n]->perf.avg),
+                 vxTimeToMS(graph->nodes[n]->perf.min));
+    }
+    return status;
+}
+
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+/*! \brief Determines if a node may execute for a pipelined frame. Besides its
+ * own predecessors in the frame, the node has to have retired the previous
+ * frame, and if it overwrites an object shared by all frames, the consumers of
+ * that object have to be done with the previous frame too.
+ */
+static vx_bool vxIsFrameNodeReady(vx_graph graph, vx_graph_frame_t *frame, vx_uint32 n)
+{
+    vx_node_t *node = graph->nodes[n];
+    vx_uint32 s;
+    if ((frame->nodes[n].state != VX_FRAME_NODE_WAITING) ||
+        (frame->nodes[n].numPending > 0u) ||
+        (node->inFlight == vx_true_e) ||
+        (node->lastFrame + 1u != frame->sequence))
+        return vx_false_e;
+    if (node->writesShared == vx_true_e)
+    {
+        for (s = 0u; s < node->numSuccessors; s++)
+        {
+            if (graph->nodes[node->successors[s]]->lastFrame + 1u < frame->sequence)
+                return vx_false_e;
+        }
     }
-    VX_PRINT(VX_ZONE_GRAPH,"Returning status %d\n", status);
+    return vx_true_e;
+}
 
+/*! \brief Binds the references of a frame to a node before it executes. */
+static vx_status vxBindFrameNode(vx_graph graph, vx_graph_frame_t *frame, vx_uint32 n)
+{
+    vx_status status = VX_SUCCESS;
+    vx_node_t *node = graph->nodes[n];
+    vx_uint32 p;
+    for (p = 0u; (p < node->kernel->signature.num_parameters) && (status == VX_SUCCESS); p++)
+    {
+        vx_reference ref = frame->nodes[n].parameters[p];
+        if (ref && (ref != node->parameters[p]))
+        {
+            status = vxSetParameterByIndex((vx_node)node, p, ref);
+        }
+    }
     return status;
 }
 
-static vx_status vxExecuteGraph(vx_graph graph, vx_uint32 depth)
+/*! \brief Retires a node of a pipelined frame and releases its successors in that frame. */
+static void vxRetireFrameNode(vx_graph graph, vx_graph_frame_t *frame, vx_uint32 n, vx_action action)
 {
-    vx_status status = VX_SUCCESS;
-    vx_action action = VX_ACTION_CONTINUE;
-    vx_uint32 n, p, numLast, numNext, numLeft = 0;
-    vx_uint32 last_nodes[VX_INT_MAX_REF];
-    vx_uint32 next_nodes[VX_INT_MAX_REF];
-    vx_uint32 left_nodes[VX_INT_MAX_REF];
-#if defined(OPENVX_USE_SMP)
-    vx_value_set_t workitems[VX_INT_MAX_REF];
-#endif
-    if (vxIsValidReference(&graph->base) == vx_false_e)
+    vx_node_t *node = graph->nodes[n];
+    vx_uint32 s;
+    frame->nodes[n].state = VX_FRAME_NODE_RETIRED;
+    frame->numRetired++;
+    node->inFlight = vx_false_e;
+    node->lastFrame = frame->sequence;
+    VX_PRINT(VX_ZONE_GRAPH, "Retired frame %u node[%u] %s with action %d\n", frame->sequence, n, node->kernel->name, action);
+    if (action != VX_ACTION_CONTINUE)
     {
-        return VX_ERROR_INVALID_REFERENCE;
+        /* a restart can't be honored once later frames are in the pipeline */
+        VX_PRINT(VX_ZONE_WARNING, "Frame %u node[%u] returned action code %d\n", frame->sequence, n, action);
+        if (frame->action == VX_ACTION_CONTINUE)
+            frame->action = VX_ACTION_ABANDON;
     }
-    if (graph->verified == vx_false_e)
+    else if (frame->action == VX_ACTION_CONTINUE)
     {
-        status = vxVerifyGraph((vx_graph)graph);
-        if (status != VX_SUCCESS)
+        for (s = 0u; s < node->numSuccessors; s++)
         {
-            return status;
+            frame->nodes[node->successors[s]].numPending--;
         }
     }
-restart:
-    VX_PRINT(VX_ZONE_GRAPH,"************************\n");
-    VX_PRINT(VX_ZONE_GRAPH,"*** PROCESSING GRAPH ***\n");
-    VX_PRINT(VX_ZONE_GRAPH,"************************\n");
+}
 
-    vxClearVisitation(graph);
-    vxClearExecution(graph);
-    vxStartCapture(&graph->perf);
-    /* initialize the next_nodes as the graph heads */
-    memcpy(next_nodes, graph->heads, graph->numHeads * sizeof(vx_uint32));
-    numNext = graph->numHeads;
+/*! \brief Issues (or executes, in serial mode) every node of the started frames
+ * which is ready, oldest frame first.
+ * \return The number of nodes which were issued.
+ */
+static vx_uint32 vxIssueFrameNodes(vx_graph graph, vx_graph_frame_t *frames[], vx_uint32 numFrames, vx_bool parallel)
+{
+    vx_uint32 f, n, numIssued = 0u, numInFlight = 0u;
+    vx_bool progress = vx_true_e;
 
-    do {
-        for (n = 0; n < numNext; n++)
-        {
-            vxPrintNode(graph->nodes[next_nodes[n]]);
-        }
+    for (f = 0u; f < numFrames; f++)
+        numInFlight += frames[f]->numIssued - frames[f]->numRetired;
 
-        /* execute the next nodes */
-        for (n = 0; n < numNext; n++)
+    while (progress == vx_true_e)
+    {
+        progress = vx_false_e;
+        for (f = 0u; f < numFrames; f++)
         {
-            if (graph->nodes[next_nodes[n]]->executed == vx_false_e)
+            vx_graph_frame_t *frame = frames[f];
+            for (n = 0u; (n < graph->numNodes) && (frame->action == VX_ACTION_CONTINUE); n++)
             {
-                vx_uint32 t = graph->nodes[next_nodes[n]]->affinity;
-#if defined(OPENVX_USE_SMP)
-                if (depth == 1 && graph->should_serialize == vx_false_e)
+                vx_node_t *node = graph->nodes[n];
+                vx_frame_node_t *fn = &frame->nodes[n];
+
+                if (vxIsFrameNodeReady(graph, frame, n) == vx_false_e)
+                    continue;
+
+                if (vxBindFrameNode(graph, frame, n) != VX_SUCCESS)
                 {
-                    vx_value_set_t *work = &workitems[n];
-                    vx_target target = &graph->base.context->targets[t];
-                    vx_node node = graph->nodes[next_nodes[n]];
-                    work->v1 = (vx_value_t)target;
-                    work->v2 = (vx_value_t)node;
-                    work->v3 = (vx_value_t)VX_ACTION_CONTINUE;
-                    VX_PRINT(VX_ZONE_GRAPH, "Scheduling work on %s for %s\n", target->name, node->kernel->name);
+                    VX_PRINT(VX_ZONE_ERROR, "Failed to bind frame %u to node[%u] %s!\n", frame->sequence, n, node->kernel->name);
+                    frame->action = VX_ACTION_ABANDON;
+                    break;
                 }
-                else
-#endif
+                vxPrintNode(node);
+                node->executed = vx_false_e;
+                fn->state = VX_FRAME_NODE_ISSUED;
+                frame->numIssued++;
+#if defined(OPENVX_USE_SMP)
+                if (parallel == vx_true_e)
                 {
-                    vx_target_t *target = &graph->base.context->targets[t];
-                    vx_node_t *node = graph->nodes[next_nodes[n]];
-
-                    /* turn on access to virtual memory */
-                    for (p = 0u; p < node->kernel->signature.num_parameters; p++) {
-                        if (node->parameters[p] == NULL) continue;
-                        if (node->parameters[p]->is_virtual == vx_true_e) {
-                            node->parameters[p]->is_accessible = vx_true_e;
-                        }
-                    }
-
-                    VX_PRINT(VX_ZONE_GRAPH, "Calling Node[%u] %s:%s\n",
-                             next_nodes[n],
-                             target->name, node->kernel->name);
-
-                    action = target->funcs.process(target, &node, 0, 1);
-
-                    VX_PRINT(VX_ZONE_GRAPH, "Returned Node[%u] %s:%s Action %d\n",
-                             next_nodes[n],
-                             target->name, node->kernel->name,
-                             action);
-
-                    /* turn off access to virtual memory */
-                    for (p = 0u; p < node->kernel->signature.num_parameters; p++) {
-                        if (node->parameters[p] == NULL) continue;
-                        if (node->parameters[p]->is_virtual == vx_true_e) {
-                            node->parameters[p]->is_accessible = vx_false_e;
-                        }
+                    vx_target target = &graph->base.context->targets[node->affinity];
+                    fn->work.v1 = (vx_value_t)target;
+                    fn->work.v2 = (vx_value_t)node;
+                    fn->work.v3 = (vx_value_t)VX_ACTION_CONTINUE;
+                    node->inFlight = vx_true_e;
+                    VX_PRINT(VX_ZONE_GRAPH, "Scheduling frame %u work on %s for %s\n", frame->sequence, target->name, node->kernel->name);
+                    if (vxIssueThreadpool(graph->base.context->workers, &fn->work, 1) == vx_true_e)
+                    {
+                        numInFlight++;
+                        numIssued++;
+                        continue;
                     }
-
-                    if ((action == VX_ACTION_ABANDON) ||
-                        (action == VX_ACTION_RESTART))
+                    node->inFlight = vx_false_e;
+                    fn->state = VX_FRAME_NODE_WAITING;
+                    frame->numIssued--;
+                    if (numInFlight > 0u)
                     {
-                        break;
+                        /* the queues are full, retry once something completes */
+                        VX_PRINT(VX_ZONE_GRAPH, "Threadpool full, deferring frame %u node[%u] %s\n", frame->sequence, n, node->kernel->name);
+                        return numIssued;
                     }
+                    VX_PRINT(VX_ZONE_ERROR, "Failed to issue frame %u node[%u] %s!\n", frame->sequence, n, node->kernel->name);
+                    frame->action = VX_ACTION_ABANDON;
+                    break;
                 }
+#endif
+                numIssued++;
+                vxRetireFrameNode(graph, frame, n, vxExecuteNodeInline(graph, n));
+                progress = vx_true_e;
             }
-            else
+        }
+    }
+    return numIssued;
+}
+#endif
+
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+vx_status vxHoldGraphHandles(vx_graph graph, vx_graph_frame_t *frame, vx_image **held)
+{
+    vx_uint32 n, p, h, count = 0u;
+
+    *held = NULL;
+    for (n = 0u; n < graph->numNodes; n++)
+    {
+        vx_node_t *node = graph->nodes[n];
+        for (p = 0u; p < node->kernel->signature.num_parameters; p++)
+        {
+            vx_reference ref = (frame ? frame->nodes[n].parameters[p] : NULL);
+            if (vxLocateImageHandle(ref ? ref : node->parameters[p]))
+                count++;
+        }
+    }
+    if (count == 0u)
+        return VX_SUCCESS;
+    *held = (vx_image *)calloc(count + 1u, sizeof(vx_image));
+    if (*held == NULL)
+        return VX_ERROR_NO_MEMORY;
+    for (n = 0u, h = 0u; n < graph->numNodes; n++)
+    {
+        vx_node_t *node = graph->nodes[n];
+        for (p = 0u; p < node->kernel->signature.num_parameters; p++)
+        {
+            vx_reference ref = (frame ? frame->nodes[n].parameters[p] : NULL);
+            vx_image image = vxLocateImageHandle(ref ? ref : node->parameters[p]);
+            if (image)
             {
-                VX_PRINT(VX_ZONE_ERROR, "Multiple executions attempted!\n");
-                break;
+                vxHoldImageHandle(image, vx_true_e);
+                (*held)[h++] = image;
             }
         }
+    }
+    return VX_SUCCESS;
+}
+
+void vxReleaseGraphHandles(vx_image **held)
+{
+    vx_uint32 h;
+    if (*held == NULL)
+        return;
+    for (h = 0u; (*held)[h]; h++)
+        vxHoldImageHandle((*held)[h], vx_false_e);
+    free(*held);
+    *held = NULL;
+}
+#endif
+
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+void vxExecutePipeline(vx_graph graph)
+{
+    vx_bool parallel = vx_false_e;
+    vx_value_set_t *completed[VX_INT_MAX_REF];
+    vx_graph_frame_t *frames[VX_INT_MAX_PIPELINE_DEPTH];
 
 #if defined(OPENVX_USE_SMP)
-        if (depth == 1 && graph->should_serialize == vx_false_e)
+    if (graph->should_serialize == vx_false_e)
+    {
+        parallel = vx_true_e;
+    }
+#endif
+    VX_PRINT(VX_ZONE_GRAPH, "Starting the pipeline of graph "VX_FMT_REF" with depth %u\n", graph, graph->pipelineDepth);
+    executing++;
+    for (;;)
+    {
+        vx_uint32 c, f, n, i, numCompleted, numFrames = 0u, numInFlight = 0u, sequence;
+        vx_bool progress = vx_false_e;
+
+        /* start the newly scheduled frames and pick up the completed nodes */
+        vxSemWait(&graph->completionLock);
+        for (f = 0u; f < graph->numFrames; f++)
         {
-            if (vxIssueThreadpool(graph->base.context->workers, workitems, numNext) == vx_true_e)
+            vx_graph_frame_t *frame = &graph->frames[(graph->oldestFrame + f) % graph->pipelineDepth];
+            if (frame->started == vx_false_e)
             {
-                /* do a blocking complete */
-                VX_PRINT(VX_ZONE_GRAPH, "Issued %u work items!\n", numNext);
-                if (vxCompleteThreadpool(graph->base.context->workers, vx_true_e) == vx_true_e)
+                VX_PRINT(VX_ZONE_GRAPH, "Starting frame %u\n", frame->sequence);
+                for (n = 0u; n < graph->numNodes; n++)
                 {
-                    VX_PRINT(VX_ZONE_GRAPH, "Processed %u items in threadpool!\n", numNext);
+                    frame->nodes[n].numPending = graph->nodes[n]->numPredecessors;
+                    frame->nodes[n].state = VX_FRAME_NODE_WAITING;
                 }
-                action = VX_ACTION_CONTINUE;
-                for (n = 0; n < numNext; n++)
+                frame->started = vx_true_e;
+            }
+            if (frame->finished == vx_false_e)
+            {
+                frames[numFrames++] = frame;
+            }
+        }
+        numCompleted = graph->numCompleted;
+        memcpy(completed, graph->completed, numCompleted * sizeof(vx_value_set_t *));
+        graph->numCompleted = 0u;
+        sequence = graph->nextSequence;
+        if ((numFrames == 0u) && (numCompleted == 0u))
+        {
+            /* leave the nodes bound to the latest graph parameters */
+            for (i = 0u; i < graph->numParams; i++)
+            {
+                vx_node node = (vx_node)graph->parameters[i].node;
+                vx_reference ref = graph->parameters[i].ref;
+                if (node && ref && (node->parameters[graph->parameters[i].index] != ref))
+                    vxSetParameterByIndex(node, graph->parameters[i].index, ref);
+            }
+            graph->pipelineActive = vx_false_e;
+            vxSemPost(&graph->completionLock);
+            break;
+        }
+        vxSemPost(&graph->completionLock);
+
+        for (c = 0u; c < numCompleted; c++)
+        {
+            for (f = 0u; f < numFrames; f++)
+            {
+                vx_frame_node_t *fn = (vx_frame_node_t *)completed[c];
+                if ((fn >= frames[f]->nodes) && (fn < &frames[f]->nodes[graph->numNodes]))
                 {
-                    vx_action a = workitems[n].v3;
-                    if (a != VX_ACTION_CONTINUE)
-                    {
-                        action = a;
-                        VX_PRINT(VX_ZONE_WARNING, "Workitem[%u] returned action code %d\n", n, a);
-                        break;
-                    }
+                    vxRetireFrameNode(graph, frames[f], (vx_uint32)(fn - frames[f]->nodes), (vx_action)fn->work.v3);
+                    break;
                 }
             }
+            progress = vx_true_e;
+        }
+
+        if (vxIssueFrameNodes(graph, frames, numFrames, parallel) > 0u)
+        {
+            progress = vx_true_e;
         }
+
+        /* frames finish in order, so that the nodes never skip a frame */
+        for (f = 0u; f < numFrames; f++)
+        {
+            vx_graph_frame_t *frame = frames[f];
+            if ((frame->numRetired < graph->numNodes) &&
+                ((frame->action == VX_ACTION_CONTINUE) || (frame->numIssued > frame->numRetired)))
+            {
+                break;
+            }
+            for (n = 0u; n < graph->numNodes; n++)
+            {
+                if (graph->nodes[n]->lastFrame < frame->sequence)
+                    graph->nodes[n]->lastFrame = frame->sequence;
+            }
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+            vxReleaseGraphHandles(&frame->held);
 #endif
+            for (i = 0u; i < VX_INT_MAX_PARAMS; i++)
+            {
+                if (frame->parameters[i])
+                    vxReleaseReferenceInt(&frame->parameters[i], frame->parameters[i]->type, VX_INTERNAL, NULL);
+            }
+            frame->status = (frame->action == VX_ACTION_CONTINUE ? VX_SUCCESS : VX_ERROR_GRAPH_ABANDONED);
+            frame->finished = vx_true_e;
+            VX_PRINT(VX_ZONE_GRAPH, "Finished frame %u with status %d\n", frame->sequence, frame->status);
+            vxSetEvent(&frame->done);
+            progress = vx_true_e;
+        }
 
-        if ((action == VX_ACTION_ABANDON) ||
-            (action == VX_ACTION_RESTART))
+        if (progress == vx_true_e)
+            continue;
+
+        for (f = 0u; f < numFrames; f++)
+            numInFlight += frames[f]->numIssued - frames[f]->numRetired;
+        if (numInFlight == 0u)
         {
-            break;
+            /* nothing will ever complete, give up on the oldest frame */
+            VX_PRINT(VX_ZONE_ERROR, "Frame %u of graph "VX_FMT_REF" can't make progress!\n", frames[0]->sequence, graph);
+            frames[0]->action = VX_ACTION_ABANDON;
+            continue;
         }
 
-        /* copy next_nodes to last_nodes */
-        memcpy(last_nodes, next_nodes, numNext * sizeof(vx_uint32));
-        numLast = numNext;
+        vxSemWait(&graph->completionLock);
+        /* only reset under the lock when idle, so that a set can't be lost */
+        if ((graph->numCompleted == 0u) && (graph->nextSequence == sequence))
+            vxResetEvent(&graph->completionEvent);
+        vxSemPost(&graph->completionLock);
+        vxWaitEvent(&graph->completionEvent, VX_INT_FOREVER);
+    }
+    executing--;
+    VX_PRINT(VX_ZONE_GRAPH, "Stopped the pipeline of graph "VX_FMT_REF"\n", graph);
+    /* the last access to the graph, the waiter of the last frame may release it */
+    vxSetEvent(&graph->pipelineStopped);
+}
+
+/*! \brief Captures the graph parameters into the next slot of the frame ring and
+ * hands the pipeline to a graph processor if it is not running already.
+ */
+static vx_status vxSchedulePipelinedGraph(vx_graph graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_bool submit = vx_false_e;
+    vx_graph_frame_t *frame = NULL;
+    vx_uint32 i, n;
 
-        /* determine the next nodes */
-        vxFindNextNodes(graph, last_nodes, numLast, next_nodes, &numNext, left_nodes, &numLeft);
+    if (graph->verified == vx_false_e)
+    {
+        vx_bool idle;
+        vxSemWait(&graph->completionLock);
+        idle = ((graph->numFrames == 0u) && (graph->pipelineActive == vx_false_e)) ? vx_true_e : vx_false_e;
+        vxSemPost(&graph->completionLock);
+        if (idle == vx_false_e)
+            return VX_ERROR_GRAPH_SCHEDULED;
+        status = vxVerifyGraph(graph);
+        if (status != VX_SUCCESS)
+            return status;
+    }
 
-    } while (numNext > 0);
+    /* the application may wait for the frame, so it can't hold an image the frame needs */
+    for (n = 0u; n < graph->numNodes; n++)
+    {
+        vx_reference parameters[VX_INT_MAX_PARAMS] = {NULL};
+        for (i = 0u; i < graph->numParams; i++)
+        {
+            if (graph->parameters[i].node == graph->nodes[n])
+                parameters[graph->parameters[i].index] = graph->parameters[i].ref;
+        }
+        if (vxIsNodeHeldByApplication(graph->nodes[n], parameters) == vx_true_e)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Node[%u] %s uses an image the application is accessing!\n", n, graph->nodes[n]->kernel->name);
+            vxAddLogEntry(&graph->base, VX_ERROR_NO_RESOURCES, "Node[%u] %s uses an image the application is accessing!\n", n, graph->nodes[n]->kernel->name);
+            return VX_ERROR_NO_RESOURCES;
+        }
+    }
 
-    if (action == VX_ACTION_RESTART)
+    vxSemWait(&graph->completionLock);
+    if (graph->numFrames == graph->pipelineDepth)
     {
-        goto restart;
+        vxSemPost(&graph->completionLock);
+        return VX_ERROR_GRAPH_SCHEDULED;
     }
-    if (action == VX_ACTION_ABANDON)
+    frame = &graph->frames[(graph->oldestFrame + graph->numFrames) % graph->pipelineDepth];
+    frame->sequence = ++graph->nextSequence;
+    frame->started = vx_false_e;
+    frame->finished = vx_false_e;
+    frame->action = VX_ACTION_CONTINUE;
+    frame->status = VX_SUCCESS;
+    frame->numIssued = 0u;
+    frame->numRetired = 0u;
+    for (i = 0u; i < graph->numParams; i++)
     {
-        status = VX_ERROR_GRAPH_ABANDONED;
+        vx_reference ref = graph->parameters[i].ref;
+        if ((graph->parameters[i].node == NULL) || (ref == NULL))
+            continue;
+        vxIncrementReference(ref, VX_INTERNAL);
+        frame->parameters[i] = ref;
+        for (n = 0u; n < graph->numNodes; n++)
+        {
+            if (graph->nodes[n] == graph->parameters[i].node)
+                frame->nodes[n].parameters[graph->parameters[i].index] = ref;
+        }
     }
-    vxStopCapture(&graph->perf);
-    vxClearVisitation(graph);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    /* the frame uses the handles it was scheduled with */
+    if (vxHoldGraphHandles(graph, frame, &frame->held) != VX_SUCCESS)
+    {
+        for (i = 0u; i < VX_INT_MAX_PARAMS; i++)
+        {
+            if (frame->parameters[i])
+                vxReleaseReferenceInt(&frame->parameters[i], frame->parameters[i]->type, VX_INTERNAL, NULL);
+        }
+        graph->nextSequence--;
+        vxSemPost(&graph->completionLock);
+        return VX_ERROR_NO_MEMORY;
+    }
+#endif
+    vxResetEvent(&frame->done);
+    graph->numFrames++;
+    if (graph->pipelineActive == vx_false_e)
+    {
+        /* a fresh pipeline, every node is ready for this frame */
+        for (n = 0u; n < graph->numNodes; n++)
+        {
+            graph->nodes[n]->lastFrame = frame->sequence - 1u;
+            graph->nodes[n]->inFlight = vx_false_e;
+        }
+        graph->numCompleted = 0u;
+        graph->pipelineActive = vx_true_e;
+        vxResetEvent(&graph->pipelineStopped);
+        submit = vx_true_e;
+    }
+    else
+    {
+        vxSetEvent(&graph->completionEvent);
+    }
+    VX_PRINT(VX_ZONE_GRAPH, "Scheduled frame %u of graph "VX_FMT_REF"\n", frame->sequence, graph);
+    vxSemPost(&graph->completionLock);
 
-    VX_PRINT(VX_ZONE_GRAPH,"Process returned status %d\n", status);
-    for (n = 0; n < graph->numNodes; n++)
+    if ((submit == vx_true_e) && (vxSubmitGraph(graph->base.context, graph) == vx_false_e))
     {
-        VX_PRINT(VX_ZONE_PERF,"nodes[%u] %s[%d] last:"VX_FMT_TIME"ms avg:"VX_FMT_TIME"ms min:"VX_FMT_TIME"ms\n",
-                 n,
-                 graph->nodes[n]->kernel->name,
-                 graph->nodes[n]->kernel->enumeration,
-                 vxTimeToMS(graph->nodes[n]->perf.tmp),
-                 vxTimeToMS(graph->nodes[n]->perf.avg),
-                 vxTimeToMS(graph->nodes[n]->perf.min));
+        vxSemWait(&graph->completionLock);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+        vxReleaseGraphHandles(&frame->held);
+#endif
+        for (i = 0u; i < VX_INT_MAX_PARAMS; i++)
+        {
+            if (frame->parameters[i])
+                vxReleaseReferenceInt(&frame->parameters[i], frame->parameters[i]->type, VX_INTERNAL, NULL);
+        }
+        graph->numFrames--;
+        graph->nextSequence--;
+        graph->pipelineActive = vx_false_e;
+        vxSetEvent(&graph->pipelineStopped);
+        vxSemPost(&graph->completionLock);
+        status = VX_ERROR_NO_RESOURCES;
     }
     return status;
 }
 
-static vx_value_set_t graph_queue[10];
-static vx_size numGraphsQueued = 0ul;
+/*! \brief Waits on the oldest outstanding frame of a pipelined graph. Waiting on
+ * the last outstanding frame also waits for the graph processor to leave the
+ * pipeline, so that the graph may be processed or reconfigured right away.
+ */
+static vx_status vxWaitPipelinedGraph(vx_graph graph)
+{
+    vx_status status = VX_SUCCESS;
+    vx_graph_frame_t *frame = NULL;
+    vx_bool last = vx_false_e;
+
+    vxSemWait(&graph->completionLock);
+    if (graph->numFrames > 0u)
+        frame = &graph->frames[graph->oldestFrame];
+    vxSemPost(&graph->completionLock);
+    if (frame == NULL)
+        return VX_FAILURE;
+
+    if (vxWaitEvent(&frame->done, VX_INT_FOREVER) == vx_true_e)
+    {
+        status = frame->status;
+    }
+    else
+    {
+        VX_PRINT(VX_ZONE_ERROR, "Failed to wait on graph "VX_FMT_REF"\n", graph);
+        status = VX_FAILURE;
+    }
+    vxSemWait(&graph->completionLock);
+    graph->oldestFrame = (graph->oldestFrame + 1u) % graph->pipelineDepth;
+    graph->numFrames--;
+    if (graph->numFrames == 0u)
+        last = vx_true_e;
+    vxSemPost(&graph->completionLock);
+    if (last == vx_true_e)
+        vxWaitEvent(&graph->pipelineStopped, VX_INT_FOREVER);
+    return status;
+}
+#endif
 
 VX_API_ENTRY vx_status VX_API_CALL vxScheduleGraph(vx_graph graph)
 {
@@ -1416,41 +2803,34 @@ VX_API_ENTRY vx_status VX_API_CALL vxScheduleGraph(vx_graph graph)
     if (vxIsValidReference(&graph->base) == vx_false_e)
         return VX_ERROR_INVALID_REFERENCE;
 
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+    if (graph->pipelineDepth > 1u)
+        return vxSchedulePipelinedGraph(graph);
+#endif
+
     if (vxSemTryWait(&graph->lock) == vx_true_e)
     {
-        vx_sem_t* p_graph_queue_lock = graph->base.context->p_global_lock;
-        vx_uint32 q = 0u;
-        vx_value_set_t *pq = NULL;
-
-        vxSemWait(p_graph_queue_lock);
-        /* acquire a position in the graph queue */
-        for (q = 0; q < dimof(graph_queue); q++) {
-            if (graph_queue[q].v1 == 0) {
-                pq = &graph_queue[q];
-                numGraphsQueued++;
-                break;
-            }
+        vxResetEvent(&graph->scheduledEvent);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+        /* held from now on, the graph processor releases the handles once done */
+        if (vxHoldGraphHandles(graph, NULL, &graph->held) != VX_SUCCESS)
+        {
+            vxSemPost(&graph->lock);
+            return VX_ERROR_NO_MEMORY;
         }
-        vxSemPost(p_graph_queue_lock);
-        if (pq)
+#endif
+        /* now add the graph to the queue */
+        VX_PRINT(VX_ZONE_GRAPH,"Submitting graph=" VX_FMT_REF "\n", graph);
+        if (vxSubmitGraph(graph->base.context, graph) == vx_true_e)
         {
-            memset(pq, 0, sizeof(vx_value_set_t));
-            pq->v1 = (vx_value_t)graph;
-            /* now add the graph to the queue */
-            VX_PRINT(VX_ZONE_GRAPH,"Writing graph=" VX_FMT_REF ", status=%d\n",graph, status);
-            if (vxWriteQueue(&graph->base.context->proc.input, pq) == vx_true_e)
-            {
-                status = VX_SUCCESS;
-            }
-            else
-            {
-                vxSemPost(&graph->lock);
-                status = VX_ERROR_NO_RESOURCES;
-            }
+            status = VX_SUCCESS;
         }
         else
         {
-            VX_PRINT(VX_ZONE_ERROR, "Graph queue is full\n");
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+            vxReleaseGraphHandles(&graph->held);
+#endif
+            vxSemPost(&graph->lock);
             status = VX_ERROR_NO_RESOURCES;
         }
     }
@@ -1468,49 +2848,23 @@ VX_API_ENTRY vx_status VX_API_CALL vxWaitGraph(vx_graph graph)
     if (vxIsValidReference(&graph->base) == vx_false_e)
         return VX_ERROR_INVALID_REFERENCE;
 
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+    if (graph->pipelineDepth > 1u)
+        return vxWaitPipelinedGraph(graph);
+#endif
+
     if (vxSemTryWait(&graph->lock) == vx_false_e) // locked
     {
-        vx_sem_t* p_graph_queue_lock = graph->base.context->p_global_lock;
-        vx_graph g2;
-        vx_bool ret = vx_true_e;
-        vx_value_set_t *data = NULL;
-        do
+        /* the graph stays locked until its scheduled execution is waited on */
+        if (vxWaitEvent(&graph->scheduledEvent, VX_INT_FOREVER) == vx_true_e)
         {
-            ret = vxReadQueue(&graph->base.context->proc.output, &data);
-            if (ret == vx_false_e)
-            {
-                /* graph was locked but the queue was empty... */
-                VX_PRINT(VX_ZONE_ERROR, "Queue was empty but graph was locked.\n");
-                status = VX_FAILURE;
-            }
-            else
-            {
-                g2 = (vx_graph)data->v1;
-                status = (vx_status)data->v2;
-                if (g2 == graph) /* great, it's the graph we want. */
-                {
-                    vx_uint32 q = 0u;
-                    vxSemWait(p_graph_queue_lock);
-                    /* find graph in the graph queue */
-                    for (q = 0; q < dimof(graph_queue); q++)
-                    {
-                        if (graph_queue[q].v1 == (vx_value_t)graph)
-                        {
-                            graph_queue[q].v1 = 0;
-                            numGraphsQueued--;
-                            break;
-                        }
-                    }
-                    vxSemPost(p_graph_queue_lock);
-                    break;
-                }
-                else
-                {
-                    /* not the right graph, put it back. */
-                    vxWriteQueue(&graph->base.context->proc.output, data);
-                }
-            }
-        } while (ret == vx_true_e);
+            status = graph->scheduledStatus;
+        }
+        else
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Failed to wait on graph "VX_FMT_REF"\n", graph);
+            status = VX_FAILURE;
+        }
         vxSemPost(&graph->lock); /* unlock the graph. */
     }
     else
@@ -1526,19 +2880,36 @@ VX_API_ENTRY vx_status VX_API_CALL vxProcessGraph(vx_graph graph)
     if (vxIsValidReference(&graph->base) == vx_false_e)
         return VX_ERROR_INVALID_REFERENCE;
 
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+    /* the nodes belong to the pipeline while frames are outstanding */
+    if (graph->pipelineDepth > 1u)
+    {
+        vx_bool active;
+        vxSemWait(&graph->completionLock);
+        active = ((graph->numFrames > 0u) || (graph->pipelineActive == vx_true_e)) ? vx_true_e : vx_false_e;
+        vxSemPost(&graph->completionLock);
+        if (active == vx_true_e)
+            return VX_ERROR_GRAPH_SCHEDULED;
+    }
+#endif
+
     {
-        /* create a counter for re-entrancy checking */
-        static vx_uint32 count = 0;
-        vx_sem_t* p_sem = graph->base.context->p_global_lock;
         vx_status status = VX_SUCCESS;
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+        vx_image *held = NULL;
+
+        status = vxHoldGraphHandles(graph, NULL, &held);
+        if (status != VX_SUCCESS)
+            return status;
+#endif
 
-        vxSemWait(p_sem);
-        count++;
-        vxSemPost(p_sem);
-        status = vxExecuteGraph(graph, count);
-        vxSemWait(p_sem);
-        count--;
-        vxSemPost(p_sem);
+        /* the counter also checks for re-entrancy */
+        executing++;
+        status = vxExecuteGraph(graph, executing);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+        vxReleaseGraphHandles(&held);
+#endif
+        executing--;
 
         return status;
     }
@@ -1571,11 +2942,91 @@ VX_API_ENTRY vx_status VX_API_CALL vxAddParameterToGraph(vx_graph graph, vx_para
     return status;
 }
 
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+/*! \brief Checks that a value given to the frames of a pipelined graph has the
+ * attributes of the value the nodes were verified with.
+ */
+static vx_status vxMatchBoundParameter(vx_reference bound, vx_reference value)
+{
+    vx_status status = VX_SUCCESS;
+    if ((bound == NULL) || (bound->type != value->type))
+    {
+        status = VX_ERROR_INVALID_TYPE;
+    }
+    else if (value->type == VX_TYPE_IMAGE)
+    {
+        vx_image a = (vx_image)bound, b = (vx_image)value;
+        if (a->format != b->format)
+            status = VX_ERROR_INVALID_FORMAT;
+        else if ((a->width != b->width) || (a->height != b->height))
+            status = VX_ERROR_INVALID_DIMENSION;
+    }
+    else if (value->type == VX_TYPE_SCALAR)
+    {
+        if (((vx_scalar)bound)->data_type != ((vx_scalar)value)->data_type)
+            status = VX_ERROR_INVALID_TYPE;
+    }
+    else if (value->type == VX_TYPE_ARRAY)
+    {
+        vx_array a = (vx_array)bound, b = (vx_array)value;
+        if (a->item_type != b->item_type)
+            status = VX_ERROR_INVALID_TYPE;
+        else if (a->capacity > b->capacity)
+            status = VX_ERROR_INVALID_DIMENSION;
+    }
+    return status;
+}
+#endif
+
 VX_API_ENTRY vx_status VX_API_CALL vxSetGraphParameterByIndex(vx_graph graph, vx_uint32 index, vx_reference value)
 {
     vx_status status = VX_ERROR_INVALID_REFERENCE;
     if (vxIsValidSpecificReference(&graph->base, VX_TYPE_GRAPH) == vx_true_e)
     {
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+        if ((index < VX_INT_MAX_PARAMS) && (graph->pipelineDepth > 1u))
+        {
+            vx_node node = (vx_node)graph->parameters[index].node;
+            vxSemWait(&graph->completionLock);
+            if ((graph->pipelineActive == vx_false_e) && (graph->numFrames == 0u))
+            {
+                status = vxSetParameterByIndex(node, graph->parameters[index].index, value);
+            }
+            else if ((node == NULL) || (vxIsValidReference(value) == vx_false_e))
+            {
+                status = VX_ERROR_INVALID_REFERENCE;
+            }
+            else if ((value->type != node->kernel->signature.types[graph->parameters[index].index]) &&
+                     ((value->type != VX_TYPE_SCALAR) ||
+                      (VX_TYPE_IS_SCALAR(node->kernel->signature.types[graph->parameters[index].index]) == 0)))
+            {
+                status = VX_ERROR_INVALID_TYPE;
+            }
+            else
+            {
+                /* the nodes are bound to the value when the next frame executes, without
+                 * verifying the graph again. The nodes hold the verified value unless a
+                 * previous value overrides it.
+                 */
+                vx_reference bound = graph->parameters[index].ref;
+                if (bound == NULL)
+                    bound = node->parameters[graph->parameters[index].index];
+                status = vxMatchBoundParameter(bound, value);
+                if (status != VX_SUCCESS)
+                    VX_PRINT(VX_ZONE_ERROR, "Graph parameter %u does not match the verified value, status=%d\n", index, status);
+            }
+            if (status == VX_SUCCESS)
+            {
+                if (graph->parameters[index].ref)
+                    vxReleaseReferenceInt(&graph->parameters[index].ref, graph->parameters[index].ref->type, VX_INTERNAL, NULL);
+                if (value)
+                    vxIncrementReference(value, VX_INTERNAL);
+                graph->parameters[index].ref = value;
+            }
+            vxSemPost(&graph->completionLock);
+        }
+        else
+#endif
         if (index < VX_INT_MAX_PARAMS)
         {
             status = vxSetParameterByIndex((vx_node)graph->parameters[index].node,
@@ -97,6 +97,76 @@ static vx_uint32 vxComputePlaneRangeSize(vx_image image, vx_uint32 range, vx_uin
     return (range * image->memory.strides[p][VX_DIM_X]) / image->scale[p][VX_DIM_X];
 }
 
+/*! \brief Fills in the addressing of the image's own layout for a patch and
+ * returns the address of the patch within the plane.
+ */
+static vx_uint8 *vxMapImagePatch(vx_image image, vx_rectangle_t *rect, vx_uint32 plane_index, vx_imagepatch_addressing_t *addr)
+{
+    addr->dim_x = rect->end_x - rect->start_x;
+    addr->dim_y = rect->end_y - rect->start_y;
+    addr->stride_x = image->memory.strides[plane_index][VX_DIM_X];
+    addr->stride_y = image->memory.strides[plane_index][VX_DIM_Y];
+    addr->step_x = image->scale[plane_index][VX_DIM_X];
+    addr->step_y = image->scale[plane_index][VX_DIM_Y];
+    addr->scale_x = VX_SCALE_UNITY / image->scale[plane_index][VX_DIM_X];
+    addr->scale_y = VX_SCALE_UNITY / image->scale[plane_index][VX_DIM_Y];
+    return &image->memory.ptrs[plane_index][vxComputePatchOffset(rect->start_x, rect->start_y, addr)];
+}
+
+/*! \brief Returns the memory which owns the planes of an image. An image created
+ * from a region shares the memory of its parent, so a rectangle of the image is
+ * moved into the coordinates of that memory.
+ */
+static vx_memory_t *vxLocateImageMemory(vx_image image, vx_rectangle_t *rect, vx_rectangle_t *owned)
+{
+    vx_image root = image;
+    while (root->parent)
+        root = root->parent;
+    if (rect && owned)
+    {
+        *owned = *rect;
+        if (root != image)
+        {
+            /* the region starts where its first plane points into the owner's */
+            vx_size offset = (vx_size)(image->memory.ptrs[0] - root->memory.ptrs[0]);
+            vx_uint32 x = (vx_uint32)((offset % root->memory.strides[0][VX_DIM_Y]) / root->memory.strides[0][VX_DIM_X]);
+            vx_uint32 y = (vx_uint32)(offset / root->memory.strides[0][VX_DIM_Y]);
+            owned->start_x += x;
+            owned->end_x += x;
+            owned->start_y += y;
+            owned->end_y += y;
+        }
+    }
+    return &root->memory;
+}
+
+vx_bool vxIsImageHeldByApplication(vx_image image, vx_enum usage)
+{
+    vx_rectangle_t rect, owned;
+    vx_uint32 p;
+    if (image->memory.ptrs[0] == NULL)
+        return vx_false_e;
+    rect.start_x = 0u;
+    rect.start_y = 0u;
+    rect.end_x = image->width;
+    rect.end_y = image->height;
+    for (p = 0u; p < image->planes; p++)
+    {
+        if (vxIsRectangleHeldByApplication(vxLocateImageMemory(image, &rect, &owned), p, &owned, usage) == vx_true_e)
+            return vx_true_e;
+    }
+    return vx_false_e;
+}
+
+/*! \brief Removes the accessor of a patch accessed in copy mode once it is committed. */
+static void vxRemoveImageCopy(vx_image image, vx_uint32 index)
+{
+    vxRemoveAccessor(image->base.context, index);
+    vxSemWait(&image->base.lock);
+    image->copies--;
+    vxSemPost(&image->base.lock);
+}
+
 vx_bool vxIsValidImage(vx_image image)
 {
     if ((vxIsValidSpecificReference(&image->base, VX_TYPE_IMAGE) == vx_true_e) &&
@@ -176,6 +246,7 @@ void vxInitPlane(vx_image image,
         image->memory.dims[index][VX_DIM_X] = width;
         image->memory.dims[index][VX_DIM_Y] = height;
         image->memory.ndims = VX_DIM_MAX;
+        image->memory.row_alignment = VX_INT_MEMORY_ALIGNMENT;
         image->scale[index][VX_DIM_C] = 1;
         image->scale[index][VX_DIM_X] = 1;
         image->scale[index][VX_DIM_Y] = 1;
@@ -632,6 +703,155 @@ VX_API_ENTRY vx_image VX_API_CALL vxCreateImageFromHandle(vx_context context, vx
     return image;
 }
 
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+/*! \brief Points the image and the images created from regions of it at new planes.
+ * \note Called with the lock of the image held.
+ */
+static void vxRebaseImageHandle(vx_image image, void *const ptrs[])
+{
+    vx_context_t *context = image->base.context;
+    vx_uint32 r, p;
+
+    vxSemWait(&context->ref_lock);
+    for (r = 0u; r < context->num_reftable; r++)
+    {
+        vx_image child = (vx_image)context->reftable[r];
+        vx_image root = NULL;
+        if ((child == NULL) || (child->base.type != VX_TYPE_IMAGE) || (child->parent == NULL))
+            continue;
+        for (root = child->parent; root->parent; root = root->parent);
+        if (root != image)
+            continue;
+        for (p = 0u; p < child->planes; p++)
+        {
+            vx_size offset = (vx_size)(child->memory.ptrs[p] - image->memory.ptrs[p]);
+            child->memory.ptrs[p] = (vx_uint8 *)ptrs[p] + offset;
+        }
+    }
+    vxSemPost(&context->ref_lock);
+    for (p = 0u; p < image->planes; p++)
+    {
+        image->memory.ptrs[p] = (vx_uint8 *)ptrs[p];
+    }
+}
+
+vx_image vxLocateImageHandle(vx_reference ref)
+{
+    vx_image image = (vx_image)ref;
+    if ((ref == NULL) || (ref->type != VX_TYPE_IMAGE))
+        return NULL;
+    while (image->parent)
+        image = image->parent;
+    return (image->import_type != VX_IMPORT_TYPE_NONE) ? image : NULL;
+}
+
+void vxHoldImageHandle(vx_image image, vx_bool hold)
+{
+    void *done[VX_PLANE_MAX];
+    vx_bool swapped = vx_false_e;
+    vx_uint32 p;
+
+    if (hold == vx_true_e)
+    {
+        /* the image outlives the hold, even if the graph lets go of it meanwhile */
+        vxIncrementReference(&image->base, VX_INTERNAL);
+        vxSemWait(&image->base.lock);
+        image->holds++;
+        vxSemPost(&image->base.lock);
+        return;
+    }
+    vxSemWait(&image->base.lock);
+    if (image->holds == 0u)
+    {
+        VX_PRINT(VX_ZONE_ERROR, "Image "VX_FMT_REF" released without a hold!\n", image);
+    }
+    else if ((--image->holds == 0u) && (image->swap_pending == vx_true_e))
+    {
+        for (p = 0u; p < image->planes; p++)
+            done[p] = image->memory.ptrs[p];
+        vxRebaseImageHandle(image, image->pending);
+        image->swap_pending = vx_false_e;
+        swapped = vx_true_e;
+        VX_PRINT(VX_ZONE_IMAGE, "Applied the deferred swap of image "VX_FMT_REF"\n", image);
+    }
+    vxSemPost(&image->base.lock);
+    if ((swapped == vx_true_e) && (image->callback))
+        image->callback(image, done, image->planes, image->user_data);
+    vxReleaseReferenceInt((vx_reference *)&image, VX_TYPE_IMAGE, VX_INTERNAL, NULL);
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSetImageHandleCallback(vx_image image, vx_image_handle_f callback, void *user_data)
+{
+    vx_status status = VX_SUCCESS;
+    if (vxIsValidImage(image) == vx_false_e)
+    {
+        status = VX_ERROR_INVALID_REFERENCE;
+    }
+    else if ((image->import_type == VX_IMPORT_TYPE_NONE) || (image->parent != NULL))
+    {
+        status = VX_ERROR_NOT_SUPPORTED;
+    }
+    else
+    {
+        vxSemWait(&image->base.lock);
+        image->callback = callback;
+        image->user_data = user_data;
+        vxSemPost(&image->base.lock);
+    }
+    return status;
+}
+
+VX_API_ENTRY vx_status VX_API_CALL vxSwapImageHandle(vx_image image, void *const new_ptrs[], void *prev_ptrs[], vx_uint32 num_planes)
+{
+    vx_status status = VX_SUCCESS;
+    void *done[VX_PLANE_MAX];
+    vx_bool released = vx_false_e;
+    vx_uint32 p;
+
+    if (vxIsValidImage(image) == vx_false_e)
+        return VX_ERROR_INVALID_REFERENCE;
+    if ((image->import_type == VX_IMPORT_TYPE_NONE) || (image->parent != NULL))
+        return VX_ERROR_NOT_SUPPORTED;
+    if ((new_ptrs == NULL) || (num_planes != image->planes))
+        return VX_ERROR_INVALID_PARAMETERS;
+    for (p = 0u; p < num_planes; p++)
+    {
+        if (new_ptrs[p] == NULL)
+            return VX_ERROR_INVALID_PARAMETERS;
+    }
+
+    vxSemWait(&image->base.lock);
+    for (p = 0u; p < num_planes; p++)
+    {
+        if (prev_ptrs)
+            prev_ptrs[p] = image->memory.ptrs[p];
+    }
+    if (image->holds == 0u)
+    {
+        for (p = 0u; p < num_planes; p++)
+            done[p] = image->memory.ptrs[p];
+        vxRebaseImageHandle(image, new_ptrs);
+        released = vx_true_e;
+    }
+    else
+    {
+        /* a pending swap which never took effect is returned at once */
+        if (image->swap_pending == vx_true_e)
+        {
+            memcpy(done, image->pending, num_planes * sizeof(void *));
+            released = vx_true_e;
+        }
+        memcpy(image->pending, new_ptrs, num_planes * sizeof(void *));
+        image->swap_pending = vx_true_e;
+        VX_PRINT(VX_ZONE_IMAGE, "Deferred the swap of image "VX_FMT_REF" held %u times\n", image, image->holds);
+    }
+    vxSemPost(&image->base.lock);
+    if ((released == vx_true_e) && (image->callback))
+        image->callback(image, done, num_planes, image->user_data);
+    return status;
+}
+#endif
+
 VX_API_ENTRY vx_status VX_API_CALL vxQueryImage(vx_image image, vx_enum attribute, void *ptr, vx_size size)
 {
     vx_status status = VX_SUCCESS;
@@ -783,9 +1003,19 @@ void vxDestructImage(vx_reference ref)
     else if (image->import_type != VX_IMPORT_TYPE_NONE)
     {
         vx_int32 p = 0u;
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+        /* give the application back the planes the image used last and those of a swap not yet applied */
+        if (image->callback)
+        {
+            image->callback(image, (void **)image->memory.ptrs, image->planes, image->user_data);
+            if (image->swap_pending == vx_true_e)
+                image->callback(image, image->pending, image->planes, image->user_data);
+        }
+        image->swap_pending = vx_false_e;
+#endif
         for (p = 0; p < image->planes; p++)
         {
-            vxDestroySem(&image->memory.locks[p]);
+            vxDestroyPlaneLock(&image->memory, p);
             image->memory.ptrs[p] = NULL;
             image->memory.strides[p][VX_DIM_C] = 0;
             image->memory.strides[p][VX_DIM_X] = 0;
@@ -856,6 +1086,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxAccessImagePatch(vx_image image,
     vx_uint8 *p = NULL;
     vx_status status = VX_FAILURE;
     vx_bool mapped = vx_false_e;
+    vx_rectangle_t owned;
     vx_uint32 start_x = rect ? rect->start_x : 0u;
     vx_uint32 start_y = rect ? rect->start_y : 0u;
     vx_uint32 end_x = rect ? rect->end_x : 0u;
@@ -931,40 +1162,35 @@ VX_API_ENTRY vx_status VX_API_CALL vxAccessImagePatch(vx_image image,
      * 2.) !*ptr && WO == MAP
      * 3.) !*ptr && RW == MAP
      * 4.)  *ptr && RO||RW == COPY (UNLESS MAP)
+     * A caller's buffer at the very address the patch maps to already has the
+     * layout of the image, so it is mapped instead of copied onto itself.
      */
-
-    if ((*ptr == NULL) && ((usage == VX_READ_ONLY) ||
-                           (usage == VX_WRITE_ONLY) ||
-                           (usage == VX_READ_AND_WRITE)))
+    if (*ptr == NULL)
     {
         mapped = vx_true_e;
     }
+    else
+    {
+        vx_imagepatch_addressing_t map;
+        if ((vx_uint8 *)*ptr == vxMapImagePatch(image, rect, plane_index, &map))
+            mapped = vx_true_e;
+    }
 
     if (mapped == vx_true_e)
     {
-        vx_uint32 index = 0u;
-
-        /* lock the memory plane for multiple writers*/
-        if (usage != VX_READ_ONLY) {
-            if (vxSemWait(&image->memory.locks[plane_index]) == vx_false_e) {
-                status = VX_ERROR_NO_RESOURCES;
-                goto exit;
-            }
-        }
         vxPrintMemory(&image->memory);
-        p = (vx_uint8 *)image->memory.ptrs[plane_index];
         /* use the addressing of the internal format */
-        addr->dim_x = rect->end_x - rect->start_x;
-        addr->dim_y = rect->end_y - rect->start_y;
-        addr->stride_x = image->memory.strides[plane_index][VX_DIM_X];
-        addr->stride_y = image->memory.strides[plane_index][VX_DIM_Y];
-        addr->step_x = image->scale[plane_index][VX_DIM_X];
-        addr->step_y = image->scale[plane_index][VX_DIM_Y];
-        addr->scale_x = VX_SCALE_UNITY / image->scale[plane_index][VX_DIM_X];
-        addr->scale_y = VX_SCALE_UNITY / image->scale[plane_index][VX_DIM_Y];
-        index = vxComputePatchOffset(rect->start_x, rect->start_y, addr);
-        *ptr = &p[index];
-        VX_PRINT(VX_ZONE_IMAGE, "Returning mapped pointer %p which is offset by %lu\n", *ptr, index);
+        p = vxMapImagePatch(image, rect, plane_index, addr);
+        *ptr = p;
+        /* lock the rectangle, shared with other readers or exclusive to a writer */
+        status = vxLockRectangle(image->base.context, vxLocateImageMemory(image, rect, &owned), plane_index, &owned, usage, *ptr);
+        if (status != VX_SUCCESS)
+        {
+            *ptr = NULL;
+            vxAddLogEntry(&image->base, status, "Failed to lock the rectangle of plane %u!\n", plane_index);
+            goto exit;
+        }
+        VX_PRINT(VX_ZONE_IMAGE, "Returning mapped pointer %p\n", *ptr);
         vxReadFromReference(&image->base);
         vxIncrementReference(&image->base, VX_EXTERNAL);
         status = VX_SUCCESS;
@@ -973,12 +1199,24 @@ VX_API_ENTRY vx_status VX_API_CALL vxAccessImagePatch(vx_image image,
     {
         vx_size size = vxComputeImagePatchSize(image, rect, plane_index);
         vx_uint32 a = 0u;
+        /* a writer keeps the rectangle locked until the copy is committed, a
+         * reader only keeps the writers out while it copies */
+        status = vxLockRectangle(image->base.context, vxLocateImageMemory(image, rect, &owned), plane_index, &owned, usage, *ptr);
+        if (status != VX_SUCCESS)
+        {
+            vxAddLogEntry(&image->base, status, "Failed to lock the rectangle of plane %u!\n", plane_index);
+            goto exit;
+        }
         if (vxAddAccessor(image->base.context, size, usage, *ptr, &image->base, &a) == vx_true_e)
         {
             *ptr = image->base.context->accessors[a].ptr;
+            vxSemWait(&image->base.lock);
+            image->copies++;
+            vxSemPost(&image->base.lock);
         }
         else
         {
+            vxUnlockRectangle(vxLocateImageMemory(image, NULL, NULL), plane_index, &owned, *ptr);
             status = VX_ERROR_NO_MEMORY;
             vxAddLogEntry(&image->base, status, "Failed to allocate memory for COPY-ON-READ! Size="VX_FMT_SIZE"\n", size);
             goto exit;
@@ -990,15 +1228,6 @@ VX_API_ENTRY vx_status VX_API_CALL vxAccessImagePatch(vx_image image,
         vx_uint32 y, i, j, len;
         vx_uint8 *tmp = *ptr;
 
-        /*! \todo implement overlapping multi-writers lock, not just single writer lock */
-        if ((usage == VX_WRITE_ONLY) || (usage == VX_READ_AND_WRITE))
-        {
-            if (vxSemWait(&image->memory.locks[plane_index]) == vx_false_e)
-            {
-                status = VX_ERROR_NO_RESOURCES;
-                goto exit;
-            }
-        }
         /* use the dimensionality of a flat buffer. */
         addr->dim_x = rect->end_x - rect->start_x;
         addr->dim_y = rect->end_y - rect->start_y;
@@ -1018,6 +1247,8 @@ VX_API_ENTRY vx_status VX_API_CALL vxAccessImagePatch(vx_image image,
                 VX_PRINT(VX_ZONE_IMAGE, "%p[%u] <= %p[%u] for %u\n", tmp, j, image->memory.ptrs[plane_index], i, len);
                 memcpy(&tmp[j], &image->memory.ptrs[plane_index][i], len);
             }
+            if (usage == VX_READ_ONLY)
+                vxUnlockRectangle(vxLocateImageMemory(image, NULL, NULL), plane_index, &owned, tmp);
             VX_PRINT(VX_ZONE_IMAGE, "Copied image into %p\n", *ptr);
             vxReadFromReference(&image->base);
         }
@@ -1100,7 +1331,27 @@ VX_API_ENTRY vx_status VX_API_CALL vxCommitImagePatch(vx_image image,
          * 4.) EXTERNAL - dependant on area (do nothing on zero, determine on non-zero)
          * 5.) !INTERNAL && !EXTERNAL == MAPPED
          */
-        vx_bool internal = vxFindAccessor(image->base.context, ptr, &index);
+        vx_bool internal = vx_false_e;
+        vx_uint32 copies = 0u;
+        vx_rectangle_t locked = {0u, 0u, 0u, 0u};
+
+        /* a commit of zero area leaves the size of the accessed rectangle to its addressing */
+        if (zero_area == vx_false_e)
+            vxLocateImageMemory(image, rect, &locked);
+        else if (addr)
+        {
+            locked.end_x = addr->dim_x;
+            locked.end_y = addr->dim_y;
+        }
+
+        /* mapped patches skip the search of the accessors shared by the context */
+        vxSemWait(&image->base.lock);
+        copies = image->copies;
+        vxSemPost(&image->base.lock);
+        if (copies > 0u)
+        {
+            internal = vxFindAccessor(image->base.context, ptr, &index);
+        }
 
         if ((zero_area == vx_false_e) && (image->constant == vx_true_e))
         {
@@ -1116,11 +1367,12 @@ VX_API_ENTRY vx_status VX_API_CALL vxCommitImagePatch(vx_image image,
             if (internal == vx_true_e && image->base.context->accessors[index].usage == VX_READ_ONLY)
             {
                 /* this is a buffer that we allocated on behalf of the user and now they are done. Do nothing else*/
-                vxRemoveAccessor(image->base.context, index);
+                vxRemoveImageCopy(image, index);
             }
             else
             {
-                /* determine if this grows the valid region */
+                /* determine if this grows the valid region, writers of disjoint rectangles commit concurrently */
+                vxSemWait(&image->base.lock);
                 if (image->region.start_x > start_x)
                     image->region.start_x = start_x;
                 if (image->region.start_y > start_y)
@@ -1129,6 +1381,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxCommitImagePatch(vx_image image,
                     image->region.end_x = end_x;
                 if (image->region.end_y < end_y)
                     image->region.end_y = end_y;
+                vxSemPost(&image->base.lock);
 
                 /* index of 1 pixel line past last. */
                 i = (image->memory.dims[plane_index][VX_DIM_Y] * image->memory.strides[plane_index][VX_DIM_Y]);
@@ -1174,28 +1427,24 @@ VX_API_ENTRY vx_status VX_API_CALL vxCommitImagePatch(vx_image image,
                     }
                     if (internal == vx_true_e)
                     {
-                        /* a write only or read/write copy */
-                        vxRemoveAccessor(image->base.context, index);
+                        /* a write only or read/write copy, unlocked before the pointer can be reused */
+                        vxUnlockRectangle(vxLocateImageMemory(image, NULL, NULL), plane_index, &locked, ptr);
+                        vxRemoveImageCopy(image, index);
                     }
                 }
                 vxWroteToReference(&image->base);
             }
             status = VX_SUCCESS;
-            vxSemPost(&image->memory.locks[plane_index]);
+            if (internal == vx_false_e)
+                vxUnlockRectangle(vxLocateImageMemory(image, NULL, NULL), plane_index, &locked, ptr);
         }
         else if (zero_area == vx_true_e)
         {
             /* could be RO|WO|RW where they decided not to commit anything. */
-            if (internal == vx_true_e) // RO
-            {
-                vxRemoveAccessor(image->base.context, index);
-            }
-            else // RW|WO
+            vxUnlockRectangle(vxLocateImageMemory(image, NULL, NULL), plane_index, &locked, ptr);
+            if (internal == vx_true_e)
             {
-                /*! \bug (possible bug, but maybe not) anyone can decrement an
-                 *  image access, should we limit to incrementor? that would be
-                 *  a lot to track */
-                vxSemPost(&image->memory.locks[plane_index]);
+                vxRemoveImageCopy(image, index);
             }
             status = VX_SUCCESS;
         }
@@ -1265,6 +1514,8 @@ void vxPrintImage(vx_image image)
 {
     vx_uint32 p = 0;
     vx_char df_image[5];
+    if (!VX_ZONE_ENABLED(VX_ZONE_IMAGE) && !VX_ZONE_ENABLED(VX_ZONE_REFERENCE))
+        return;
     strncpy(df_image, (char *)&image->format, 4);
     df_image[4] = '\0';
     vxPrintReference(&image->base);
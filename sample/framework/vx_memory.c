@@ -22,6 +22,329 @@
  */
 
 #include <vx_internal.h>
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+#if defined(OPENVX_USE_HUGE_PAGES) && defined(__linux__)
+#include <sys/mman.h>
+#define VX_HUGE_PAGES
+#endif
+
+/*! \brief Rounds a size up to its class of the memory pool. The smallest class
+ * holds 64 bytes, above it there are four classes per power of two.
+ */
+static vx_uint32 vxPoolClass(vx_size size, vx_size *rounded)
+{
+    vx_uint32 c = 0u;
+    vx_size top = VX_INT_MEMORY_ALIGNMENT;
+    while (top < size)
+    {
+        top <<= 1;
+        c += 4u;
+    }
+    if (c > 0u)
+    {
+        vx_size step = top >> 3;
+        vx_size k = (size - (top >> 1) + step - 1u) / step;
+        *rounded = (top >> 1) + k * step;
+        return c - 4u + (vx_uint32)k;
+    }
+    *rounded = top;
+    return c;
+}
+
+/*! \brief The size of the blocks of a class of the memory pool. */
+static vx_size vxPoolClassSize(vx_uint32 c)
+{
+    vx_size top = (vx_size)VX_INT_MEMORY_ALIGNMENT << ((c + 3u) / 4u);
+    return (c == 0u ? top : (top >> 1) + ((c + 3u) % 4u + 1u) * (top >> 3));
+}
+
+#if defined(VX_HUGE_PAGES)
+/*! \brief Maps a block which is backed by huge pages. When none are reserved the
+ * block is aligned to a huge page and left to transparent huge pages.
+ */
+static void *vxMapHugeBlock(vx_size size)
+{
+    vx_size len = (size + VX_INT_HUGE_PAGE_SIZE - 1u) & ~(vx_size)(VX_INT_HUGE_PAGE_SIZE - 1u);
+    vx_uint8 *ptr = NULL, *aligned = NULL;
+#if defined(MAP_HUGETLB)
+    ptr = mmap(NULL, len, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED)
+        return ptr;
+#endif
+    ptr = mmap(NULL, len + VX_INT_HUGE_PAGE_SIZE, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED)
+        return NULL;
+    aligned = (vx_uint8 *)(((vx_size)ptr + VX_INT_HUGE_PAGE_SIZE - 1u) & ~(vx_size)(VX_INT_HUGE_PAGE_SIZE - 1u));
+    if (aligned > ptr)
+        munmap(ptr, aligned - ptr);
+    munmap(aligned + len, (ptr + VX_INT_HUGE_PAGE_SIZE) - aligned);
+#if defined(MADV_HUGEPAGE)
+    madvise(aligned, len, MADV_HUGEPAGE);
+#endif
+    return aligned;
+}
+#endif
+
+/*! \brief Takes an aligned block of a size class from the system. */
+static void *vxAllocateBlock(vx_size size)
+{
+    void *ptr = NULL;
+#if defined(VX_HUGE_PAGES)
+    if (size >= VX_INT_HUGE_PAGE_SIZE)
+        return vxMapHugeBlock(size);
+#endif
+#if defined(_WIN32)
+    ptr = _aligned_malloc(size, VX_INT_MEMORY_ALIGNMENT);
+#else
+    if (posix_memalign(&ptr, VX_INT_MEMORY_ALIGNMENT, size) != 0)
+        ptr = NULL;
+#endif
+    return ptr;
+}
+
+/*! \brief Returns a block of a size class to the system. */
+static void vxFreeBlock(void *ptr, vx_size size)
+{
+#if defined(VX_HUGE_PAGES)
+    if (size >= VX_INT_HUGE_PAGE_SIZE)
+    {
+        munmap(ptr, (size + VX_INT_HUGE_PAGE_SIZE - 1u) & ~(vx_size)(VX_INT_HUGE_PAGE_SIZE - 1u));
+        return;
+    }
+#endif
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+
+void vxInitMemoryPool(vx_context context)
+{
+    memset(context->pool.blocks, 0, sizeof(context->pool.blocks));
+    context->pool.cached = 0u;
+    vxCreateSem(&context->pool.lock, 1);
+}
+
+void vxDeinitMemoryPool(vx_context context)
+{
+    vx_uint32 c;
+    for (c = 0u; c < VX_INT_POOL_CLASSES; c++)
+    {
+        while (context->pool.blocks[c])
+        {
+            void *ptr = context->pool.blocks[c];
+            context->pool.blocks[c] = *(void **)ptr;
+            vxFreeBlock(ptr, vxPoolClassSize(c));
+        }
+    }
+    context->pool.cached = 0u;
+    vxDestroySem(&context->pool.lock);
+}
+
+void *vxAllocatePooled(vx_context context, vx_size size)
+{
+    vx_size rounded = 0u;
+    vx_uint32 c = vxPoolClass(size, &rounded);
+    void *ptr = NULL;
+    if ((context != NULL) && (c < VX_INT_POOL_CLASSES))
+    {
+        vxSemWait(&context->pool.lock);
+        ptr = context->pool.blocks[c];
+        if (ptr)
+        {
+            context->pool.blocks[c] = *(void **)ptr;
+            context->pool.cached -= rounded;
+        }
+        vxSemPost(&context->pool.lock);
+    }
+    if (ptr == NULL)
+        ptr = vxAllocateBlock(rounded);
+    return ptr;
+}
+
+void vxFreePooled(vx_context context, void *ptr, vx_size size)
+{
+    vx_size rounded = 0u;
+    vx_uint32 c = vxPoolClass(size, &rounded);
+    if (ptr == NULL)
+        return;
+    if ((context != NULL) && (c < VX_INT_POOL_CLASSES))
+    {
+        vxSemWait(&context->pool.lock);
+        if (context->pool.cached + rounded <= VX_INT_POOL_MAX_CACHED)
+        {
+            *(void **)ptr = context->pool.blocks[c];
+            context->pool.blocks[c] = ptr;
+            context->pool.cached += rounded;
+            ptr = NULL;
+        }
+        vxSemPost(&context->pool.lock);
+    }
+    if (ptr)
+        vxFreeBlock(ptr, rounded);
+}
+
+static vx_bool vxRectanglesOverlap(vx_rectangle_t *a, vx_rectangle_t *b)
+{
+    if ((a->end_x <= b->start_x) || (b->end_x <= a->start_x) ||
+        (a->end_y <= b->start_y) || (b->end_y <= a->start_y))
+        return vx_false_e;
+    else
+        return vx_true_e;
+}
+
+/*! \brief Identifies the calling thread to the rectangle locks. */
+static VX_THREAD_LOCAL vx_uint8 rect_lock_owner;
+
+/*! \brief Determines if an access with the usage has to wait for a locked rectangle. */
+static vx_bool vxRectangleConflicts(vx_rect_lock_t *lock, vx_rectangle_t *rect, vx_enum usage)
+{
+    /* readers share a rectangle, a writer has it to itself */
+    if ((lock->used == vx_true_e) &&
+        ((usage != VX_READ_ONLY) || (lock->usage != VX_READ_ONLY)) &&
+        (vxRectanglesOverlap(&lock->rect, rect) == vx_true_e))
+        return vx_true_e;
+    else
+        return vx_false_e;
+}
+
+vx_status vxLockRectangle(vx_context_t *context, vx_memory_t *memory, vx_uint32 plane, vx_rectangle_t *rect, vx_enum usage, void *key)
+{
+    vx_status status = VX_ERROR_NO_MEMORY;
+    if (vxSemWait(&memory->locks[plane]) == vx_false_e)
+        return VX_ERROR_NO_RESOURCES;
+    for (;;)
+    {
+        vx_rect_lock_t *wait = NULL, *open = NULL;
+        vx_uint32 l;
+        for (l = 0u; l < memory->num_accesses[plane]; l++)
+        {
+            vx_rect_lock_t *lock = memory->accesses[plane][l];
+            if (vxRectangleConflicts(lock, rect, usage) == vx_true_e)
+            {
+                wait = lock;
+                break;
+            }
+            else if ((lock->used == vx_false_e) && (lock->waiters == 0u) && (open == NULL))
+            {
+                /* a released entry is reused once all of its waiters have woken */
+                open = lock;
+            }
+        }
+        if (wait && wait->owner == &rect_lock_owner)
+        {
+            VX_PRINT(VX_ZONE_ERROR, "Rectangle {%u,%u},{%u,%u} of plane %u is already accessed by this thread\n",
+                     wait->rect.start_x, wait->rect.start_y, wait->rect.end_x, wait->rect.end_y, plane);
+            status = VX_ERROR_NO_RESOURCES;
+            break;
+        }
+        if (wait)
+        {
+            VX_PRINT(VX_ZONE_INFO, "Waiting on accessed rectangle {%u,%u},{%u,%u} of plane %u\n",
+                     wait->rect.start_x, wait->rect.start_y, wait->rect.end_x, wait->rect.end_y, plane);
+            wait->waiters++;
+            vxSemPost(&memory->locks[plane]);
+            vxSemWait(&wait->released);
+            vxSemWait(&memory->locks[plane]);
+            wait->waiters--;
+            continue;
+        }
+        if (open == NULL)
+        {
+            vx_rect_lock_t **accesses = (vx_rect_lock_t **)realloc(memory->accesses[plane],
+                                        (memory->num_accesses[plane] + 1u) * sizeof(vx_rect_lock_t *));
+            if (accesses == NULL)
+                break;
+            memory->accesses[plane] = accesses;
+            open = (vx_rect_lock_t *)calloc(1, sizeof(vx_rect_lock_t));
+            if (open == NULL)
+                break;
+            vxCreateSem(&open->released, 0);
+            accesses[memory->num_accesses[plane]++] = open;
+        }
+        open->rect = *rect;
+        open->usage = usage;
+        open->key = key;
+        open->owner = &rect_lock_owner;
+        open->executing = vxIsExecutingGraph(context);
+        open->used = vx_true_e;
+        status = VX_SUCCESS;
+        break;
+    }
+    vxSemPost(&memory->locks[plane]);
+    return status;
+}
+
+vx_bool vxIsRectangleHeldByApplication(vx_memory_t *memory, vx_uint32 plane, vx_rectangle_t *rect, vx_enum usage)
+{
+    vx_bool held = vx_false_e;
+    vx_uint32 l;
+    if (vxSemWait(&memory->locks[plane]) == vx_false_e)
+        return vx_false_e;
+    for (l = 0u; l < memory->num_accesses[plane]; l++)
+    {
+        vx_rect_lock_t *lock = memory->accesses[plane][l];
+        if ((lock->executing == vx_false_e) &&
+            (vxRectangleConflicts(lock, rect, usage) == vx_true_e))
+        {
+            held = vx_true_e;
+            break;
+        }
+    }
+    vxSemPost(&memory->locks[plane]);
+    return held;
+}
+
+vx_bool vxUnlockRectangle(vx_memory_t *memory, vx_uint32 plane, vx_rectangle_t *rect, void *key)
+{
+    vx_rect_lock_t *found = NULL;
+    vx_uint32 l, w;
+    if (vxSemWait(&memory->locks[plane]) == vx_false_e)
+        return vx_false_e;
+    for (l = 0u; l < memory->num_accesses[plane]; l++)
+    {
+        vx_rect_lock_t *lock = memory->accesses[plane][l];
+        if ((lock->used == vx_true_e) && (lock->key == key))
+        {
+            /* readers which start at the same pixel share a key, their size tells them apart */
+            if ((lock->rect.end_x - lock->rect.start_x == rect->end_x - rect->start_x) &&
+                (lock->rect.end_y - lock->rect.start_y == rect->end_y - rect->start_y))
+            {
+                found = lock;
+                break;
+            }
+            if (found == NULL)
+                found = lock;
+        }
+    }
+    if (found)
+    {
+        found->used = vx_false_e;
+        for (w = 0u; w < found->waiters; w++)
+        {
+            vxSemPost(&found->released);
+        }
+    }
+    vxSemPost(&memory->locks[plane]);
+    return (found ? vx_true_e : vx_false_e);
+}
+
+void vxDestroyPlaneLock(vx_memory_t *memory, vx_uint32 plane)
+{
+    vx_uint32 l;
+    for (l = 0u; l < memory->num_accesses[plane]; l++)
+    {
+        vxDestroySem(&memory->accesses[plane][l]->released);
+        free(memory->accesses[plane][l]);
+    }
+    free(memory->accesses[plane]);
+    memory->accesses[plane] = NULL;
+    memory->num_accesses[plane] = 0u;
+    vxDestroySem(&memory->locks[plane]);
+}
 
 vx_bool vxFreeMemory(vx_context context, vx_memory_t *memory)
 {
@@ -37,37 +360,70 @@ vx_bool vxFreeMemory(vx_context context, vx_memory_t *memory)
 #if defined(EXPERIMENTAL_USE_OPENCL)
                 clReleaseMemObject(memory->hdls[p]);
 #endif
-                free(memory->ptrs[p]);
-                vxDestroySem(&memory->locks[p]);
+                /* planned memory belongs to the arena of a graph */
+                if (memory->planned == vx_false_e)
+                    vxFreePooled(context, memory->ptrs[p], memory->sizes[p]);
+                vxDestroyPlaneLock(memory, p);
                 memory->ptrs[p] = NULL;
             }
         }
         memory->allocated = vx_false_e;
+        memory->planned = vx_false_e;
     }
     return memory->allocated;
 }
 
+vx_size vxComputeMemoryLayout(vx_memory_t *memory, vx_int32 p)
+{
+    vx_int32 d = 0;
+    vx_size size = sizeof(vx_uint8);
+    /* channel is a declared size, don't assume */
+    if (memory->strides[p][VX_DIM_C] != 0)
+        size = (size_t)abs(memory->strides[p][VX_DIM_C]);
+    for (d = 0; d < memory->ndims; d++)
+    {
+        /* pad the rows to the cache line and the vector width */
+        if ((d > 0) && (d == memory->ndims - 1) && (memory->row_alignment > 1u))
+            size = (size + memory->row_alignment - 1u) & ~(vx_size)(memory->row_alignment - 1u);
+        memory->strides[p][d] = (vx_int32)size;
+        size *= (vx_size)abs(memory->dims[p][d]);
+    }
+    return size;
+}
+
+vx_bool vxBindMemory(vx_context context, vx_memory_t *memory, vx_uint8 *ptrs[VX_PLANE_MAX])
+{
+    if (memory->allocated == vx_false_e)
+    {
+        vx_int32 p = 0;
+        for (p = 0; p < memory->nptrs; p++)
+        {
+            vxComputeMemoryLayout(memory, p);
+            memory->ptrs[p] = ptrs[p];
+            vxCreateSem(&memory->locks[p], 1);
+            VX_PRINT(VX_ZONE_INFO, "Bound plane %u to %p\n", p, memory->ptrs[p]);
+        }
+        memory->allocated = vx_true_e;
+        memory->planned = vx_true_e;
+        vxPrintMemory(memory);
+    }
+    return memory->planned;
+}
+
 
 vx_bool vxAllocateMemory(vx_context context, vx_memory_t *memory)
 {
     if (memory->allocated == vx_false_e)
     {
-        vx_int32 d = 0, p = 0;
+        vx_int32 p = 0;
         VX_PRINT(VX_ZONE_INFO, "Allocating %u pointers of %u dimensions each.\n", memory->nptrs, memory->ndims);
         memory->allocated = vx_true_e;
         for (p = 0; p < memory->nptrs; p++)
         {
-            vx_size size = sizeof(vx_uint8);
-            /* channel is a declared size, don't assume */
-            if (memory->strides[p][VX_DIM_C] != 0)
-                size = (size_t)abs(memory->strides[p][VX_DIM_C]);
-            for (d = 0; d < memory->ndims; d++)
-            {
-                memory->strides[p][d] = (vx_int32)size;
-                size *= (vx_size)abs(memory->dims[p][d]);
-            }
+            vx_size size = vxComputeMemoryLayout(memory, p);
             /* don't presume that memory should be zeroed */
-            memory->ptrs[p] = malloc(size);
+            memory->ptrs[p] = vxAllocatePooled(context, size);
+            memory->sizes[p] = size;
             if (memory->ptrs[p] == NULL)
             {
                 VX_PRINT(VX_ZONE_ERROR, "Failed to allocated "VX_FMT_SIZE" bytes\n", size);
@@ -76,7 +432,8 @@ vx_bool vxAllocateMemory(vx_context context, vx_memory_t *memory)
                 for (p = p - 1; p >= 0; p--)
                 {
                     VX_PRINT(VX_ZONE_INFO, "Freeing %p\n", memory->ptrs[p]);
-                    free(memory->ptrs[p]);
+                    vxFreePooled(context, memory->ptrs[p], memory->sizes[p]);
+                    vxDestroyPlaneLock(memory, p);
                     memory->ptrs[p] = NULL;
                 }
                 break;
@@ -125,6 +482,9 @@ vx_bool vxAllocateMemory(vx_context context, vx_memory_t *memory)
 void vxPrintMemory(vx_memory_t *mem)
 {
     vx_int32 d = 0, p = 0;
+    /* probing the locks is not free, only do it when the prints are wanted */
+    if (!VX_ZONE_ENABLED(VX_ZONE_INFO))
+        return;
     for (p = 0; p < mem->nptrs; p++)
     {
         vx_bool gotlock = vxSemTryWait(&mem->locks[p]);
@@ -348,6 +348,14 @@ void vxDestructNode(vx_reference ref)
         node->attributes.localDataPtr = NULL;
     }
 
+    /* free the dependency information */
+    if (node->successors)
+    {
+        free(node->successors);
+        node->successors = NULL;
+        node->numSuccessors = 0;
+    }
+
     vxReleaseReferenceInt((vx_reference *)&node->kernel, VX_TYPE_KERNEL, VX_INTERNAL, NULL);
 }
 
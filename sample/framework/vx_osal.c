@@ -336,67 +336,277 @@ vx_thread_t vxCreateThread(vx_thread_f func, void *arg)
 }
 
 
+vx_uint32 vxAtomicLoad(volatile vx_uint32 *ptr)
+{
+#if defined(_WIN32) || defined(UNDER_CE)
+    vx_uint32 value = *ptr;
+    MemoryBarrier();
+    return value;
+#else
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+#endif
+}
+
+void vxAtomicStore(volatile vx_uint32 *ptr, vx_uint32 value)
+{
+#if defined(_WIN32) || defined(UNDER_CE)
+    MemoryBarrier();
+    *ptr = value;
+#else
+    __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+#endif
+}
+
+vx_uint32 vxAtomicAdd(volatile vx_uint32 *ptr, vx_int32 value)
+{
+#if defined(_WIN32) || defined(UNDER_CE)
+    return (vx_uint32)InterlockedExchangeAdd((LONG volatile *)ptr, (LONG)value) + (vx_uint32)value;
+#else
+    return __atomic_add_fetch(ptr, (vx_uint32)value, __ATOMIC_SEQ_CST);
+#endif
+}
+
+vx_bool vxAtomicCompareExchange(volatile vx_uint32 *ptr, vx_uint32 expected, vx_uint32 desired)
+{
+#if defined(_WIN32) || defined(UNDER_CE)
+    if ((vx_uint32)InterlockedCompareExchange((LONG volatile *)ptr, (LONG)desired, (LONG)expected) == expected)
+#else
+    if (__atomic_compare_exchange_n(ptr, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED))
+#endif
+        return vx_true_e;
+    else
+        return vx_false_e;
+}
+
+void vxMemoryFence(void)
+{
+#if defined(_WIN32) || defined(UNDER_CE)
+    MemoryBarrier();
+#else
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#endif
+}
+
+/* The deque follows "Correct and Efficient Work-Stealing for Weak Memory
+ * Models" (Le et al.) with a fixed size buffer. The indexes only ever grow, so
+ * the number of items is always the (wrapping) difference of bottom and top.
+ */
+
+void vxInitDeque(vx_deque_t *d)
+{
+    if (d)
+    {
+        memset((void *)d->data, 0, sizeof(d->data));
+        d->top = 0u;
+        d->bottom = 0u;
+    }
+}
+
+vx_bool vxPushDeque(vx_deque_t *d, vx_value_set_t *data)
+{
+    vx_uint32 b = d->bottom;
+    vx_uint32 t = vxAtomicLoad(&d->top);
+    if ((vx_int32)(b - t) >= VX_INT_MAX_DEQUE_DEPTH)
+    {
+        return vx_false_e;
+    }
+    d->data[b & (VX_INT_MAX_DEQUE_DEPTH - 1)] = data;
+    /* publish the item before the new bottom */
+    vxAtomicStore(&d->bottom, b + 1u);
+    return vx_true_e;
+}
+
+vx_value_set_t *vxPopDeque(vx_deque_t *d)
+{
+    vx_value_set_t *data = NULL;
+    vx_uint32 b = d->bottom - 1u;
+    vx_uint32 t;
+    d->bottom = b;
+    /* the reservation of the bottom item must be visible before reading top */
+    vxMemoryFence();
+    t = d->top;
+    if ((vx_int32)(b - t) >= 0)
+    {
+        data = d->data[b & (VX_INT_MAX_DEQUE_DEPTH - 1)];
+        if (b == t)
+        {
+            /* the last item, race the thieves for it */
+            if (vxAtomicCompareExchange(&d->top, t, t + 1u) == vx_false_e)
+            {
+                data = NULL;
+            }
+            d->bottom = b + 1u;
+        }
+    }
+    else
+    {
+        /* empty */
+        d->bottom = b + 1u;
+    }
+    return data;
+}
+
+vx_value_set_t *vxStealDeque(vx_deque_t *d)
+{
+    vx_value_set_t *data = NULL;
+    vx_uint32 t = vxAtomicLoad(&d->top);
+    vx_uint32 b;
+    vxMemoryFence();
+    b = vxAtomicLoad(&d->bottom);
+    if ((vx_int32)(b - t) > 0)
+    {
+        data = d->data[t & (VX_INT_MAX_DEQUE_DEPTH - 1)];
+        if (vxAtomicCompareExchange(&d->top, t, t + 1u) == vx_false_e)
+        {
+            /* lost the race to the owner or another thief */
+            data = NULL;
+        }
+    }
+    return data;
+}
+
+static VX_THREAD_LOCAL vx_threadpool_worker_t *current_worker = NULL;
+
 void vxDestroyThreadpool(vx_threadpool_t **ppool)
 {
     vx_threadpool_t *pool = (ppool ? *ppool : NULL);
     if (pool)
     {
         uint32_t i;
+        vxSemWait(&pool->sem);
+        pool->running = vx_false_e;
+        vxSetEvent(&pool->available);
+        vxSemPost(&pool->sem);
         for (i = 0u; i < pool->numWorkers; i++)
         {
             vx_value_t ret;
-            vxPopQueue(pool->workers[i].queue);
             vxJoinThread(pool->workers[i].handle, &ret);
             vxStopCapture(&pool->workers[i].perf);
             pool->workers[i].handle = 0;
-            vxDestroyQueue(&pool->workers[i].queue);
-            pool->workers[i].queue = (vx_queue_t *)NULL;
         }
         free(pool->workers);
         pool->workers = (vx_threadpool_worker_t *)NULL;
         vxDestroySem(&pool->sem);
+        vxDeinitEvent(&pool->available);
         vxDeinitEvent(&pool->completed);
         free(pool);
         *ppool = NULL;
     }
 }
 
+/*! \brief Claims the next work item for a worker. The worker's own deque is
+ * checked first, then the items issued from outside the pool (a share of which
+ * is moved into the worker's deque so that idle workers can steal it) and
+ * finally the deques of the other workers.
+ */
+static vx_value_set_t *vxClaimThreadpoolWork(vx_threadpool_worker_t *pool_worker)
+{
+    vx_threadpool_t *pool = pool_worker->pool;
+    vx_value_set_t *data = vxPopDeque(&pool_worker->deque);
+    uint32_t i;
+
+    if (data == NULL && vxAtomicLoad(&pool->numInjected) > 0u)
+    {
+        vxSemWait(&pool->sem);
+        if (pool->numInjected > 0u)
+        {
+            uint32_t share, numInjected = pool->numInjected - 1u;
+            data = pool->injected[pool->injectedStart];
+            pool->injectedStart = (pool->injectedStart + 1u) % VX_INT_MAX_DEQUE_DEPTH;
+            share = numInjected / pool->numWorkers;
+            for (i = 0u; i < share; i++)
+            {
+                if (vxPushDeque(&pool_worker->deque, pool->injected[pool->injectedStart]) == vx_false_e)
+                    break;
+                pool->injectedStart = (pool->injectedStart + 1u) % VX_INT_MAX_DEQUE_DEPTH;
+                numInjected--;
+            }
+            vxAtomicStore(&pool->numInjected, numInjected);
+        }
+        vxSemPost(&pool->sem);
+    }
+
+    for (i = 1u; data == NULL && i < pool->numWorkers; i++)
+    {
+        vx_threadpool_worker_t *victim = &pool->workers[(pool_worker->index + i) % pool->numWorkers];
+        data = vxStealDeque(&victim->deque);
+        if (data)
+        {
+            VX_PRINT(VX_ZONE_OSAL, "Worker %u stole workitem from worker %u\n", pool_worker->index, victim->index);
+        }
+    }
+
+    if (data)
+    {
+        vxAtomicAdd(&pool->numQueuedItems, -1);
+    }
+    return data;
+}
+
 static vx_value_t vxWorkerThreadpool(void *arg)
 {
     vx_threadpool_worker_t *pool_worker = (vx_threadpool_worker_t *)arg;
+    vx_threadpool_t *pool = pool_worker->pool;
     vx_bool ret = vx_false_e;
 
     /* capture the launch latency */
     vxStopCapture(&pool_worker->perf);
 
-    VX_PRINT(VX_ZONE_OSAL, "Threadpool worker %p active, waiting on queue!\n", arg);
+    VX_PRINT(VX_ZONE_OSAL, "Threadpool worker %p active, waiting for work!\n", arg);
 
     /*! \bug assign this thread to the next available core */
     //thread_nextaffinity();
 
+    current_worker = pool_worker;
     vxInitPerf(&pool_worker->perf); // reset
     vxStartCapture(&pool_worker->perf);
 
-    while (vxReadQueue(pool_worker->queue, &pool_worker->data) == vx_true_e)
+    for (;;)
     {
-        vx_threadpool_f function = pool_worker->function;
-        VX_PRINT(VX_ZONE_OSAL, "Worker received workitem!\n");
-        pool_worker->active = vx_true_e;
-        vxStopCapture(&pool_worker->perf);
-        ret = function(pool_worker); /* <=== WORK IS DONE HERE */
-        vxSemWait(&pool_worker->pool->sem);
-        pool_worker->pool->numCurrentItems--;
-        if (pool_worker->pool->numCurrentItems <= 0)
+        pool_worker->data = vxClaimThreadpoolWork(pool_worker);
+        if (pool_worker->data)
         {
-            vxSetEvent(&pool_worker->pool->completed);
+            vx_threadpool_f function = pool_worker->function;
+            VX_PRINT(VX_ZONE_OSAL, "Worker received workitem!\n");
+            pool_worker->active = vx_true_e;
+            vxStopCapture(&pool_worker->perf);
+            if (pool_worker->data->v1 == 0)
+            {
+                /* a task carries its own function and argument */
+                vx_task_f task = (vx_task_f)pool_worker->data->v2;
+                task((void *)pool_worker->data->v3);
+                ret = vx_true_e;
+            }
+            else
+            {
+                ret = function(pool_worker); /* <=== WORK IS DONE HERE */
+            }
+            vxStartCapture(&pool_worker->perf);
+            pool_worker->active = vx_false_e;
+            if (vxAtomicAdd(&pool->numCurrentItems, -1) == 0u)
+            {
+                vxSemWait(&pool->sem);
+                vxSetEvent(&pool->completed);
+                vxSemPost(&pool->sem);
+            }
+            continue;
         }
-        vxSemPost(&pool_worker->pool->sem);
-        vxStartCapture(&pool_worker->perf);
-        pool_worker->active = vx_false_e;
 
-        // if (ret == vx_false_e)
-        //     break;
+        /* nothing to claim, sleep until more work is issued */
+        vxSemWait(&pool->sem);
+        if (pool->running == vx_false_e)
+        {
+            vxSemPost(&pool->sem);
+            break;
+        }
+        if (vxAtomicLoad(&pool->numQueuedItems) == 0u)
+        {
+            vxResetEvent(&pool->available);
+        }
+        vxSemPost(&pool->sem);
+        vxWaitEvent(&pool->available, VX_INT_FOREVER);
     }
+    current_worker = NULL;
     VX_PRINT(VX_ZONE_OSAL, "Worker exiting!\n");
     return (vx_value_t)ret;
 }
@@ -416,6 +626,8 @@ vx_threadpool_t *vxCreateThreadpool(vx_uint32 numThreads,
         pool->numWorkers = numThreads;
         pool->numWorkItems = numWorkItems;
         pool->sizeWorkItem = (uint32_t)sizeWorkItem;
+        pool->running = vx_true_e;
+        vxInitEvent(&pool->available, vx_false_e);
         vxInitEvent(&pool->completed, vx_false_e);
         pool->workers = (vx_threadpool_worker_t *)calloc(pool->numWorkers, sizeof(vx_threadpool_worker_t));
         if (pool->workers)
@@ -424,11 +636,16 @@ vx_threadpool_t *vxCreateThreadpool(vx_uint32 numThreads,
             for (i = 0u; i < pool->numWorkers; i++)
             {
                 vx_threadpool_worker_t *pool_worker = &pool->workers[i];
-                pool_worker->queue = vxCreateQueue();
+                vxInitDeque(&pool_worker->deque);
                 pool_worker->index = i;
                 pool_worker->arg = tmp_arg;
                 pool_worker->function = worker;
                 pool_worker->pool = pool; /* back reference to top level info */
+            }
+            /* all the deques must exist before any worker can try to steal */
+            for (i = 0u; i < pool->numWorkers; i++)
+            {
+                vx_threadpool_worker_t *pool_worker = &pool->workers[i];
                 vxInitPerf(&pool_worker->perf);
                 vxStartCapture(&pool_worker->perf); /* capture the launch latency */
                 pool_worker->handle = vxCreateThread(&vxWorkerThreadpool, pool_worker);
@@ -438,41 +655,50 @@ vx_threadpool_t *vxCreateThreadpool(vx_uint32 numThreads,
     return pool;
 }
 
-vx_bool vxIssueThreadpool(vx_threadpool_t *pool, vx_value_set_t workitems[], uint32_t numWorkItems)
+vx_bool vxIssueThreadpool(vx_threadpool_t *pool, vx_value_set_t *workitems, uint32_t numWorkItems)
 {
     uint32_t i;
-    vx_bool wrote = vx_false_e;
+    vx_bool wrote = vx_true_e;
+    vx_threadpool_worker_t *self = (current_worker && current_worker->pool == pool ? current_worker : NULL);
 
-    vxSemWait(&pool->sem);
-    vxResetEvent(&pool->completed); /* we're going to have items to work on, so clear the event */
     for (i = 0u; i < numWorkItems; i++)
     {
-        uint32_t index = 0xFFFFFFFFu;
-        uint32_t count = 0u; /* cycle-detector */
-        /* issue the work to the next workers_get, but don't wait if it's full */
-        do {
-            count++;
-            index = pool->nextWorkerIndex;
-            pool->nextWorkerIndex = (pool->nextWorkerIndex + 1u) % pool->numWorkers;
-            pool->numCurrentItems++;
-            wrote = vxWriteQueue(pool->workers[index].queue, &workitems[i]);
-            if (wrote == vx_false_e)
-            {
-                pool->numCurrentItems--;
-            }
-        } while ((wrote == vx_false_e) && (count < pool->numWorkers));
-        /* there's too much work to do, there's an overflow condition. some of the work may have been issued, others not. */
+        /* count the item as outstanding before any worker can complete it */
+        vxAtomicAdd(&pool->numCurrentItems, 1);
+        /* a worker issuing work keeps it in its own deque, where others may steal it */
+        if (self && vxPushDeque(&self->deque, &workitems[i]) == vx_true_e)
+        {
+            vxAtomicAdd(&pool->numQueuedItems, 1);
+            continue;
+        }
+        vxSemWait(&pool->sem);
+        if (pool->numInjected < VX_INT_MAX_DEQUE_DEPTH)
+        {
+            pool->injected[(pool->injectedStart + pool->numInjected) % VX_INT_MAX_DEQUE_DEPTH] = &workitems[i];
+            vxAtomicStore(&pool->numInjected, pool->numInjected + 1u);
+            vxAtomicAdd(&pool->numQueuedItems, 1);
+        }
+        else
+        {
+            wrote = vx_false_e;
+        }
+        vxSemPost(&pool->sem);
         if (wrote == vx_false_e)
         {
+            /* there's too much work to do, some of the work may have been issued, others not. */
+            if (vxAtomicAdd(&pool->numCurrentItems, -1) == 0u)
+            {
+                vxSemWait(&pool->sem);
+                vxSetEvent(&pool->completed);
+                vxSemPost(&pool->sem);
+            }
             break;
         }
     }
 
-    /* if none of the writes worked for whatever reason, and we didn't have any previous pending work (how?) then set the completed event */
-    if (pool->numCurrentItems == 0)
-    {
-        vxSetEvent(&pool->completed);
-    }
+    /* wake the sleeping workers */
+    vxSemWait(&pool->sem);
+    vxSetEvent(&pool->available);
     vxSemPost(&pool->sem);
     return wrote;
 }
@@ -482,11 +708,23 @@ vx_bool vxCompleteThreadpool(vx_threadpool_t *pool, vx_bool blocking)
     vx_bool ret = vx_false_e;
     if (blocking)
     {
-        ret = vxWaitEvent(&pool->completed, VX_INT_FOREVER);
+        /* the event is only reset under the lock while items are outstanding,
+         * the last worker to complete sets it under the same lock.
+         */
+        vxSemWait(&pool->sem);
+        while (vxAtomicLoad(&pool->numCurrentItems) > 0u)
+        {
+            vxResetEvent(&pool->completed);
+            vxSemPost(&pool->sem);
+            vxWaitEvent(&pool->completed, VX_INT_FOREVER);
+            vxSemWait(&pool->sem);
+        }
+        vxSemPost(&pool->sem);
+        ret = vx_true_e;
     }
     else
     {
-        if (pool->numCurrentItems == 0)
+        if (vxAtomicLoad(&pool->numCurrentItems) == 0u)
         {
             ret = vx_true_e;
         }
@@ -494,6 +732,121 @@ vx_bool vxCompleteThreadpool(vx_threadpool_t *pool, vx_bool blocking)
     return ret;
 }
 
+/*! \brief The shared state of a \ref vxParallelLoop. */
+typedef struct _vx_loop_t {
+    vx_loop_f function;
+    void *arg;
+    vx_uint32 count;
+    /*! \brief The next index to claim */
+    volatile vx_uint32 next;
+    /*! \brief The number of indexes which have been completed */
+    volatile vx_uint32 done;
+    /*! \brief The caller and the issued helpers which may still touch the loop */
+    volatile vx_uint32 refs;
+    vx_sem_t lock;
+    vx_event_t finished;
+    /*! \brief The work items of the helpers */
+    vx_value_set_t items[1];
+} vx_loop_t;
+
+static void vxRunLoop(vx_loop_t *loop)
+{
+    for (;;)
+    {
+        vx_uint32 index = vxAtomicAdd(&loop->next, 1) - 1u;
+        if (index >= loop->count)
+            break;
+        loop->function(loop->arg, index);
+        if (vxAtomicAdd(&loop->done, 1) == loop->count)
+        {
+            vxSemWait(&loop->lock);
+            vxSetEvent(&loop->finished);
+            vxSemPost(&loop->lock);
+        }
+    }
+}
+
+static void vxReleaseLoop(vx_loop_t *loop, vx_int32 refs)
+{
+    if (vxAtomicAdd(&loop->refs, -refs) == 0u)
+    {
+        vxDeinitEvent(&loop->finished);
+        vxDestroySem(&loop->lock);
+        free(loop);
+    }
+}
+
+static void vxLoopHelper(void *arg)
+{
+    vx_loop_t *loop = (vx_loop_t *)arg;
+    vxRunLoop(loop);
+    vxReleaseLoop(loop, 1);
+}
+
+vx_bool vxParallelLoop(vx_threadpool_t *pool, vx_uint32 count, vx_loop_f function, void *arg)
+{
+    vx_uint32 i, numHelpers = 0u;
+    vx_loop_t *loop = NULL;
+
+    if (count == 0u)
+        return vx_true_e;
+    if (pool)
+    {
+        /* the caller takes part in the loop, a worker caller leaves its own thread out */
+        numHelpers = pool->numWorkers - (vxIsThreadpoolWorker(pool) == vx_true_e ? 1u : 0u);
+        if (numHelpers > count - 1u)
+            numHelpers = count - 1u;
+    }
+    if (numHelpers > 0u)
+        loop = (vx_loop_t *)calloc(1, sizeof(vx_loop_t) + (numHelpers - 1u) * sizeof(vx_value_set_t));
+    if (loop == NULL)
+    {
+        for (i = 0u; i < count; i++)
+            function(arg, i);
+        return vx_true_e;
+    }
+
+    loop->function = function;
+    loop->arg = arg;
+    loop->count = count;
+    loop->refs = numHelpers + 1u;
+    vxCreateSem(&loop->lock, 1);
+    vxInitEvent(&loop->finished, vx_false_e);
+    for (i = 0u; i < numHelpers; i++)
+    {
+        loop->items[i].v1 = 0;
+        loop->items[i].v2 = (vx_value_t)vxLoopHelper;
+        loop->items[i].v3 = (vx_value_t)loop;
+        if (vxIssueThreadpool(pool, &loop->items[i], 1) == vx_false_e)
+        {
+            /* the caller completes the indexes the missing helpers would have claimed */
+            vxReleaseLoop(loop, (vx_int32)(numHelpers - i));
+            break;
+        }
+    }
+    vxRunLoop(loop);
+
+    /* helpers which start late find nothing to claim, only the indexes have to complete */
+    vxSemWait(&loop->lock);
+    while (vxAtomicLoad(&loop->done) < count)
+    {
+        vxResetEvent(&loop->finished);
+        vxSemPost(&loop->lock);
+        vxWaitEvent(&loop->finished, VX_INT_FOREVER);
+        vxSemWait(&loop->lock);
+    }
+    vxSemPost(&loop->lock);
+    vxReleaseLoop(loop, 1);
+    return vx_true_e;
+}
+
+vx_bool vxIsThreadpoolWorker(vx_threadpool_t *pool)
+{
+    if (current_worker && current_worker->pool == pool)
+        return vx_true_e;
+    else
+        return vx_false_e;
+}
 
 vx_uint64 vxCaptureTime()
 {
@@ -87,22 +87,88 @@ void vxInitReferenceForDelay(vx_reference ref, vx_delay d, vx_int32 slot_index)
 }
 
 
+/*! \brief Grows the reference table, pushing the new slots so that the lowest of them is
+ * taken first. Called with the reference lock held.
+ */
+static vx_bool vxGrowReferenceTable(vx_context context)
+{
+    vx_uint32 num = (context->num_reftable > 0u ? 2u * context->num_reftable : VX_INT_MAX_REF);
+    vx_reference *table = NULL;
+    vx_uint32 *free_slots = NULL, r;
+
+    if ((num <= context->num_reftable) || (num > VX_INT_MAX_REF_TABLE))
+        return vx_false_e;
+    table = (vx_reference *)realloc(context->reftable, num * sizeof(vx_reference));
+    if (table == NULL)
+        return vx_false_e;
+    context->reftable = table;
+    free_slots = (vx_uint32 *)realloc(context->reffree, num * sizeof(vx_uint32));
+    if (free_slots == NULL)
+        return vx_false_e;
+    context->reffree = free_slots;
+    for (r = num; r > context->num_reftable; r--)
+    {
+        context->reftable[r - 1u] = NULL;
+        context->reffree[context->num_reffree++] = r - 1u;
+    }
+    VX_PRINT(VX_ZONE_CONTEXT, "Grew the reference table from %u to %u slots\n", context->num_reftable, num);
+    context->num_reftable = num;
+    return vx_true_e;
+}
+
+/*! \brief Pops a free slot, called with the reference lock held. */
+static vx_bool vxTakeReferenceSlot(vx_context context, vx_uint32 *slot)
+{
+    if ((context->num_reffree == 0u) && (vxGrowReferenceTable(context) == vx_false_e))
+        return vx_false_e;
+    *slot = context->reffree[--context->num_reffree];
+    return vx_true_e;
+}
+
+vx_bool vxAllocReferenceSlot(vx_context context, vx_reference value, vx_uint32 *slot)
+{
+    vx_bool ret;
+    vxSemWait(&context->ref_lock);
+    ret = vxTakeReferenceSlot(context, slot);
+    if (ret == vx_true_e)
+        context->reftable[*slot] = value;
+    vxSemPost(&context->ref_lock);
+    return ret;
+}
+
+vx_uint32 vxFreeReferenceSlots(vx_context context, vx_reference value, vx_uint32 num)
+{
+    vx_uint32 r, count = 0u;
+    vxSemWait(&context->ref_lock);
+    /* freed from the top so that the lowest slot is taken again first */
+    for (r = context->num_reftable; (r > 0u) && (count < num); r--)
+    {
+        if (context->reftable[r - 1u] == value)
+        {
+            context->reftable[r - 1u] = NULL;
+            context->reffree[context->num_reffree++] = r - 1u;
+            count++;
+        }
+    }
+    vxSemPost(&context->ref_lock);
+    return count;
+}
+
 vx_bool vxAddReference(vx_context context, vx_reference ref)
 {
     vx_uint32 r;
     vx_bool ret = vx_false_e;
     if (context)
     {
-        for (r = 0; r < VX_INT_MAX_REF; r++)
+        vxSemWait(&context->ref_lock);
+        if (vxTakeReferenceSlot(context, &r) == vx_true_e)
         {
-            if (context->reftable[r] == NULL)
-            {
-                context->reftable[r] = ref;
-                context->num_references++;
-                ret = vx_true_e;
-                break;
-            }
+            context->reftable[r] = ref;
+            context->num_references++;
+            ref->slot = r;
+            ret = vx_true_e;
         }
+        vxSemPost(&context->ref_lock);
     }
     else{
         /* can't add context to itself */
@@ -265,15 +331,26 @@ vx_reference vxCreateReference(vx_context context, vx_enum type, vx_enum reftype
     return ref;
 }
 
+/*! \brief Checks that a reference belongs to a live context, without logging since the
+ * callers report the failure themselves.
+ */
+static VX_INLINE vx_bool vxHasValidContext(vx_reference ref)
+{
+    vx_context context = ref->context;
+    return ((context != NULL) &&
+            (context->base.magic == VX_MAGIC) &&
+            (context->base.type == VX_TYPE_CONTEXT) &&
+            (context->base.context == NULL) ? vx_true_e : vx_false_e);
+}
+
 vx_bool vxIsValidReference(vx_reference ref)
 {
     vx_bool ret = vx_false_e;
     if (ref != NULL)
     {
-        vxPrintReference(ref);
         if ((ref->magic == VX_MAGIC) &&
             (vxIsValidType(ref->type) && ref->type != VX_TYPE_CONTEXT) &&
-            (vxIsValidContext(ref->context) == vx_true_e))
+            (vxHasValidContext(ref) == vx_true_e))
         {
             ret = vx_true_e;
         }
@@ -303,7 +380,7 @@ vx_bool vxIsValidSpecificReference(vx_reference ref, vx_enum type)
         //vxPrintReference(ref);
         if ((ref->magic == VX_MAGIC) &&
             (ref->type == type) &&
-            (vxIsValidContext(ref->context) == vx_true_e))
+            (vxHasValidContext(ref) == vx_true_e))
         {
             ret = vx_true_e;
         }
@@ -325,17 +402,17 @@ vx_bool vxIsValidSpecificReference(vx_reference ref, vx_enum type)
 
 vx_bool vxRemoveReference(vx_context context, vx_reference ref)
 {
-    vx_uint32 r;
-    for (r = 0; r < VX_INT_MAX_REF; r++)
+    vx_bool ret = vx_false_e;
+    vxSemWait(&context->ref_lock);
+    if ((ref->slot < context->num_reftable) && (context->reftable[ref->slot] == ref))
     {
-        if (context->reftable[r] == ref)
-        {
-            context->reftable[r] = NULL;
-            context->num_references--;
-            return vx_true_e;
-        }
+        context->reftable[ref->slot] = NULL;
+        context->reffree[context->num_reffree++] = ref->slot;
+        context->num_references--;
+        ret = vx_true_e;
     }
-    return vx_false_e;
+    vxSemPost(&context->ref_lock);
+    return ret;
 }
 
 void vxPrintReference(vx_reference ref)
@@ -45,6 +45,16 @@ VX_API_ENTRY vx_remap VX_API_CALL vxCreateRemap(vx_context context,
                 remap->memory.dims[0][VX_DIM_X] = dst_width;
                 remap->memory.dims[0][VX_DIM_Y] = dst_height;
                 remap->memory.strides[0][VX_DIM_C] = sizeof(vx_float32);
+                remap->compact.ndims = 3;
+                remap->compact.nptrs = 2;
+                remap->compact.dims[0][VX_DIM_C] = 2; // 2 "channels" of s16
+                remap->compact.dims[0][VX_DIM_X] = dst_width;
+                remap->compact.dims[0][VX_DIM_Y] = dst_height;
+                remap->compact.strides[0][VX_DIM_C] = sizeof(vx_int16);
+                remap->compact.dims[1][VX_DIM_C] = 1;
+                remap->compact.dims[1][VX_DIM_X] = dst_width;
+                remap->compact.dims[1][VX_DIM_Y] = dst_height;
+                remap->compact.strides[1][VX_DIM_C] = sizeof(vx_uint16);
             }
         }
         else
@@ -61,6 +71,60 @@ void vxDestructRemap(vx_reference ref)
 {
     vx_remap remap = (vx_remap_t *)ref;
     vxFreeMemory(remap->base.context, &remap->memory);
+    vxFreeMemory(remap->base.context, &remap->compact);
+}
+
+/*! \brief Splits a source coordinate into its whole pixel and fraction, clamping it
+ * to [-2, size] where every tap it samples is still outside of the source.
+ */
+static vx_int32 vxCompactRemapCoordinate(vx_float32 v, vx_uint32 size)
+{
+    vx_float32 q = floorf(v * (1 << VX_REMAP_FRAC_BITS));
+    if (!(q >= (vx_float32)(-(2 << VX_REMAP_FRAC_BITS)))) /* also catches NaN */
+        return -(2 << VX_REMAP_FRAC_BITS);
+    if (q > (vx_float32)(size << VX_REMAP_FRAC_BITS))
+        return (vx_int32)size << VX_REMAP_FRAC_BITS;
+    return (vx_int32)q;
+}
+
+vx_bool vxCompactRemap(vx_remap remap)
+{
+    vx_bool compact = vx_false_e;
+    /* the whole pixels are signed 16 bit, with room for the clamped coordinates */
+    if ((remap->src_width >= INT16_MAX) || (remap->src_height >= INT16_MAX) ||
+        (remap->memory.allocated == vx_false_e))
+        return vx_false_e;
+
+    vxSemWait(&remap->base.lock);
+    if ((remap->compact.allocated == vx_true_e) &&
+        (remap->compact_count == remap->base.write_count))
+    {
+        compact = vx_true_e;
+    }
+    else if (vxAllocateMemory(remap->base.context, &remap->compact) == vx_true_e)
+    {
+        vx_uint32 x, y;
+        for (y = 0u; y < remap->dst_height; y++)
+        {
+            vx_float32 *coords = vxFormatMemoryPtr(&remap->memory, 0, 0, y, 0);
+            vx_int16 *whole = vxFormatMemoryPtr(&remap->compact, 0, 0, y, 0);
+            vx_uint16 *fracs = vxFormatMemoryPtr(&remap->compact, 0, 0, y, 1);
+            for (x = 0u; x < remap->dst_width; x++)
+            {
+                vx_int32 qx = vxCompactRemapCoordinate(coords[2*x + 0], remap->src_width);
+                vx_int32 qy = vxCompactRemapCoordinate(coords[2*x + 1], remap->src_height);
+                whole[2*x + 0] = (vx_int16)(qx >> VX_REMAP_FRAC_BITS);
+                whole[2*x + 1] = (vx_int16)(qy >> VX_REMAP_FRAC_BITS);
+                fracs[x] = (vx_uint16)((qx & VX_REMAP_FRAC_MASK) |
+                                       ((qy & VX_REMAP_FRAC_MASK) << VX_REMAP_FRAC_BITS));
+            }
+        }
+        remap->compact_count = remap->base.write_count;
+        compact = vx_true_e;
+        VX_PRINT(VX_ZONE_INFO, "Built the compact form of remap %p\n", remap);
+    }
+    vxSemPost(&remap->base.lock);
+    return compact;
 }
 
 VX_API_ENTRY vx_status VX_API_CALL vxReleaseRemap(vx_remap *r)
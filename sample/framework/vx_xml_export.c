@@ -861,7 +861,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxExportToXML(vx_context context, vx_char xml
     }
 
     /* check the number */
-    if (numrefs == 0 || numrefs > VX_INT_MAX_REF)
+    if (numrefs == 0)
         return VX_ERROR_NOT_SUPPORTED;
 
     /* create the temp renamer */
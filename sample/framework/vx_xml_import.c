@@ -171,14 +171,9 @@ static vx_status vxReserveReferences(vx_context context, vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
     vx_uint32 r, count = 0;
-    for (r = 0u; (r < VX_INT_MAX_REF) && (count < num); r++)
-    {
-        if (context->reftable[r] == NULL) {
-            /* 1 is used as a flag that this is reserved since it is not a valid handle */
-            context->reftable[r] = (vx_reference)1;
-            count++;
-        }
-    }
+    /* 1 is used as a flag that this is reserved since it is not a valid handle */
+    while ((count < num) && (vxAllocReferenceSlot(context, (vx_reference)1, &r) == vx_true_e))
+        count++;
     if (count == num)
         status = VX_SUCCESS;
 
@@ -190,16 +185,8 @@ static vx_status vxReserveReferences(vx_context context, vx_uint32 num)
 static vx_status vxReleaseReferences(vx_context context, vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
-    vx_uint32 r, count = 0;
-    for (r = 0u; (r < VX_INT_MAX_REF) && (count < num); r++)
-    {
-        if (context->reftable[r] == (vx_reference)1) {
-            /* 1 is used as a flag that this is reserved since it is not a valid handle */
-            context->reftable[r] = NULL;
-            count++;
-        }
-    }
-    if (count == num)
+    /* 1 is used as a flag that this is reserved since it is not a valid handle */
+    if (vxFreeReferenceSlots(context, (vx_reference)1, num) == num)
         status = VX_SUCCESS;
 
     return status;
@@ -1114,7 +1101,7 @@ VX_API_ENTRY vx_import VX_API_CALL vxImportFromXML(vx_context context,
     }
 
     total = xml_prop_ulong(cur, "references");
-    if (total > VX_INT_MAX_REF) {
+    if (total > VX_INT_MAX_REF_TABLE) {
         VX_PRINT(VX_ZONE_ERROR, "Total references = %d too high for this implementation\n", total);
         vxAddLogEntry(&context->base, VX_ERROR_INVALID_FORMAT, "Total references = %d too high for this implementation\n", total);
         import = (vx_import)vxGetErrorObject(context, VX_ERROR_INVALID_FORMAT);
@@ -83,6 +83,12 @@ vx_bool vxFindAccessor(vx_context context, void *ptr, vx_uint32 *pIndex);
  */
 void vxRemoveAccessor(vx_context context, vx_uint32 index);
 
+/*! \brief Adds a graph to the queue of the graph processors, growing the
+ * queue if needed.
+ * \ingroup group_int_context
+ */
+vx_bool vxSubmitGraph(vx_context context, vx_graph graph);
+
 #ifdef __cplusplus
 }
 #endif
@@ -111,6 +111,47 @@ void vxFindNextNodes(vx_graph graph,
                       vx_uint32 next_nodes[VX_INT_MAX_REF], vx_uint32 *numNext,
                       vx_uint32 left_nodes[VX_INT_MAX_REF], vx_uint32 *numLeft);
 
+/*! \brief Called by the threadpool workers to hand a completed node back to the
+ * executor of the graph, which then releases the node's successors.
+ * \param [in] graph The graph which owns the node.
+ * \param [in] work The work item which was processed.
+ * \ingroup group_int_graph
+ */
+void vxPostNodeCompletion(vx_graph graph, vx_value_set_t *work);
+
+/*! \brief Determines if the calling thread executes a graph, either a node of it or
+ * the graph itself, rather than running the application.
+ * \param [in] context The context of the graph.
+ * \ingroup group_int_graph
+ */
+vx_bool vxIsExecutingGraph(vx_context_t *context);
+
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+/*! \brief Executes the outstanding frames of a pipelined graph on the calling
+ * graph processor, returning once no frame is left to execute.
+ * \param [in] graph The graph with a pipeline depth greater than one.
+ * \ingroup group_int_graph
+ */
+void vxExecutePipeline(vx_graph graph);
+#endif
+
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+/*! \brief Holds the handles of the images the nodes of a graph use for one execution.
+ * \param [in] graph The graph.
+ * \param [in] frame The pipelined frame whose references override the node parameters, or NULL.
+ * \param [out] held The NULL terminated list of the held images, NULL if there are none.
+ * \ingroup group_int_graph
+ */
+vx_status vxHoldGraphHandles(vx_graph graph, vx_graph_frame_t *frame, vx_image **held);
+
+/*! \brief Releases exactly the handles \ref vxHoldGraphHandles held, even if the
+ * parameters of the graph changed since.
+ * \param [in,out] held The list of held images, set to NULL.
+ * \ingroup group_int_graph
+ */
+void vxReleaseGraphHandles(vx_image **held);
+#endif
+
 /*! \brief This function finds all graph which contain input or bidirectional
  * access to the reference and marks them as unverified.
  * \param [in] ref The reference structure.
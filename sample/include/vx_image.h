@@ -104,6 +104,32 @@ void vxPrintImage(vx_image image);
  */
 void vxDestructImage(vx_reference ref);
 
+/*! \brief Determines if the application, rather than an executing graph, holds
+ * an access to the image which an access with the usage would wait for.
+ * \param [in] image The image.
+ * \param [in] usage The \ref vx_accessor_e of the access.
+ * \ingroup group_int_image
+ */
+vx_bool vxIsImageHeldByApplication(vx_image image, vx_enum usage);
+
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+/*! \brief Returns the image created from a handle which a reference addresses,
+ * the reference itself or the image it is a region of, if any.
+ * \param [in] ref The reference used by a graph execution.
+ * \ingroup group_int_image
+ */
+vx_image vxLocateImageHandle(vx_reference ref);
+
+/*! \brief Holds or releases the handle of an image created from a handle. A hold
+ * also keeps an internal reference to the image. Releasing the last hold applies
+ * a pending swap.
+ * \param [in] image The image returned by \ref vxLocateImageHandle.
+ * \param [in] hold vx_true_e to hold the handle, vx_false_e to release it.
+ * \ingroup group_int_image
+ */
+void vxHoldImageHandle(vx_image image, vx_bool hold);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
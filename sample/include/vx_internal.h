@@ -91,6 +91,15 @@
 #if defined(EXPERIMENTAL_USE_VARIANTS)
 #include <VX/vx_khr_variants.h>
 #endif
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+#include <VX/vx_ext_pipelining.h>
+#endif
+#if defined(EXPERIMENTAL_USE_MEMORY_PLAN)
+#include <VX/vx_ext_memory_plan.h>
+#endif
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+#include <VX/vx_ext_image_handle.h>
+#endif
 
 #include <VX/vx_lib_extras.h>
 
@@ -129,11 +138,18 @@
  */
 #define VX_INT_MAX_NODES    (256)
 
-/*! \brief Maximum number of references in the context.
+/*! \brief Maximum number of references in the fixed size tables of graphs and queues.
+ * The reference table of the context starts with this many slots and grows as needed.
  * \ingroup group_int_defines
  */
 #define VX_INT_MAX_REF      (1024)
 
+/*! \brief Maximum number of slots the reference table of the context can grow to,
+ * doubling from \ref VX_INT_MAX_REF.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_REF_TABLE (0x80000000u)
+
 /*! \brief Maximum number of user defined structs/
  * \ingroup group_int_defines
  */
@@ -169,6 +185,12 @@
  */
 #define VX_INT_MAX_QUEUE_DEPTH (32)
 
+/*! \brief Maximum depth of the work-stealing deques of the threadpool workers.
+ * \note This must be a power of two.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_DEQUE_DEPTH (1024)
+
 /*! \brief The value to use in event waiting which never returns.
  * \ingroup group_int_defines
  */
@@ -179,6 +201,57 @@
  */
 #define VX_INT_HOST_CORES (TARGET_NUM_CORES)
 
+/*! \brief The number of threads which execute scheduled graphs concurrently.
+ * \ingroup group_int_defines
+ */
+#ifndef VX_INT_GRAPH_PROCESSORS
+#define VX_INT_GRAPH_PROCESSORS (VX_INT_HOST_CORES)
+#endif
+
+/*! \brief The initial depth of the scheduled graph queue, it grows on demand.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_GRAPH_QUEUE_DEPTH (16)
+
+/*! \brief The maximum number of frames which may be outstanding on a pipelined graph.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_PIPELINE_DEPTH (4)
+
+/*! \brief The alignment of the objects placed in the arena of a graph's memory plan.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_ARENA_ALIGNMENT (64)
+
+/*! \brief The alignment of the planes allocated from the memory pool of the context,
+ * and of the rows of the image planes.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MEMORY_ALIGNMENT (64)
+
+/*! \brief The number of size classes of the memory pool. There are four classes per
+ * power of two, the largest holds blocks of 2GB, larger blocks are not pooled.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_POOL_CLASSES (101)
+
+/*! \brief The most bytes the memory pool keeps for reuse, the blocks freed beyond
+ * this are returned to the system.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_POOL_MAX_CACHED (256*1024*1024)
+
+/*! \brief The size of a huge page, the blocks of at least this size are backed by
+ * huge pages when OPENVX_USE_HUGE_PAGES is defined.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_HUGE_PAGE_SIZE (2*1024*1024)
+
+/*! \brief The maximum number of tiling nodes which are executed tile by tile as one chain.
+ * \ingroup group_int_defines
+ */
+#define VX_INT_MAX_TILE_CHAIN (8)
+
 /*! \brief The largest optical flow pyr LK window.
  * \ingroup group_int_defines
  */
@@ -219,10 +292,12 @@
 
 #if defined(_WIN32) && !defined(__GNUC__)
 #define VX_INLINE _inline
+#define VX_THREAD_LOCAL __declspec(thread)
 //#define VX_FMT_TIME   "%I64d"    // Show the perf stats in seconds.
 #define VX_FMT_TIME   "%.3Lf"    // Show the perf stats in milliseconds.
 #else
 #define VX_INLINE inline
+#define VX_THREAD_LOCAL __thread
 #if (defined(__x86_64) || defined(__amd64)) && !defined(__APPLE__) // 64 bit
 //#define VX_FMT_TIME   "%lu"      // Show the perf stats in seconds.
 #define VX_FMT_TIME   "%.3f"     // Show the perf stats in milliseconds.
@@ -368,13 +443,38 @@ typedef struct _vx_queue_t {
     vx_bool popped;
 } vx_queue_t;
 
-/*! \brief The processor structure which contains the graph queue.
+/*! \brief The work-stealing deque object (Chase-Lev). The owning worker pushes
+ * and pops at the bottom without locking, other workers steal from the top.
+ * \ingroup group_int_osal
+ */
+typedef struct _vx_deque_t {
+    vx_value_set_t * volatile data[VX_INT_MAX_DEQUE_DEPTH];
+    volatile vx_uint32 top;
+    volatile vx_uint32 bottom;
+} vx_deque_t;
+
+/*! \brief The processor structure which contains the graph queue and the pool of
+ * threads which execute the scheduled graphs.
  * \ingroup group_int_context
  */
 typedef struct _vx_processor_t {
-    vx_queue_t input;
-    vx_queue_t output;
-    vx_thread_t thread;
+    /*! \brief The ring of scheduled graphs which wait for a free thread */
+    vx_graph *queue;
+    /*! \brief The allocated number of entries in the queue */
+    vx_uint32 capacity;
+    /*! \brief The index of the oldest entry in the queue */
+    vx_uint32 start;
+    /*! \brief The number of valid entries in the queue */
+    vx_uint32 count;
+    /*! \brief The lock which protects the queue */
+    vx_sem_t lock;
+    /*! \brief The event which indicates that the queue may not be empty */
+    vx_event_t available;
+    /*! \brief The array of graph processing threads */
+    vx_thread_t *threads;
+    /*! \brief The number of graph processing threads */
+    vx_uint32 numThreads;
+    /*! \brief Indicates whether the threads should keep running */
     vx_bool running;
 } vx_processor_t;
 
@@ -393,12 +493,24 @@ typedef struct _vx_target *vx_target;
  */
 typedef vx_bool (*vx_threadpool_f)(struct _vx_threadpool_worker_t *worker);
 
+/*! \brief The function of a task issued to a threadpool. A work item with a zero
+ * <tt>v1</tt> is a task, which calls <tt>v2</tt> with the argument <tt>v3</tt> in
+ * place of the worker function of the pool.
+ * \ingroup group_threadpools
+ */
+typedef void (*vx_task_f)(void *arg);
+
+/*! \brief The body of a \ref vxParallelLoop, called once per index.
+ * \ingroup group_threadpools
+ */
+typedef void (*vx_loop_f)(void *arg, vx_uint32 index);
+
 /*! \brief The structure given to each threadpool worker during execution.
  * \ingroup group_int_osal
  */
 typedef struct _vx_threadpool_worker_t {
-    /*! \brief The work queue */
-    vx_queue_t *queue;
+    /*! \brief The work deque owned by this worker, other workers steal from it */
+    vx_deque_t deque;
     /*! \brief The handle to the worker thread */
     vx_thread_t handle;
     /*! \brief The index of this worker in the pool */
@@ -427,14 +539,25 @@ typedef struct _vx_threadpool_t {
     uint32_t numWorkItems;
     /*! \brief Unit size of a work item */
     uint32_t sizeWorkItem;
-    /*! \brief The number of corrent items in the queue */
-     int32_t numCurrentItems;
+    /*! \brief The number of issued work items which have not completed yet */
+    volatile vx_uint32 numCurrentItems;
+    /*! \brief The number of issued work items which have not been claimed by a worker yet */
+    volatile vx_uint32 numQueuedItems;
     /*! \brief The array of workers */
     vx_threadpool_worker_t *workers;
-    /*! \brief The next index to submit work to */
-    uint32_t nextWorkerIndex;
-    /*! \brief The semaphore which protect access to the work queues */
+    /*! \brief The work items issued from outside of the pool, waiting to be claimed */
+    vx_value_set_t *injected[VX_INT_MAX_DEQUE_DEPTH];
+    /*! \brief The index of the oldest entry in \ref vx_threadpool_t::injected */
+    uint32_t injectedStart;
+    /*! \brief The number of valid entries in \ref vx_threadpool_t::injected, written under
+     * \ref vx_threadpool_t::sem and read atomically by the idle workers. */
+    volatile vx_uint32 numInjected;
+    /*! \brief Indicates whether the workers should keep running */
+    vx_bool running;
+    /*! \brief The semaphore which protects the injected items and the events */
     vx_sem_t sem;
+    /*! \brief The event which indicates that there may be work to claim */
+    vx_event_t available;
     /*! \brief The event which indicates that all work is completed */
     vx_event_t completed;
 } vx_threadpool_t;
@@ -507,6 +630,8 @@ typedef struct _vx_reference {
     vx_int32 delay_slot_index;
     /*! \brief This indicates that if the object is virtual whether it is accessible at the moment or not */
     vx_bool is_accessible;
+    /*! \brief The slot of the reference table of the context which holds this reference */
+    vx_uint32 slot;
 #if defined(EXPERIMENTAL_USE_OPENCL)
     /*! \brief An OpenCL event that the framework can block upon for this object */
     cl_event event;
@@ -856,6 +981,19 @@ typedef struct _vx_external_t {
     vx_bool used;
 } vx_external_t;
 
+/*! \brief The blocks which were freed to the memory pool of the context, kept in
+ * size classes for reuse.
+ * \ingroup group_int_memory
+ */
+typedef struct _vx_memory_pool_t {
+    /*! \brief The free blocks of each size class, linked through their first word */
+    void       *blocks[VX_INT_POOL_CLASSES];
+    /*! \brief The number of bytes in the free blocks */
+    vx_size     cached;
+    /*! \brief Protects the free blocks */
+    vx_sem_t    lock;
+} vx_memory_pool_t;
+
 /*! \brief The top level context data for the entire OpenVX instance
  * \ingroup group_int_context
  */
@@ -865,7 +1003,15 @@ typedef struct _vx_context {
     /*! \brief The pointer to process global lock */
     vx_sem_t*           p_global_lock;
     /*! \brief The reference table which contains the handle for later garage collection if needed */
-    vx_reference        reftable[VX_INT_MAX_REF];
+    vx_reference       *reftable;
+    /*! \brief The number of slots in the reference table, empty slots are NULL. */
+    vx_uint32           num_reftable;
+    /*! \brief The stack of the empty slots of the reference table. */
+    vx_uint32          *reffree;
+    /*! \brief The number of empty slots on the stack. */
+    vx_uint32           num_reffree;
+    /*! \brief Protects the reference table and its free slots. */
+    vx_sem_t            ref_lock;
     /*! \brief The number of references in the table. */
     vx_uint32           num_references;
     /*! \brief The array of kernel modules. */
@@ -894,6 +1040,8 @@ typedef struct _vx_context {
     vx_bool             log_reentrant;
     /*! \brief The list of externally accessed references */
     vx_external_t       accessors[VX_INT_MAX_REF];
+    /*! \brief The memory which the objects of the context allocate from */
+    vx_memory_pool_t    pool;
     /*! \brief The list of user defined structs. */
     struct {
         /*! \brief Type constant */
@@ -964,8 +1112,90 @@ typedef struct _vx_node {
     vx_graph            child;
     /*! \brief The node cost factors */
     vx_cost_factors_t   costs;
+    /*! \brief The number of nodes which produce data consumed by this node (computed during verification). */
+    vx_uint32           numPredecessors;
+    /*! \brief The indexes of the nodes which consume data produced by this node (computed during verification). */
+    vx_uint32          *successors;
+    /*! \brief The number of valid entries in \ref vx_node_t::successors. */
+    vx_uint32           numSuccessors;
+    /*! \brief The number of predecessors which have not yet completed in the current execution. */
+    vx_uint32           numPending;
+    /*! \brief The sequence number of the last pipelined frame this node has retired. */
+    vx_uint32           lastFrame;
+    /*! \brief Set when a pipelined frame of this node is on the threadpool. */
+    vx_bool             inFlight;
+    /*! \brief Set when this node writes an object which is not given a buffer per frame (computed during verification). */
+    vx_bool             writesShared;
+#ifdef OPENVX_KHR_TILING
+    /*! \brief The next node of the tile fused chain which this node heads or belongs to (computed during verification). */
+    struct _vx_node    *tileNext;
+    /*! \brief Set on the nodes of a tile fused chain which the head of the chain executes (computed during verification). */
+    vx_bool             tileFused;
+    /*! \brief Set by the head of the chain once it has executed this node in the current execution. */
+    vx_bool             tileDone;
+#endif
 } vx_node_t;
 
+/*! \brief The state of a node within one pipelined frame.
+ * \ingroup group_int_graph
+ */
+enum vx_frame_node_state_e {
+    /*! \brief The node is waiting on its predecessors or on the previous frame. */
+    VX_FRAME_NODE_WAITING = 0,
+    /*! \brief The node has been issued. */
+    VX_FRAME_NODE_ISSUED,
+    /*! \brief The node has completed. */
+    VX_FRAME_NODE_RETIRED,
+};
+
+/*! \brief The per frame state of a node of a pipelined graph.
+ * \ingroup group_int_graph
+ */
+typedef struct _vx_frame_node_t {
+    /*! \brief The work item issued to the threadpool for this node. */
+    vx_value_set_t      work;
+    /*! \brief The number of predecessors which have not yet retired in this frame. */
+    vx_uint32           numPending;
+    /*! \brief The \ref vx_frame_node_state_e of the node. */
+    vx_enum             state;
+    /*! \brief The references bound to the node parameters for this frame. */
+    vx_reference        parameters[VX_INT_MAX_PARAMS];
+} vx_frame_node_t;
+
+/*! \brief One slot of the frame ring of a pipelined graph.
+ * \ingroup group_int_graph
+ */
+typedef struct _vx_graph_frame_t {
+    /*! \brief The schedule order sequence number of the frame in this slot. */
+    vx_uint32           sequence;
+    /*! \brief Set once the pipeline executor has started the frame. */
+    vx_bool             started;
+    /*! \brief Set once every node of the frame has retired or been abandoned. */
+    vx_bool             finished;
+    /*! \brief The action which stops the frame, if any. */
+    vx_action           action;
+    /*! \brief The status of the frame once it is done. */
+    vx_status           status;
+    /*! \brief The number of nodes of the frame which have been issued. */
+    vx_uint32           numIssued;
+    /*! \brief The number of nodes of the frame which have been retired. */
+    vx_uint32           numRetired;
+    /*! \brief The per node state, one entry per node of the graph (allocated during verification). */
+    vx_frame_node_t    *nodes;
+    /*! \brief The graph parameter values captured when the frame was scheduled. */
+    vx_reference        parameters[VX_INT_MAX_PARAMS];
+    /*! \brief The virtual objects given to this slot, in pairs of original and copy. */
+    vx_reference       *virtuals;
+    /*! \brief The number of pairs in \ref vx_graph_frame_t::virtuals. */
+    vx_uint32           numVirtuals;
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    /*! \brief The NULL terminated list of image handles the frame holds, if any. */
+    vx_image           *held;
+#endif
+    /*! \brief This event is set when the frame is done. */
+    vx_event_t          done;
+} vx_graph_frame_t;
+
 /*! \brief The internal representation of a graph.
  * \ingroup group_int_graph
  */
@@ -994,11 +1224,53 @@ typedef struct _vx_graph {
         vx_node_t *node;
         /*! \brief The index to the parameter on the node. */
         vx_uint32  index;
+        /*! \brief The value the next pipelined frame will capture. */
+        vx_reference ref;
     } parameters[VX_INT_MAX_PARAMS];
     /*! \brief The number of graph parameters. */
     vx_uint32      numParams;
     /*! \brief A switch to turn off SMP mode */
     vx_bool        should_serialize;
+    /*! \brief This lock protects the list of completed work items during execution. */
+    vx_sem_t       completionLock;
+    /*! \brief This event is set by the workers each time a node completes. */
+    vx_event_t     completionEvent;
+    /*! \brief The work items which have completed but not yet been retired by the executor. */
+    vx_value_set_t *completed[VX_INT_MAX_REF];
+    /*! \brief The number of work items in the completed list. */
+    vx_uint32      numCompleted;
+    /*! \brief The status of the last scheduled execution. */
+    vx_status      scheduledStatus;
+    /*! \brief This event is set when a scheduled execution of the graph completes. */
+    vx_event_t     scheduledEvent;
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    /*! \brief The NULL terminated list of image handles the scheduled execution holds, if any. */
+    vx_image      *held;
+#endif
+    /*! \brief The number of frames which may be outstanding at once, 1 disables pipelining. */
+    vx_uint32      pipelineDepth;
+    /*! \brief The ring of pipelined frames, protected by \ref vx_graph_t::completionLock. */
+    vx_graph_frame_t frames[VX_INT_MAX_PIPELINE_DEPTH];
+    /*! \brief The slot of the oldest outstanding frame. */
+    vx_uint32      oldestFrame;
+    /*! \brief The number of outstanding frames, including ones done but not waited on. */
+    vx_uint32      numFrames;
+    /*! \brief The sequence number of the next scheduled frame. */
+    vx_uint32      nextSequence;
+    /*! \brief Set while a graph processor is executing the pipeline of this graph. */
+    vx_bool        pipelineActive;
+    /*! \brief This event is set once no graph processor is executing the pipeline. */
+    vx_event_t     pipelineStopped;
+    /*! \brief The storage shared by the virtual objects placed by the memory planner. */
+    vx_uint8      *arena;
+    /*! \brief The virtual objects which live in the arena. */
+    vx_reference  *planned;
+    /*! \brief The number of objects in \ref vx_graph_t::planned. */
+    vx_uint32      numPlanned;
+    /*! \brief The number of bytes in the arena. */
+    vx_size        plannedBytes;
+    /*! \brief The number of bytes the planned objects would need if allocated separately. */
+    vx_size        naiveBytes;
 } vx_graph_t;
 
 /*! \brief The dimensions enumeration, also stride enumerations.
@@ -1032,12 +1304,36 @@ enum vx_bounds_e {
  */
 #define VX_PLANE_MAX    (4)
 
+/*! \brief A rectangle of a plane of a memory object which is being accessed.
+ * \ingroup group_int_memory
+ */
+typedef struct _vx_rect_lock_t {
+    /*! \brief The accessed rectangle of the plane */
+    vx_rectangle_t rect;
+    /*! \brief The usage of the access, only \ref VX_READ_ONLY accesses share a rectangle */
+    vx_enum usage;
+    /*! \brief The pointer which was returned for the rectangle, it identifies the lock on release */
+    void *key;
+    /*! \brief Indicates if the rectangle is locked */
+    vx_bool used;
+    /*! \brief Identifies the thread which made the access */
+    void *owner;
+    /*! \brief Indicates if the access was made while a graph executed, rather than by the application */
+    vx_bool executing;
+    /*! \brief The number of threads waiting for the rectangle to be unlocked */
+    vx_uint32 waiters;
+    /*! \brief Posted once for each waiter when the rectangle is unlocked */
+    vx_sem_t released;
+} vx_rect_lock_t;
+
 /*! \brief The raw definition of memory layout.
  * \ingroup group_int_memory
  */
 typedef struct _vx_memory_t {
     /*! \brief Determines if this memory was allocated by the system */
     vx_bool        allocated;
+    /*! \brief Determines if the pointers are owned by the memory plan of a graph */
+    vx_bool        planned;
     /*! \brief The number of pointers in the array */
     vx_int32       nptrs;
     /*! \brief The array of pointers (one per plane for images) */
@@ -1048,10 +1344,21 @@ typedef struct _vx_memory_t {
     vx_int32       dims[VX_PLANE_MAX][VX_DIM_MAX];
     /*! \brief The per ptr stride values per dimension */
     vx_int32       strides[VX_PLANE_MAX][VX_DIM_MAX];
-    /*! \brief The write locks. Used by Access/Commit pairs on usages which have
-     * VX_WRITE_ONLY or VX_READ_AND_WRITE flag parts. Only single writers are permitted.
+    /*! \brief The alignment of the stride of the last dimension (the rows of an image), 0 for none */
+    vx_uint32      row_alignment;
+    /*! \brief The number of bytes taken from the memory pool per ptr */
+    vx_size        sizes[VX_PLANE_MAX];
+    /*! \brief The plane locks. An image plane's lock guards its access table, an
+     * array's lock is held for the whole of an access with a VX_WRITE_ONLY or
+     * VX_READ_AND_WRITE usage.
      */
     vx_sem_t locks[VX_PLANE_MAX];
+    /*! \brief The access table of each plane, see \ref vxLockRectangle. The entries
+     * are allocated one by one, so that waiters keep their semaphore when it grows.
+     */
+    vx_rect_lock_t **accesses[VX_PLANE_MAX];
+    /*! \brief The number of entries in each access table */
+    vx_uint32 num_accesses[VX_PLANE_MAX];
 #if defined(EXPERIMENTAL_USE_OPENCL)
     /*! \brief This contains the OpenCL memory references */
     cl_mem hdls[VX_PLANE_MAX];
@@ -1094,6 +1401,20 @@ typedef struct _vx_image {
     vx_rectangle_t region;
     /*! \brief The import type */
     vx_enum        import_type;
+    /*! \brief The number of patches accessed in copy mode which are not committed yet. */
+    vx_uint32      copies;
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    /*! \brief The number of graph executions which hold the handle. */
+    vx_uint32      holds;
+    /*! \brief Set when a swap waits on the holds to be released. */
+    vx_bool        swap_pending;
+    /*! \brief The plane pointers of the pending swap. */
+    void          *pending[VX_PLANE_MAX];
+    /*! \brief Called with the plane pointers the image no longer uses. */
+    vx_image_handle_f callback;
+    /*! \brief The user data given to \ref vx_image_t::callback. */
+    void          *user_data;
+#endif
 #if defined(EXPERIMENTAL_USE_OPENCL)
     /*! \brief This describes the type of OpenCL Image that maps to this image (if applicable). */
     cl_image_format cl_format;
@@ -1166,6 +1487,13 @@ typedef struct _vx_remap {
     vx_uint32 dst_width;
     /*! \brief Output Height */
     vx_uint32 dst_height;
+    /*! \brief The compact form of the map, the whole source pixels as vx_int16 pairs
+     * in plane 0 and their packed fractions as vx_uint16 in plane 1.
+     * \see vxCompactRemap
+     */
+    vx_memory_t compact;
+    /*! \brief The write count of the map when the compact form was built */
+    vx_uint32 compact_count;
 } vx_remap_t;
 
 /*! \brief A histogram.
@@ -36,6 +36,32 @@
 extern "C" {
 #endif
 
+/*! \brief Initializes the memory pool of the context.
+ * \ingroup group_int_memory
+ */
+void vxInitMemoryPool(vx_context_t *context);
+
+/*! \brief Returns the blocks kept by the memory pool of the context to the system.
+ * \ingroup group_int_memory
+ */
+void vxDeinitMemoryPool(vx_context_t *context);
+
+/*! \brief Takes a block from the memory pool of the context, aligned to
+ * \ref VX_INT_MEMORY_ALIGNMENT. Blocks of the same size class are reused.
+ * \param [in] context The context, may be NULL to bypass the pool.
+ * \param [in] size The number of bytes.
+ * \ingroup group_int_memory
+ */
+void *vxAllocatePooled(vx_context_t *context, vx_size size);
+
+/*! \brief Returns a block to the memory pool of the context.
+ * \param [in] context The context the block was taken with.
+ * \param [in] ptr The block.
+ * \param [in] size The number of bytes it was taken for.
+ * \ingroup group_int_memory
+ */
+void vxFreePooled(vx_context_t *context, void *ptr, vx_size size);
+
 /*! \brief Frees a memory block.
  * \ingroup group_int_memory
  */
@@ -46,6 +72,60 @@ vx_bool vxFreeMemory(vx_context_t *context, vx_memory_t *memory);
  */
 vx_bool vxAllocateMemory(vx_context_t *context, vx_memory_t *memory);
 
+/*! \brief Computes the strides of a plane of an unallocated memory block.
+ * \return The number of bytes the plane needs.
+ * \ingroup group_int_memory
+ */
+vx_size vxComputeMemoryLayout(vx_memory_t *memory, vx_int32 p);
+
+/*! \brief Points the planes of an unallocated memory block into storage which
+ * is owned by someone else, such as the arena of a graph's memory plan.
+ * \ingroup group_int_memory
+ */
+vx_bool vxBindMemory(vx_context_t *context, vx_memory_t *memory, vx_uint8 *ptrs[VX_PLANE_MAX]);
+
+/*! \brief Locks a rectangle of a plane of a memory block for an access.
+ * \details Blocks while an overlapping rectangle of the plane is locked, unless
+ * both accesses have a \ref VX_READ_ONLY usage. Readers share rectangles and
+ * writers of disjoint rectangles proceed concurrently. A thread never waits for
+ * a rectangle which it has locked itself, as nothing would unlock it.
+ * \param [in] context The context, which tells if the calling thread executes a graph.
+ * \param [in] memory The memory block, which owns the plane.
+ * \param [in] plane The plane index.
+ * \param [in] rect The rectangle in the coordinates of the memory block.
+ * \param [in] usage The \ref vx_accessor_e of the access.
+ * \param [in] key The pointer which identifies the lock to \ref vxUnlockRectangle.
+ * \retval VX_ERROR_NO_RESOURCES An overlapping rectangle is locked by the calling thread.
+ * \retval VX_ERROR_NO_MEMORY The access table of the plane could not grow.
+ * \ingroup group_int_memory
+ */
+vx_status vxLockRectangle(vx_context_t *context, vx_memory_t *memory, vx_uint32 plane, vx_rectangle_t *rect, vx_enum usage, void *key);
+
+/*! \brief Determines if the application, rather than an executing graph, has
+ * locked a rectangle of the plane which overlaps the given one and would keep an
+ * access with the given usage waiting.
+ * \ingroup group_int_memory
+ */
+vx_bool vxIsRectangleHeldByApplication(vx_memory_t *memory, vx_uint32 plane, vx_rectangle_t *rect, vx_enum usage);
+
+/*! \brief Unlocks a rectangle which was locked with the key.
+ * \details Readers whose rectangles start at the same pixel are given the same
+ * pointer, so the rectangle of the key with the size of rect is unlocked. Any
+ * other rectangle of the key is unlocked when none has that size.
+ * \param [in] memory The memory block, which owns the plane.
+ * \param [in] plane The plane index.
+ * \param [in] rect The committed rectangle in the coordinates of the memory block.
+ * \param [in] key The pointer which was given to \ref vxLockRectangle.
+ * \retval vx_false_e The key did not lock a rectangle of the plane.
+ * \ingroup group_int_memory
+ */
+vx_bool vxUnlockRectangle(vx_memory_t *memory, vx_uint32 plane, vx_rectangle_t *rect, void *key);
+
+/*! \brief Destroys the lock and the access table of a plane.
+ * \ingroup group_int_memory
+ */
+void vxDestroyPlaneLock(vx_memory_t *memory, vx_uint32 plane);
+
 void vxPrintMemory(vx_memory_t *mem);
 
 vx_size vxComputeMemorySize(vx_memory_t *memory, vx_uint32 p);
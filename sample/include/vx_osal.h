@@ -168,6 +168,56 @@ void vxPopQueue(vx_queue_t *q);
  */
 void vxDeinitQueue(vx_queue_t *q);
 
+/*! \brief Initializes an empty work-stealing deque.
+ * \ingroup group_int_osal
+ */
+void vxInitDeque(vx_deque_t *d);
+
+/*! \brief Pushes an item onto the bottom of the deque. Only the owner may call this.
+ * \return Returns vx_false_e if the deque is full.
+ * \ingroup group_int_osal
+ */
+vx_bool vxPushDeque(vx_deque_t *d, vx_value_set_t *data);
+
+/*! \brief Pops the most recently pushed item. Only the owner may call this.
+ * \return Returns NULL if the deque is empty or the last item was stolen.
+ * \ingroup group_int_osal
+ */
+vx_value_set_t *vxPopDeque(vx_deque_t *d);
+
+/*! \brief Steals the oldest item of the deque. Any thread may call this.
+ * \return Returns NULL if the deque is empty or another thread won the race.
+ * \ingroup group_int_osal
+ */
+vx_value_set_t *vxStealDeque(vx_deque_t *d);
+
+/*! \brief Atomically reads a value with acquire semantics.
+ * \ingroup group_int_osal
+ */
+vx_uint32 vxAtomicLoad(volatile vx_uint32 *ptr);
+
+/*! \brief Atomically writes a value with release semantics.
+ * \ingroup group_int_osal
+ */
+void vxAtomicStore(volatile vx_uint32 *ptr, vx_uint32 value);
+
+/*! \brief Atomically adds to a value.
+ * \return Returns the new value.
+ * \ingroup group_int_osal
+ */
+vx_uint32 vxAtomicAdd(volatile vx_uint32 *ptr, vx_int32 value);
+
+/*! \brief Atomically replaces the value with desired if it is equal to expected.
+ * \return Returns vx_true_e if the value was replaced.
+ * \ingroup group_int_osal
+ */
+vx_bool vxAtomicCompareExchange(volatile vx_uint32 *ptr, vx_uint32 expected, vx_uint32 desired);
+
+/*! \brief Issues a full memory barrier.
+ * \ingroup group_int_osal
+ */
+void vxMemoryFence(void);
+
 /*! \brief
  * \ingroup group_int_osal
  */
@@ -196,10 +246,24 @@ vx_threadpool_t *vxCreateThreadpool(vx_uint32 numThreads,
                                     vx_threadpool_f worker,
                                     void *arg);
 
-vx_bool vxIssueThreadpool(vx_threadpool_t *pool, vx_value_set_t workitems[], uint32_t numWorkItems);
+vx_bool vxIssueThreadpool(vx_threadpool_t *pool, vx_value_set_t *workitems, uint32_t numWorkItems);
 
 vx_bool vxCompleteThreadpool(vx_threadpool_t *pool, vx_bool blocking);
 
+/*! \brief Determines if the calling thread is one of the workers of the pool.
+ * \ingroup group_int_osal
+ */
+vx_bool vxIsThreadpoolWorker(vx_threadpool_t *pool);
+
+/*! \brief Calls the function once for each index in [0, count), spread over the
+ * workers of the pool and the calling thread.
+ * \details Returns once every index has completed. It may be called from a worker
+ * of the pool, since the caller claims indexes itself instead of waiting on the
+ * pool. With no pool the indexes are run in order on the calling thread.
+ * \ingroup group_int_osal
+ */
+vx_bool vxParallelLoop(vx_threadpool_t *pool, vx_uint32 count, vx_loop_f function, void *arg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -61,6 +61,27 @@ void vxInitReferenceForDelay(vx_reference ref, vx_delay_t *d, vx_int32 index);
  */
 vx_bool vxAddReference(vx_context context, vx_reference ref);
 
+/*! \brief Takes the most recently freed slot of the reference table of the context, or
+ * grows the table when no slot is free, taking the new slots in increasing order.
+ * The slot is filled under the reference lock, so that it is never seen empty.
+ * \param [in] context The system context.
+ * \param [in] value The value to store in the slot, which marks it as taken.
+ * \param [out] slot The index of the slot.
+ * \return vx_false_e if the table could not grow.
+ * \ingroup group_int_reference
+ */
+vx_bool vxAllocReferenceSlot(vx_context context, vx_reference value, vx_uint32 *slot);
+
+/*! \brief Empties up to a number of the slots of the reference table which hold a
+ * value, from the highest one down, so that the lowest is the next one to be taken.
+ * \param [in] context The system context.
+ * \param [in] value The value stored by \ref vxAllocReferenceSlot.
+ * \param [in] num The number of slots to empty.
+ * \return The number of slots emptied.
+ * \ingroup group_int_reference
+ */
+vx_uint32 vxFreeReferenceSlots(vx_context context, vx_reference value, vx_uint32 num);
+
 /*! \brief Used to create a reference.
  * \note This does not add the reference to the system context yet.
  * \param [in] context The system context.
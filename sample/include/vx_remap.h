@@ -43,6 +43,33 @@ extern "C" {
  */
 void vxDestructRemap(vx_reference ref);
 
+/*! \brief The number of fractional bits of each coordinate in the compact form of a remap.
+ * \ingroup group_int_remap
+ */
+#define VX_REMAP_FRAC_BITS  (5)
+
+/*! \brief The mask of one fraction in the packed fractions of the compact form.
+ * \ingroup group_int_remap
+ */
+#define VX_REMAP_FRAC_MASK  ((1 << VX_REMAP_FRAC_BITS) - 1)
+
+/*! \brief Brings the compact form of a remap up to date with its points.
+ * \details Each source coordinate is truncated to 1/32 of a pixel and split into
+ * its whole pixel, stored in plane 0 of <tt>remap->compact</tt> as a vx_int16 X and Y,
+ * and its fraction, stored in plane 1 as a vx_uint16 with the X fraction in the low
+ * \ref VX_REMAP_FRAC_BITS and the Y fraction above it. Coordinates far outside of the
+ * source are clamped to just outside of it, which samples the same border pixels.
+ * The form is only rebuilt when points were set since it was last built.
+ * Nearest neighbour sampling from the form is bit-exact with the float map. Bilinear
+ * sampling weighs the taps in 1/32 steps, which is up to 16 off on a full scale edge,
+ * so the c_model only uses the form for it when OPENVX_USE_FIXED_POINT_REMAP is defined.
+ * \param [in] remap The remap.
+ * \return vx_true_e when the compact form can be used, or vx_false_e when the source is too
+ * large for it or it could not be allocated.
+ * \ingroup group_int_remap
+ */
+vx_bool vxCompactRemap(vx_remap remap);
+
 #ifdef __cplusplus
 }
 #endif
@@ -34,6 +34,34 @@
 #include <c_model.h>
 
 
+/*! \brief The state shared by the bands of a corner search. Each band collects its
+ * corners in its own list, and the lists are appended to the array in band order.
+ */
+typedef struct _vx_fast9_loop_t {
+    void *src_base;
+    vx_imagepatch_addressing_t src_addr;
+    vx_uint8 tolerance;
+    vx_bool do_nonmax;
+    vx_uint32 numBands;
+    /*! \brief The score rows of each band */
+    vx_uint8 *scores;
+    /*! \brief The corner list of each band */
+    vx_keypoint_t *corners;
+    vx_size capacity;
+    /*! \brief The number of corners found by each band */
+    vx_uint32 *counts;
+} vx_fast9_loop_t;
+
+static void vxFast9Band(void *arg, vx_uint32 band)
+{
+    vx_fast9_loop_t *loop = (vx_fast9_loop_t *)arg;
+    vx_uint32 y0 = (vx_uint32)(((vx_uint64)loop->src_addr.dim_y * band) / loop->numBands);
+    vx_uint32 y1 = (vx_uint32)(((vx_uint64)loop->src_addr.dim_y * (band + 1u)) / loop->numBands);
+    loop->counts[band] = vxFast9Rows(loop->src_base, &loop->src_addr, loop->tolerance, loop->do_nonmax,
+                                     y0, y1, &loop->scores[band * 3u * loop->src_addr.dim_x],
+                                     &loop->corners[band * loop->capacity], loop->capacity);
+}
+
 static vx_status VX_CALLBACK vxFast9CornersKernel(vx_node node, vx_reference parameters[], vx_uint32 num)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
@@ -44,12 +72,71 @@ static vx_status VX_CALLBACK vxFast9CornersKernel(vx_node node, vx_reference par
         vx_scalar sens = (vx_scalar)parameters[1];
         vx_scalar nonm = (vx_scalar)parameters[2];
         vx_array points = (vx_array)parameters[3];
-        vx_scalar num_corners = (vx_scalar)parameters[4];
+        vx_scalar s_num_corners = (vx_scalar)parameters[4];
+        vx_threadpool_t *workers = node->base.context->workers;
+        vx_fast9_loop_t loop;
+        vx_rectangle_t rect;
+        vx_float32 b = 0.0f;
+        vx_size dst_capacity = 0;
+        vx_uint32 num_corners = 0;
+
+        memset(&loop, 0, sizeof(loop));
         status = vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &bordermode, sizeof(bordermode));
+        if (status != VX_SUCCESS)
+            return status;
+        /*! \todo implement other Fast9 Corners border modes */
+        if (bordermode.mode != VX_BORDER_MODE_UNDEFINED)
+            return VX_ERROR_NOT_IMPLEMENTED;
+
+        status |= vxGetValidRegionImage(src, &rect);
+        status |= vxAccessScalarValue(sens, &b);
+        status |= vxAccessScalarValue(nonm, &loop.do_nonmax);
+        /* remove any pre-existing points */
+        status |= vxTruncateArray(points, 0);
+        status |= vxQueryArray(points, VX_ARRAY_ATTRIBUTE_CAPACITY, &dst_capacity, sizeof(dst_capacity));
+        status |= vxAccessImagePatch(src, &rect, 0, &loop.src_addr, &loop.src_base, VX_READ_ONLY);
+        loop.tolerance = (vx_uint8)b;
         if (status == VX_SUCCESS)
         {
-            status = vxFast9Corners(src, sens, nonm, points, num_corners, &bordermode);
+            vx_uint32 band;
+            loop.numBands = (workers ? workers->numWorkers + 1u : 1u);
+            if (loop.numBands > loop.src_addr.dim_y)
+                loop.numBands = loop.src_addr.dim_y;
+            if (loop.numBands == 0u)
+                loop.numBands = 1u;
+            /* a band can not find more corners than it has pixels */
+            loop.capacity = (vx_size)loop.src_addr.dim_x * (loop.src_addr.dim_y / loop.numBands + 1u);
+            if (loop.capacity > dst_capacity)
+                loop.capacity = dst_capacity;
+            loop.scores = (vx_uint8 *)malloc(loop.numBands * 3u * loop.src_addr.dim_x);
+            loop.corners = (vx_keypoint_t *)malloc((loop.numBands * loop.capacity + 1u) * sizeof(vx_keypoint_t));
+            loop.counts = (vx_uint32 *)calloc(loop.numBands, sizeof(vx_uint32));
+            if (loop.scores && loop.corners && loop.counts)
+            {
+                vxParallelLoop(workers, loop.numBands, vxFast9Band, &loop);
+                for (band = 0u; band < loop.numBands; band++)
+                {
+                    vx_size count = loop.counts[band];
+                    if (count > loop.capacity)
+                        count = loop.capacity;
+                    if (count > dst_capacity - (num_corners < dst_capacity ? num_corners : dst_capacity))
+                        count = dst_capacity - (num_corners < dst_capacity ? num_corners : dst_capacity);
+                    if (count > 0u)
+                        status |= vxAddArrayItems(points, count, &loop.corners[band * loop.capacity], sizeof(vx_keypoint_t));
+                    num_corners += loop.counts[band];
+                }
+            }
+            else
+            {
+                status = VX_ERROR_NO_MEMORY;
+            }
+            free(loop.scores);
+            free(loop.corners);
+            free(loop.counts);
+            if (s_num_corners)
+                status |= vxCommitScalarValue(s_num_corners, &num_corners);
         }
+        status |= vxCommitImagePatch(src, NULL, 0, &loop.src_addr, loop.src_base);
     }
     return status;
 }
@@ -36,13 +36,105 @@
 
 #include <math.h>
 
+/*! \brief The state shared by the strips of a histogram or an equalization.
+ * \details Each strip counts its rows into its own bins, which are added together
+ * once every strip has completed, so the strips need no locks.
+ */
+typedef struct _vx_histogram_loop_t {
+    void *src_base;
+    vx_imagepatch_addressing_t src_addr;
+    void *dst_base;
+    vx_imagepatch_addressing_t dst_addr;
+    vx_df_image format;
+    vx_size offset;
+    vx_size range;
+    vx_uint32 window_size;
+    vx_size numBins;
+    vx_uint32 numStrips;
+    /*! \brief numStrips sets of numBins bins */
+    vx_uint32 *bins;
+    vx_uint8 table[256];
+} vx_histogram_loop_t;
+
+static void vxStripRows(vx_histogram_loop_t *loop, vx_uint32 strip, vx_uint32 *y0, vx_uint32 *y1)
+{
+    *y0 = (vx_uint32)(((vx_uint64)loop->src_addr.dim_y * strip) / loop->numStrips);
+    *y1 = (vx_uint32)(((vx_uint64)loop->src_addr.dim_y * (strip + 1u)) / loop->numStrips);
+}
+
+static void vxHistogramStrip(void *arg, vx_uint32 strip)
+{
+    vx_histogram_loop_t *loop = (vx_histogram_loop_t *)arg;
+    vx_uint32 y0, y1;
+    vxStripRows(loop, strip, &y0, &y1);
+    vxHistogramRows(loop->src_base, &loop->src_addr, loop->format, y0, y1,
+                    loop->offset, loop->range, loop->window_size, &loop->bins[strip * loop->numBins]);
+}
+
+static void vxLookupStrip(void *arg, vx_uint32 strip)
+{
+    vx_histogram_loop_t *loop = (vx_histogram_loop_t *)arg;
+    vx_uint32 y0, y1;
+    vxStripRows(loop, strip, &y0, &y1);
+    vxLookupRows(loop->src_base, &loop->src_addr, loop->dst_base, &loop->dst_addr, y0, y1, loop->table);
+}
+
+/*! \brief Counts the source of the loop with one strip per worker and the caller and
+ * adds the bins of the strips into hist.
+ */
+static vx_status vxHistogramStrips(vx_node node, vx_histogram_loop_t *loop, vx_uint32 *hist)
+{
+    vx_threadpool_t *workers = node->base.context->workers;
+    vx_uint32 s, b;
+
+    loop->numStrips = (workers ? workers->numWorkers + 1u : 1u);
+    if (loop->numStrips > loop->src_addr.dim_y)
+        loop->numStrips = loop->src_addr.dim_y;
+    if (loop->numStrips == 0u)
+        loop->numStrips = 1u;
+    loop->bins = (vx_uint32 *)calloc(loop->numStrips * loop->numBins, sizeof(vx_uint32));
+    if (loop->bins == NULL)
+        return VX_ERROR_NO_MEMORY;
+    vxParallelLoop(workers, loop->numStrips, vxHistogramStrip, loop);
+    for (b = 0u; b < loop->numBins; b++)
+    {
+        vx_uint32 sum = 0u;
+        for (s = 0u; s < loop->numStrips; s++)
+            sum += loop->bins[s * loop->numBins + b];
+        hist[b] = sum;
+    }
+    free(loop->bins);
+    loop->bins = NULL;
+    return VX_SUCCESS;
+}
+
 static vx_status VX_CALLBACK vxHistogramKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     if (num == 2)
     {
         vx_image src_image   = (vx_image) parameters[0];
         vx_distribution dist = (vx_distribution)parameters[1];
-        return vxHistogram(src_image, dist);
+        vx_histogram_loop_t loop;
+        vx_rectangle_t rect;
+        void *dist_ptr = NULL;
+        vx_status status = VX_SUCCESS;
+
+        memset(&loop, 0, sizeof(loop));
+        vxQueryImage(src_image, VX_IMAGE_ATTRIBUTE_FORMAT, &loop.format, sizeof(loop.format));
+        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_BINS, &loop.numBins, sizeof(loop.numBins));
+        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_RANGE, &loop.range, sizeof(loop.range));
+        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_OFFSET, &loop.offset, sizeof(loop.offset));
+        vxQueryDistribution(dist, VX_DISTRIBUTION_ATTRIBUTE_WINDOW, &loop.window_size, sizeof(loop.window_size));
+        status = vxGetValidRegionImage(src_image, &rect);
+        status |= vxAccessImagePatch(src_image, &rect, 0, &loop.src_addr, &loop.src_base, VX_READ_ONLY);
+        status |= vxAccessDistribution(dist, &dist_ptr, VX_WRITE_ONLY);
+        if (status == VX_SUCCESS)
+        {
+            status = vxHistogramStrips(node, &loop, (vx_uint32 *)dist_ptr);
+        }
+        status |= vxCommitDistribution(dist, dist_ptr);
+        status |= vxCommitImagePatch(src_image, NULL, 0, &loop.src_addr, loop.src_base);
+        return status;
     }
     return VX_ERROR_INVALID_PARAMETERS;
 }
@@ -53,12 +145,36 @@ static vx_status VX_CALLBACK vxEqualizeHistKernel(vx_node node, vx_reference *pa
     {
         vx_image src = (vx_image)parameters[0];
         vx_image dst = (vx_image)parameters[1];
-        return vxEqualizeHist(src, dst);
+        vx_histogram_loop_t loop;
+        vx_rectangle_t rect;
+        vx_status status = VX_SUCCESS;
+
+        memset(&loop, 0, sizeof(loop));
+        status = vxGetValidRegionImage(src, &rect);
+        status |= vxAccessImagePatch(src, &rect, 0, &loop.src_addr, &loop.src_base, VX_READ_ONLY);
+        status |= vxAccessImagePatch(dst, &rect, 0, &loop.dst_addr, &loop.dst_base, VX_WRITE_ONLY);
+        if (status == VX_SUCCESS)
+        {
+            /* the histogram of the first pass is only kept as the table of the second */
+            vx_uint32 hist[256];
+            loop.format = VX_DF_IMAGE_U8;
+            loop.range = 256u;
+            loop.window_size = 1u;
+            loop.numBins = 256u;
+            status = vxHistogramStrips(node, &loop, hist);
+            if (status == VX_SUCCESS)
+            {
+                vxEqualizeTable(hist, loop.src_addr.dim_x * loop.src_addr.dim_y, loop.table);
+                vxParallelLoop(node->base.context->workers, loop.numStrips, vxLookupStrip, &loop);
+            }
+        }
+        status |= vxCommitImagePatch(src, NULL, 0, &loop.src_addr, loop.src_base);
+        status |= vxCommitImagePatch(dst, &rect, 0, &loop.dst_addr, loop.dst_base);
+        return status;
     }
     return VX_ERROR_INVALID_PARAMETERS;
 }
 
-
 static vx_status VX_CALLBACK vxHistogramInputValidator(vx_node node, vx_uint32 index)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
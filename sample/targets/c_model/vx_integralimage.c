@@ -33,13 +33,103 @@
 #include <vx_internal.h>
 #include <c_model.h>
 
+/*! \brief The state shared by the bands of an integral image.
+ * \details The bands first sum the columns of their source rows. The integral row
+ * above each band follows from the sums of the bands above it, after which the
+ * bands compute their rows independently.
+ */
+typedef struct _vx_integral_loop_t {
+    void *src_base;
+    vx_imagepatch_addressing_t src_addr;
+    void *dst_base;
+    vx_imagepatch_addressing_t dst_addr;
+    vx_uint32 numBands;
+    /*! \brief The column sums of each band */
+    vx_uint32 *sums;
+    /*! \brief The integral row above each band */
+    vx_uint32 *above;
+} vx_integral_loop_t;
+
+static void vxBandRows(vx_integral_loop_t *loop, vx_uint32 band, vx_uint32 *y0, vx_uint32 *y1)
+{
+    *y0 = (vx_uint32)(((vx_uint64)loop->src_addr.dim_y * band) / loop->numBands);
+    *y1 = (vx_uint32)(((vx_uint64)loop->src_addr.dim_y * (band + 1u)) / loop->numBands);
+}
+
+static void vxColumnSumBand(void *arg, vx_uint32 band)
+{
+    vx_integral_loop_t *loop = (vx_integral_loop_t *)arg;
+    vx_uint32 y0, y1;
+    vxBandRows(loop, band, &y0, &y1);
+    vxColumnSumRows(loop->src_base, &loop->src_addr, y0, y1, &loop->sums[band * loop->src_addr.dim_x]);
+}
+
+static void vxIntegralBand(void *arg, vx_uint32 band)
+{
+    vx_integral_loop_t *loop = (vx_integral_loop_t *)arg;
+    vx_uint32 y0, y1;
+    vxBandRows(loop, band, &y0, &y1);
+    vxIntegralRows(loop->src_base, &loop->src_addr,
+                   vxFormatImagePatchAddress2d(loop->dst_base, 0, y0, &loop->dst_addr), &loop->dst_addr,
+                   y0, y1, (band > 0u ? &loop->above[band * loop->src_addr.dim_x] : NULL));
+}
+
 static vx_status VX_CALLBACK vxIntegralImageKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     if (num == 2)
     {
         vx_image src = (vx_image)parameters[0];
         vx_image dst = (vx_image)parameters[1];
-        return vxIntegralImage(src, dst);
+        vx_threadpool_t *workers = node->base.context->workers;
+        vx_integral_loop_t loop;
+        vx_rectangle_t rect;
+        vx_status status = VX_SUCCESS;
+
+        memset(&loop, 0, sizeof(loop));
+        status = vxGetValidRegionImage(src, &rect);
+        status |= vxAccessImagePatch(src, &rect, 0, &loop.src_addr, &loop.src_base, VX_READ_ONLY);
+        status |= vxAccessImagePatch(dst, &rect, 0, &loop.dst_addr, &loop.dst_base, VX_WRITE_ONLY);
+        if (status == VX_SUCCESS)
+        {
+            vx_uint32 width = loop.src_addr.dim_x;
+            loop.numBands = (workers ? workers->numWorkers + 1u : 1u);
+            if (loop.numBands > loop.src_addr.dim_y)
+                loop.numBands = loop.src_addr.dim_y;
+            if (loop.numBands == 0u)
+                loop.numBands = 1u;
+            if (loop.numBands > 1u)
+            {
+                loop.sums = (vx_uint32 *)calloc(2u * loop.numBands * width, sizeof(vx_uint32));
+                if (loop.sums == NULL)
+                    loop.numBands = 1u;
+            }
+            if (loop.numBands > 1u)
+            {
+                vx_uint32 b, x;
+                loop.above = &loop.sums[loop.numBands * width];
+                /* the last band has no band below it to sum its columns for */
+                vxParallelLoop(workers, loop.numBands - 1u, vxColumnSumBand, &loop);
+                for (b = 1u; b < loop.numBands; b++)
+                {
+                    vx_uint32 *cols = &loop.sums[(b - 1u) * width];
+                    vx_uint32 *above = &loop.above[b * width];
+                    vx_uint32 sum = 0u;
+                    for (x = 0u; x < width; x++)
+                    {
+                        /* accumulate the column sums down the bands, then take their prefix sums */
+                        if (b > 1u)
+                            cols[x] += loop.sums[(b - 2u) * width + x];
+                        sum += cols[x];
+                        above[x] = sum;
+                    }
+                }
+            }
+            vxParallelLoop(workers, loop.numBands, vxIntegralBand, &loop);
+            free(loop.sums);
+        }
+        status |= vxCommitImagePatch(src, NULL, 0, &loop.src_addr, loop.src_base);
+        status |= vxCommitImagePatch(dst, &rect, 0, &loop.dst_addr, loop.dst_base);
+        return status;
     }
     return VX_ERROR_INVALID_PARAMETERS;
 }
@@ -299,7 +299,7 @@ vx_kernel vxTargetAddTilingKernel(vx_target target,
     return (vx_kernel)kernel;
 }
 
-static vx_status vxGetPatchToTile(vx_image image, vx_rectangle_t *rect, vx_tile_t *tile)
+static vx_status vxGetPatchToTile(vx_image image, vx_rectangle_t *rect, vx_tile_t *tile, vx_enum usage)
 {
     vx_status status = VX_SUCCESS;
     vx_uint32 p = 0;
@@ -307,7 +307,7 @@ static vx_status vxGetPatchToTile(vx_image image, vx_rectangle_t *rect, vx_tile_
     for (p = 0; p < img->planes; p++)
     {
         tile->base[p] = NULL;
-        status = vxAccessImagePatch(image, rect, 0, &tile->addr[p], (void **)&tile->base[p], VX_READ_AND_WRITE);
+        status |= vxAccessImagePatch(image, rect, p, &tile->addr[p], (void **)&tile->base[p], usage);
     }
     return status;
 }
@@ -319,30 +319,271 @@ static vx_status vxSetTileToPatch(vx_image image, vx_rectangle_t *rect, vx_tile_
     vx_status status = VX_SUCCESS;;
     for (p = 0; p < img->planes; p++)
     {
-        status = vxCommitImagePatch(image, rect, 0, &tile->addr[p], tile->base[p]);
+        status |= vxCommitImagePatch(image, rect, p, &tile->addr[p], tile->base[p]);
     }
     return status;
 }
 
-vx_status VX_CALLBACK vxTilingKernel(vx_node node, vx_reference parameters[], vx_uint32 num)
-{
-    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+/*! \brief The state shared by the strips of a tiling node. */
+typedef struct _vx_tiling_loop_t {
+    vx_node node;
+    vx_uint32 num;
     vx_image images[VX_INT_MAX_PARAMS];
-    vx_uint32 ty = 0u, tx = 0u, p = 0u;
-    vx_rectangle_t rect;
+    /*! \brief The tiles with the image and neighborhood information, copied by each strip */
     vx_tile_t tiles[VX_INT_MAX_PARAMS];
-    void *params[VX_INT_MAX_PARAMS] = {NULL};
+    void *params[VX_INT_MAX_PARAMS];
     vx_enum dirs[VX_INT_MAX_PARAMS];
     vx_enum types[VX_INT_MAX_PARAMS];
+    vx_uint32 tile_size_y;
+    vx_uint32 width;
+    vx_uint32 height;
+    void *tile_memory;
+    vx_size size;
+    /*! \brief The status of the first strip which failed */
+    volatile vx_uint32 status;
+} vx_tiling_loop_t;
+
+/*! \brief Processes one strip of a tiling node, strips write disjoint rectangles of the outputs. */
+static void vxTilingStrip(void *arg, vx_uint32 index)
+{
+    vx_tiling_loop_t *loop = (vx_tiling_loop_t *)arg;
+    vx_tile_t tiles[VX_INT_MAX_PARAMS];
+    void *params[VX_INT_MAX_PARAMS];
+    vx_status status = VX_SUCCESS;
+    vx_rectangle_t rect;
+    vx_uint32 p = 0u;
+
+    rect.start_x = 0u;
+    rect.start_y = index * loop->tile_size_y;
+    rect.end_x = loop->width;
+    rect.end_y = rect.start_y + loop->tile_size_y;
+    if (rect.end_y > loop->height)
+        rect.end_y = loop->height;
+    for (p = 0u; p < loop->num; p++)
+    {
+        params[p] = loop->params[p];
+        if (loop->types[p] == VX_TYPE_IMAGE)
+        {
+            vx_enum usage = (loop->dirs[p] == VX_INPUT ? VX_READ_ONLY :
+                            (loop->dirs[p] == VX_OUTPUT ? VX_WRITE_ONLY : VX_READ_AND_WRITE));
+            tiles[p] = loop->tiles[p];
+            tiles[p].tile_x = rect.start_x;
+            tiles[p].tile_y = rect.start_y;
+            status |= vxGetPatchToTile(loop->images[p], &rect, &tiles[p], usage);
+            params[p] = &tiles[p];
+        }
+    }
+    if (status == VX_SUCCESS)
+    {
+        //printf("Calling Tile{%u,%u} with %s\n", rect.start_x, rect.start_y, ((vx_node_t *)loop->node)->kernel->name);
+        ((vx_node_t *)loop->node)->kernel->tiling_function(params, loop->tile_memory, loop->size);
+    }
+    else
+    {
+        //printf("Failed to get tile {%u, %u} (status = %d)\n", rect.start_x, rect.start_y, status);
+    }
+    for (p = 0u; p < loop->num; p++)
+    {
+        if (loop->types[p] == VX_TYPE_IMAGE)
+        {
+            if (loop->dirs[p] == VX_INPUT)
+            {
+                status |= vxSetTileToPatch(loop->images[p], 0, &tiles[p]);
+            }
+            else
+            {
+                status |= vxSetTileToPatch(loop->images[p], &rect, &tiles[p]);
+            }
+        }
+    }
+    if (status != VX_SUCCESS)
+    {
+        vxAtomicCompareExchange(&loop->status, (vx_uint32)VX_SUCCESS, (vx_uint32)status);
+    }
+}
+
+/*! \brief The state of one node of a tile fused chain. */
+typedef struct _vx_tile_stage_t {
+    vx_node_t *node;
+    vx_tile_t tiles[VX_INT_MAX_PARAMS];
+    void *params[VX_INT_MAX_PARAMS];
+    size_t scalars[VX_INT_MAX_PARAMS];
+    /*! \brief The first row after the rows of the outputs produced so far. */
+    vx_uint32 rows;
+    /*! \brief The end of the rows the node produces. */
+    vx_uint32 last;
+} vx_tile_stage_t;
+
+/*! \brief Points a tile at the full width rows [start_y, end_y) of an image. */
+static void vxGetStripOfImage(vx_image_t *img, vx_uint32 start_y, vx_uint32 end_y, vx_tile_t *tile)
+{
+    vx_uint32 p = 0;
+    tile->tile_x = 0u;
+    tile->tile_y = start_y;
+    for (p = 0; p < img->planes; p++)
+    {
+        vx_imagepatch_addressing_t *addr = &tile->addr[p];
+        addr->dim_x = img->width;
+        addr->dim_y = end_y - start_y;
+        addr->stride_x = img->memory.strides[p][VX_DIM_X];
+        addr->stride_y = img->memory.strides[p][VX_DIM_Y];
+        addr->step_x = img->scale[p][VX_DIM_X];
+        addr->step_y = img->scale[p][VX_DIM_Y];
+        addr->scale_x = VX_SCALE_UNITY / img->scale[p][VX_DIM_X];
+        addr->scale_y = VX_SCALE_UNITY / img->scale[p][VX_DIM_Y];
+        tile->base[p] = (vx_uint8 *)img->memory.ptrs[p] +
+                        addr->stride_y * ((start_y * addr->scale_y) / VX_SCALE_UNITY);
+    }
+}
+
+/*! \brief Executes a chain of tiling nodes linked by \ref vxVerifyGraph strip by strip.
+ * \details Each node produces every row whose neighborhood its predecessor in the
+ * chain has already produced, so the intermediate images are read back within a
+ * few strips of being written. With an undefined border a node only produces the
+ * rows whose neighborhood lies within the image.
+ */
+static vx_status vxTilingChain(vx_node_t *head)
+{
+    vx_tile_stage_t stages[VX_INT_MAX_TILE_CHAIN];
+    vx_uint32 s = 0u, p = 0u, numStages = 0u;
+    vx_uint32 height = 0u, strip = 0u;
+    vx_node_t *node = NULL;
+
+    for (node = head; (node != NULL) && (numStages < VX_INT_MAX_TILE_CHAIN); node = node->tileNext)
+    {
+        vx_tile_stage_t *stage = &stages[numStages++];
+        vx_signature_t *sig = &node->kernel->signature;
+        if ((node->attributes.borders.mode != VX_BORDER_MODE_UNDEFINED) &&
+            (node->attributes.borders.mode != VX_BORDER_MODE_SELF))
+        {
+            return VX_ERROR_NOT_SUPPORTED;
+        }
+        stage->node = node;
+        for (p = 0u; p < sig->num_parameters; p++)
+        {
+            stage->params[p] = NULL;
+            if (node->parameters[p] == NULL)
+            {
+                continue;
+            }
+            else if (sig->types[p] == VX_TYPE_IMAGE)
+            {
+                vx_image_t *img = (vx_image_t *)node->parameters[p];
+                vx_tile_t *tile = &stage->tiles[p];
+                /* as with vxQueryNode, the tiling attributes are the ones of the kernel */
+                tile->tile_block = node->kernel->attributes.blockinfo;
+                tile->neighborhood = node->kernel->attributes.nhbdinfo;
+                tile->image.width = img->width;
+                tile->image.height = img->height;
+                tile->image.format = img->format;
+                tile->image.planes = img->planes;
+                tile->image.space = img->space;
+                tile->image.range = img->range;
+                stage->params[p] = tile;
+                height = img->height;
+            }
+            else if (sig->types[p] == VX_TYPE_SCALAR)
+            {
+                vxAccessScalarValue((vx_scalar)node->parameters[p], (void *)&stage->scalars[p]);
+                stage->params[p] = &stage->scalars[p];
+            }
+        }
+        stage->rows = 0u;
+        stage->last = height;
+        if (node->attributes.borders.mode == VX_BORDER_MODE_UNDEFINED)
+        {
+            vx_uint32 top = (node->kernel->attributes.nhbdinfo.top < 0 ? (vx_uint32)-node->kernel->attributes.nhbdinfo.top : 0u);
+            vx_uint32 bottom = (node->kernel->attributes.nhbdinfo.bottom > 0 ? (vx_uint32)node->kernel->attributes.nhbdinfo.bottom : 0u);
+            stage->rows = (top < height ? top : height);
+            stage->last = (bottom < height - stage->rows ? height - bottom : stage->rows);
+        }
+    }
+
+    strip = height / 64u;
+    if (strip == 0u)
+        strip = 1u;
+    while (stages[numStages-1u].rows < stages[numStages-1u].last)
+    {
+        for (s = 0u; s < numStages; s++)
+        {
+            vx_tile_stage_t *stage = &stages[s];
+            vx_signature_t *sig = &stage->node->kernel->signature;
+            vx_uint32 end = stage->last;
+            if (s == 0u)
+            {
+                if (stage->rows + strip < end)
+                    end = stage->rows + strip;
+            }
+            else if (stages[s-1u].rows < stages[s-1u].last)
+            {
+                /* a pixel on the right edge reads into the start of the next row */
+                vx_neighborhood_size_t *nbhd = &stage->node->kernel->attributes.nhbdinfo;
+                vx_uint32 margin = (nbhd->bottom > 0 ? (vx_uint32)nbhd->bottom : 0u) + (nbhd->right > 0 ? 1u : 0u);
+                vx_uint32 ready = (stages[s-1u].rows > margin ? stages[s-1u].rows - margin : 0u);
+                if (ready < end)
+                    end = ready;
+            }
+            if (end <= stage->rows)
+                continue;
+            for (p = 0u; p < sig->num_parameters; p++)
+            {
+                if (stage->params[p] == &stage->tiles[p])
+                    vxGetStripOfImage((vx_image_t *)stage->node->parameters[p], stage->rows, end, &stage->tiles[p]);
+            }
+            stage->node->kernel->tiling_function(stage->params,
+                                                 stage->node->attributes.tileDataPtr,
+                                                 stage->node->attributes.tileDataSize);
+            stage->rows = end;
+        }
+    }
+
+    for (s = 0u; s < numStages; s++)
+    {
+        vx_signature_t *sig = &stages[s].node->kernel->signature;
+        for (p = 0u; p < sig->num_parameters; p++)
+        {
+            if (stages[s].params[p] != &stages[s].tiles[p])
+                continue;
+            if (sig->directions[p] == VX_INPUT)
+                vxReadFromReference(stages[s].node->parameters[p]);
+            else
+                vxWroteToReference(stages[s].node->parameters[p]);
+        }
+        if (s > 0u)
+            stages[s].node->tileDone = vx_true_e;
+    }
+    return VX_SUCCESS;
+}
+
+vx_status VX_CALLBACK vxTilingKernel(vx_node node, vx_reference parameters[], vx_uint32 num)
+{
+    vx_status status = VX_ERROR_INVALID_PARAMETERS;
+    vx_tiling_loop_t loop;
+    vx_uint32 p = 0u, numStrips = 0u;
     size_t scalars[VX_INT_MAX_PARAMS];
     vx_uint32 index = UINT32_MAX;
-    vx_uint32 tile_size_y = 0u, tile_size_x = 0u;
     vx_uint32 block_multiple = 64;
-    vx_uint32 height = 0u, width = 0u;
     vx_border_mode_t borders = {VX_BORDER_MODE_UNDEFINED, 0};
     vx_neighborhood_size_t nbhd;
-    void *tile_memory = NULL;
-    vx_size size = 0;
+    vx_node_t *self = (vx_node_t *)node;
+
+    /* the nodes of a tile fused chain are executed by the head of the chain */
+    if (self->tileFused == vx_true_e)
+    {
+        if (self->tileDone == vx_true_e)
+        {
+            self->tileDone = vx_false_e;
+            return VX_SUCCESS;
+        }
+    }
+    else if (self->tileNext != NULL)
+    {
+        return vxTilingChain(self);
+    }
+
+    memset(&loop, 0, sizeof(loop));
+    loop.node = node;
+    loop.num = num;
 
     /* Do the following:
      * \arg find out each parameters direction
@@ -352,35 +593,36 @@ vx_status VX_CALLBACK vxTilingKernel(vx_node node, vx_reference parameters[], vx
     for (p = 0u; p < num; p++)
     {
         vx_parameter param = vxGetParameterByIndex(node, p);
+        vx_tile_t *tile = &loop.tiles[p];
         if (param)
         {
-            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_DIRECTION, &dirs[p], sizeof(dirs[p]));
-            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_TYPE, &types[p], sizeof(types[p]));
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_DIRECTION, &loop.dirs[p], sizeof(loop.dirs[p]));
+            vxQueryParameter(param, VX_PARAMETER_ATTRIBUTE_TYPE, &loop.types[p], sizeof(loop.types[p]));
             vxReleaseParameter(&param);
         }
-        //printf("Tiling Kernel Parameter[%u] dir:%d type:0%08x\n", p, dirs[p], types[p]);
-        if (types[p] == VX_TYPE_IMAGE)
+        //printf("Tiling Kernel Parameter[%u] dir:%d type:0%08x\n", p, loop.dirs[p], loop.types[p]);
+        if (loop.types[p] == VX_TYPE_IMAGE)
         {
-            vxQueryNode(node, VX_NODE_ATTRIBUTE_OUTPUT_TILE_BLOCK_SIZE, &tiles[p].tile_block, sizeof(vx_tile_block_size_t));
-            vxQueryNode(node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &tiles[p].neighborhood, sizeof(vx_neighborhood_size_t));
+            vxQueryNode(node, VX_NODE_ATTRIBUTE_OUTPUT_TILE_BLOCK_SIZE, &tile->tile_block, sizeof(vx_tile_block_size_t));
+            vxQueryNode(node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &tile->neighborhood, sizeof(vx_neighborhood_size_t));
             vxPrintImage((vx_image_t *)parameters[p]);
-            images[p] = (vx_image)parameters[p];
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_WIDTH, &tiles[p].image.width, sizeof(vx_uint32));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_HEIGHT, &tiles[p].image.height, sizeof(vx_uint32));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_FORMAT, &tiles[p].image.format, sizeof(vx_df_image));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_SPACE, &tiles[p].image.space, sizeof(vx_enum));
-            vxQueryImage(images[p], VX_IMAGE_ATTRIBUTE_RANGE, &tiles[p].image.range, sizeof(vx_enum));
-            params[p] = &tiles[p];
-            if ((dirs[p] == VX_OUTPUT) && (index == UINT32_MAX))
+            loop.images[p] = (vx_image)parameters[p];
+            vxQueryImage(loop.images[p], VX_IMAGE_ATTRIBUTE_WIDTH, &tile->image.width, sizeof(vx_uint32));
+            vxQueryImage(loop.images[p], VX_IMAGE_ATTRIBUTE_HEIGHT, &tile->image.height, sizeof(vx_uint32));
+            vxQueryImage(loop.images[p], VX_IMAGE_ATTRIBUTE_FORMAT, &tile->image.format, sizeof(vx_df_image));
+            vxQueryImage(loop.images[p], VX_IMAGE_ATTRIBUTE_SPACE, &tile->image.space, sizeof(vx_enum));
+            vxQueryImage(loop.images[p], VX_IMAGE_ATTRIBUTE_RANGE, &tile->image.range, sizeof(vx_enum));
+            loop.params[p] = tile;
+            if ((loop.dirs[p] == VX_OUTPUT) && (index == UINT32_MAX))
             {
                 index = p;
                 //printf("Using index %u as coordinate basis\n", index);
             }
         }
-        else if (types[p] == VX_TYPE_SCALAR)
+        else if (loop.types[p] == VX_TYPE_SCALAR)
         {
             vxAccessScalarValue((vx_scalar)parameters[p], (void *)&scalars[p]);
-            params[p] = &scalars[p];
+            loop.params[p] = &scalars[p];
         }
 #if defined(OPENVX_TILING_1_1)
         /*! \todo add addition data types here */
@@ -388,19 +630,22 @@ vx_status VX_CALLBACK vxTilingKernel(vx_node node, vx_reference parameters[], vx
     }
 
     /* choose the index of the first output image to based the tiling on */
-    status |= vxQueryImage(images[index], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
-    status |= vxQueryImage(images[index], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+    if (index == UINT32_MAX)
+        return status;
+    status = vxQueryImage(loop.images[index], VX_IMAGE_ATTRIBUTE_WIDTH, &loop.width, sizeof(loop.width));
+    status |= vxQueryImage(loop.images[index], VX_IMAGE_ATTRIBUTE_HEIGHT, &loop.height, sizeof(loop.height));
     status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &borders, sizeof(borders));
     status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_INPUT_NEIGHBORHOOD, &nbhd, sizeof(nbhd));
-    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_TILE_MEMORY_SIZE, &size, sizeof(size));
-
-#if 0
-    tile_size_y = (height - (nbhd.y[1] + abs(nbhd.y[0]))) / block_multiple;
-    tile_size_x = (width - (nbhd.x[1] + abs(nbhd.x[0])));
-#else
-    tile_size_y = height / block_multiple;
-    tile_size_x = width;
-#endif
+    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_TILE_MEMORY_SIZE, &loop.size, sizeof(loop.size));
+    status |= vxQueryNode(node, VX_NODE_ATTRIBUTE_TILE_MEMORY_PTR, &loop.tile_memory, sizeof(void *));
+    if (status != VX_SUCCESS)
+        return status;
+
+    /* the last strip is clipped to the image */
+    loop.tile_size_y = loop.height / block_multiple;
+    if (loop.tile_size_y == 0u)
+        loop.tile_size_y = 1u;
+    numStrips = (loop.height + loop.tile_size_y - 1u) / loop.tile_size_y;
 
     if ((borders.mode != VX_BORDER_MODE_UNDEFINED) &&
         (borders.mode != VX_BORDER_MODE_SELF))
@@ -408,61 +653,19 @@ vx_status VX_CALLBACK vxTilingKernel(vx_node node, vx_reference parameters[], vx
         return VX_ERROR_NOT_SUPPORTED;
     }
 
-    status = VX_SUCCESS;
-#if 0
-    for (ty = abs(nbhd.y[0]); (ty < (height - nbhd.y[1])) && (status == VX_SUCCESS); ty += tile_size_y)
+    /* the strips share the tile memory of the node, so they can only run concurrently without it */
+    if (loop.size == 0u)
     {
-        for (tx = abs(nbhd.x[0]); tx < (width - nbhd.x[1]); tx += tile_size_x)
-        {
-#else
-    for (ty = 0u; (ty < height) && (status == VX_SUCCESS); ty += tile_size_y)
+        vxParallelLoop(self->base.context->workers, numStrips, vxTilingStrip, &loop);
+    }
+    else
     {
-        for (tx = 0u; tx < width; tx += tile_size_x)
+        for (p = 0u; (p < numStrips) && (loop.status == (vx_uint32)VX_SUCCESS); p++)
         {
-#endif
-            rect.start_x = tx;
-            rect.start_y = ty;
-            rect.end_x = tx+tile_size_x;
-            rect.end_y = ty+tile_size_y;
-            for (p = 0u; p < num; p++)
-            {
-                if (types[p] == VX_TYPE_IMAGE)
-                {
-                    tiles[p].tile_x = tx;
-                    tiles[p].tile_y = ty;
-                    status |= vxGetPatchToTile(images[p], &rect, &tiles[p]);
-                }
-            }
-            if (status == VX_SUCCESS)
-            {
-                //printf("Calling Tile{%u,%u} with %s\n", tx, ty, ((vx_node_t *)node)->kernel->name);
-                vxQueryNode(node, VX_NODE_ATTRIBUTE_TILE_MEMORY_PTR, &tile_memory, sizeof(void *));
-                ((vx_node_t *)node)->kernel->tiling_function(params, tile_memory, size);
-            }
-            else
-            {
-                //printf("Failed to get tile {%u, %u} (status = %d)\n", tx, ty, status);
-            }
-            for (p = 0u; p < num; p++)
-            {
-                if (types[p] == VX_TYPE_IMAGE)
-                {
-                    if (dirs[p] == VX_INPUT)
-                    {
-                        status |= vxSetTileToPatch(images[p], 0, &tiles[p]);
-                    }
-                    else
-                    {
-                        status |= vxSetTileToPatch(images[p], &rect, &tiles[p]);
-                    }
-                }
-            }
-            if (status != VX_SUCCESS)
-            {
-                break;
-            }
+            vxTilingStrip(&loop, p);
         }
     }
+    status = (vx_status)loop.status;
     //printf("Tiling Kernel returning = %d\n", status);
     return status;
 }
@@ -23,7 +23,7 @@
 
 /*!
  * \file
- * \brief The Absolute Difference Kernel.
+ * \brief The Optical Flow Pyramid Lucas-Kanade Kernel.
  * \author Erik Rainey <erik.rainey@gmail.com>
  */
 
@@ -33,6 +33,10 @@
 #include <vx_internal.h>
 #include <c_model.h>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 typedef struct _vx_keypoint_t_optpyrlk_internal {
     vx_float32 x;                 /*!< \brief The x coordinate. */
     vx_float32 y;                 /*!< \brief The y coordinate. */
@@ -45,313 +49,369 @@ typedef struct _vx_keypoint_t_optpyrlk_internal {
 
 #define  INT_ROUND(x,n)     (((x) + (1 << ((n)-1))) >> (n))
 
-static vx_status LKTracker(
-        const vx_image prevImg, const vx_image prevDerivIx, const vx_image prevDerivIy, const vx_image nextImg,
-        const vx_array prevPts, vx_array nextPts,
-        vx_scalar winSize_s, vx_scalar criteria_s,
-        vx_uint32 level,vx_scalar epsilon,
-        vx_scalar num_iterations)
+/*! \brief The window sums of a row are accumulated in 32 bits over at most this many
+ * pixels, which keeps the largest products of the 5 bit interpolated differences and
+ * the Scharr gradients from overflowing.
+ */
+#define LK_CHUNK 64
+
+/*! \brief The state shared by the strips of one level of the tracker. */
+typedef struct _vx_lk_level_t {
+    const vx_uint8 *I_base;
+    vx_int32 stepI;
+    const vx_uint8 *J_base;
+    vx_int32 stepJ;
+    /*! \brief The Scharr gradients of I as interleaved (dx, dy) pairs */
+    vx_int16 *grad;
+    vx_int32 width;
+    vx_int32 height;
+    const vx_keypoint_t_optpyrlk_internal *prevPts;
+    vx_keypoint_t_optpyrlk_internal *nextPts;
+    vx_size numPoints;
+    vx_int32 winSize;
+    vx_float32 halfWin;
+    vx_uint32 level;
+    vx_enum criteria;
+    vx_float32 epsilon;
+    vx_int32 num_iterations;
+    vx_uint32 numStrips;
+    /*! \brief The windows of each strip, 3 values per pixel */
+    vx_int16 *windows;
+} vx_lk_level_t;
+
+/*! \brief Computes the Scharr gradients of the rows [y0, y1) of I into the interleaved
+ * buffer of the level. The outermost pixels have no gradient and are zero.
+ */
+static void vxLKGradientStrip(void *arg, vx_uint32 strip)
 {
-    vx_status status = VX_FAILURE;
-
-    vx_size winSize;
-    vxAccessScalarValue(winSize_s,&winSize);
-    vx_size halfWin = winSize*0.5f;
-    vx_size list_length,list_indx;
-    const vx_image I = prevImg;
-    const vx_image J = nextImg;
-    const vx_image derivIx = prevDerivIx;
-    const vx_image derivIy = prevDerivIy;
-
-    int j;
-    vx_enum termination_Criteria;
-
-    vx_image IWinBuf;
-    vx_image derivIWinBuf_x;
-    vx_image derivIWinBuf_y;
-
-    vx_df_image derivIx_format = 0;
-    vx_df_image J_format = 0;
-    vx_df_image derivIy_format = 0;
-    vx_df_image I_format = 0;
-    vx_rectangle_t rect;
-
-    void *derivIx_base = 0,*J_base = 0,*derivIy_base = 0,*I_base = 0;
-    vx_imagepatch_addressing_t  derivIx_addr,J_addr,derivIy_addr,I_addr;
-
-
-    void *IWinBuf_base = 0,*derivIWinBuf_x_base = 0,*derivIWinBuf_y_base = 0;
-    vx_df_image IWinBuf_format = 0;
-    vx_df_image derivIWinBuf_x_format = 0;
-    vx_df_image derivIWinBuf_y_format = 0;
-    vx_imagepatch_addressing_t  IWinBuf_addr,derivIWinBuf_x_addr,derivIWinBuf_y_addr;
-
-    vx_size prevPts_stride = 0;
-    vx_size nextPts_stride = 0;
-    void *prevPtsFirstItem = NULL;
-    void *nextPtsFirstItem = NULL;
-    vxQueryArray(prevPts,VX_ARRAY_ATTRIBUTE_NUMITEMS,&list_length,sizeof(list_length));
-    vxAccessArrayRange(prevPts, 0, list_length, &prevPts_stride, &prevPtsFirstItem, VX_READ_ONLY);
-    vxAccessArrayRange(nextPts, 0, list_length, &nextPts_stride, &nextPtsFirstItem, VX_READ_AND_WRITE);
-
-    vx_keypoint_t_optpyrlk_internal *nextPt_item = (vx_keypoint_t_optpyrlk_internal*)nextPtsFirstItem;
-    vx_keypoint_t_optpyrlk_internal *prevPt_item = (vx_keypoint_t_optpyrlk_internal*)prevPtsFirstItem;
-
+    vx_lk_level_t *lk = (vx_lk_level_t *)arg;
+    vx_int32 w = lk->width, h = lk->height, x, y;
+    vx_int32 y0 = (vx_int32)(((vx_int64)h * strip) / lk->numStrips);
+    vx_int32 y1 = (vx_int32)(((vx_int64)h * (strip + 1)) / lk->numStrips);
 
-    int num_iterations_i;
-    vx_float32 epsilon_f;
-
-    vxAccessScalarValue(num_iterations,&num_iterations_i);
-    vxAccessScalarValue(epsilon,&epsilon_f);
-    vxAccessScalarValue(criteria_s,&termination_Criteria);
-
-    vx_context context_lk_internal = vxCreateContext();
-
-    IWinBuf = vxCreateImage(context_lk_internal,winSize,winSize,VX_DF_IMAGE_S16);
-    derivIWinBuf_x = vxCreateImage(context_lk_internal,winSize,winSize,VX_DF_IMAGE_S16);
-    derivIWinBuf_y = vxCreateImage(context_lk_internal,winSize,winSize,VX_DF_IMAGE_S16);
-
-    vxInitImage((vx_image_t*)IWinBuf,winSize,winSize,VX_DF_IMAGE_S16);
-    vxAllocateImage((vx_image_t*)IWinBuf);
-    vxInitImage((vx_image_t*)derivIWinBuf_x,winSize,winSize,VX_DF_IMAGE_S16);
-    vxAllocateImage((vx_image_t*)derivIWinBuf_x);
-    vxInitImage((vx_image_t*)derivIWinBuf_y,winSize,winSize,VX_DF_IMAGE_S16);
-    vxAllocateImage((vx_image_t*)derivIWinBuf_y);
-
-
-
-    vxQueryImage(derivIx, VX_IMAGE_ATTRIBUTE_FORMAT, &derivIx_format, sizeof(derivIx_format));
-    vxQueryImage(J, VX_IMAGE_ATTRIBUTE_FORMAT, &J_format, sizeof(J_format));
-    vxQueryImage(derivIy, VX_IMAGE_ATTRIBUTE_FORMAT, &derivIy_format, sizeof(derivIy_format));
-    vxQueryImage(I, VX_IMAGE_ATTRIBUTE_FORMAT, &I_format, sizeof(I_format));
-
-    vxGetValidRegionImage(derivIx,&rect);
-    status = VX_SUCCESS;
-
-    status |= vxAccessImagePatch(derivIx, &rect, 0, &derivIx_addr, (void **)&derivIx_base,VX_READ_ONLY);
-    status |= vxAccessImagePatch(J, &rect, 0, &J_addr, (void **)&J_base,VX_READ_ONLY);
-    status |= vxAccessImagePatch(derivIy, &rect, 0, &derivIy_addr, (void **)&derivIy_base,VX_READ_ONLY);
-    status |= vxAccessImagePatch(I, &rect, 0, &I_addr, (void **)&I_base,VX_READ_ONLY);
-
-    vxQueryImage(IWinBuf, VX_IMAGE_ATTRIBUTE_FORMAT, &IWinBuf_format, sizeof(IWinBuf_format));
-    vxQueryImage(derivIWinBuf_x, VX_IMAGE_ATTRIBUTE_FORMAT, &derivIWinBuf_x_format, sizeof(derivIWinBuf_x_format));
-    vxQueryImage(derivIWinBuf_y, VX_IMAGE_ATTRIBUTE_FORMAT, &derivIWinBuf_y_format, sizeof(derivIWinBuf_y_format));
-
-    vxGetValidRegionImage(IWinBuf,&rect);
-
-    status |= vxAccessImagePatch(IWinBuf, &rect, 0, &IWinBuf_addr, (void **)&IWinBuf_base,VX_READ_AND_WRITE);
-    status |= vxAccessImagePatch(derivIWinBuf_x, &rect, 0, &derivIWinBuf_x_addr, (void **)&derivIWinBuf_x_base,VX_READ_AND_WRITE);
-    status |= vxAccessImagePatch(derivIWinBuf_y, &rect, 0, &derivIWinBuf_y_addr, (void **)&derivIWinBuf_y_base,VX_READ_AND_WRITE);
-
-
-
-    for(list_indx=0;list_indx<list_length;list_indx++)
+    for (y = y0; y < y1; y++)
     {
-
-
-        vx_keypoint_t_optpyrlk_internal nextPt,prevPt;
-
-
-        vx_keypoint_t_optpyrlk_internal iprevPt, inextPt;
-
-        prevPt.x = prevPt_item[list_indx].x;
-        prevPt.y = prevPt_item[list_indx].y;
-
-        // nextPt.x = prevPt.x;
-        // nextPt.y = prevPt.y;
-        nextPt.x = nextPt_item[list_indx].x;
-        nextPt.y = nextPt_item[list_indx].y;
-
-        prevPt.x -= halfWin;
-        prevPt.y -= halfWin;
-        nextPt.x -= halfWin;
-        nextPt.y -= halfWin;
-
-        iprevPt.x = floor(prevPt.x);
-        iprevPt.y = floor(prevPt.y);
-
-        if( iprevPt.x < 0 || iprevPt.x >= derivIx_addr.dim_x - winSize-1 ||
-            iprevPt.y < 0 || iprevPt.y >= derivIx_addr.dim_y - winSize-1 )
+        vx_int16 * VX_RESTRICT g = &lk->grad[(vx_size)y * w * 2];
+        const vx_uint8 * VX_RESTRICT s0, * VX_RESTRICT s1, * VX_RESTRICT s2;
+        if ((y == 0) || (y == h - 1) || (w < 3))
         {
-            if( level == 0 )
-            {
-                nextPt.tracking_status = 0;
-                nextPt.error = 0;
-            }
+            memset(g, 0, w * 2 * sizeof(vx_int16));
             continue;
         }
-
-        float a = prevPt.x - iprevPt.x;
-        float b = prevPt.y - iprevPt.y;
-        const int W_BITS = 14, W_BITS1 = 14;
-        const float FLT_SCALE = 1.f/(1 << 20);
-        int iw00 = (int)(((1.f - a)*(1.f - b)*(1 << W_BITS))+0.5f);
-        int iw01 = (int)((a*(1.f - b)*(1 << W_BITS))+0.5f);
-        int iw10 = (int)(((1.f - a)*b*(1 << W_BITS))+0.5f);
-        int iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
-
-        int dstep_x = (int)(derivIx_addr.stride_y)/2;
-        int dstep_y = (int)(derivIy_addr.stride_y)/2;
-        int stepJ = (int)(J_addr.stride_y);
-        int stepI = (int)(I_addr.stride_y);
-        double A11 = 0, A12 = 0, A22 = 0;
-
-
-        // extract the patch from the first image, compute covariation matrix of derivatives
-        int x, y;
-        for( y = 0; y < winSize; y++ )
+        s0 = lk->I_base + (y - 1) * lk->stepI;
+        s1 = s0 + lk->stepI;
+        s2 = s1 + lk->stepI;
+        g[0] = g[1] = 0;
+        for (x = 1; x < w - 1; x++)
         {
-            unsigned char *src = (unsigned char*)vxFormatImagePatchAddress2d(I_base, iprevPt.x, y + iprevPt.y, &I_addr);
-            short *dsrc_x = (short*)vxFormatImagePatchAddress2d(derivIx_base, iprevPt.x, y + iprevPt.y, &derivIx_addr);
-            short *dsrc_y = (short*)vxFormatImagePatchAddress2d(derivIy_base, iprevPt.x, y + iprevPt.y, &derivIy_addr);
-
-
-            short* Iptr = (short*)vxFormatImagePatchAddress2d(IWinBuf_base,0, y,&IWinBuf_addr);
-            short* dIptr_x = (short*)vxFormatImagePatchAddress2d(derivIWinBuf_x_base,0, y,&derivIWinBuf_x_addr);
-            short* dIptr_y = (short*)vxFormatImagePatchAddress2d(derivIWinBuf_y_base,0, y,&derivIWinBuf_y_addr);
-
-            x = 0;
+            g[2*x]   = (vx_int16)(3 * (s0[x+1] - s0[x-1]) + 10 * (s1[x+1] - s1[x-1]) + 3 * (s2[x+1] - s2[x-1]));
+            g[2*x+1] = (vx_int16)(3 * (s2[x-1] - s0[x-1]) + 10 * (s2[x] - s0[x]) + 3 * (s2[x+1] - s0[x+1]));
+        }
+        g[2*w-2] = g[2*w-1] = 0;
+    }
+}
 
+/*! \brief Interpolates a row of the window of I and its gradients at the bilinear
+ * weights and accumulates the gradient covariance of the row.
+ */
+static void vxLKWindowRow(const vx_uint8 * VX_RESTRICT src, vx_int32 stepI,
+                          const vx_int16 * VX_RESTRICT g, vx_int32 stepG,
+                          vx_int32 n, const vx_int32 iw[4],
+                          vx_int16 * VX_RESTRICT Iptr, vx_int16 * VX_RESTRICT dIptr,
+                          vx_int64 A[3])
+{
+    const vx_int32 W_BITS1 = 14;
+    vx_int32 iw00 = iw[0], iw01 = iw[1], iw10 = iw[2], iw11 = iw[3];
+    vx_int32 x, x0;
+    for (x = 0; x < n; x++)
+    {
+        Iptr[x] = (vx_int16)INT_ROUND(src[x]*iw00 + src[x+1]*iw01 +
+                                      src[x+stepI]*iw10 + src[x+stepI+1]*iw11, W_BITS1-5);
+        dIptr[2*x]   = (vx_int16)INT_ROUND(g[2*x]*iw00 + g[2*x+2]*iw01 +
+                                           g[2*x+stepG]*iw10 + g[2*x+stepG+2]*iw11, W_BITS1);
+        dIptr[2*x+1] = (vx_int16)INT_ROUND(g[2*x+1]*iw00 + g[2*x+3]*iw01 +
+                                           g[2*x+stepG+1]*iw10 + g[2*x+stepG+3]*iw11, W_BITS1);
+    }
+    for (x0 = 0; x0 < n; x0 += LK_CHUNK)
+    {
+        vx_int32 x1 = (x0 + LK_CHUNK < n ? x0 + LK_CHUNK : n);
+        vx_int32 a11 = 0, a12 = 0, a22 = 0;
+        for (x = x0; x < x1; x++)
+        {
+            vx_int32 ix = dIptr[2*x], iy = dIptr[2*x+1];
+            a11 += ix * ix;
+            a12 += ix * iy;
+            a22 += iy * iy;
+        }
+        A[0] += a11;
+        A[1] += a12;
+        A[2] += a22;
+    }
+}
 
-            for( ; x < winSize; x++, dsrc_x ++, dsrc_y ++)
+/*! \brief Accumulates the products of the gradients of a window row with the difference
+ * between J, interpolated at the bilinear weights, and I. With SSE2 eight pixels are
+ * interpolated at a time, and the products with the interleaved gradients are taken
+ * by multiply-add against the differences spread to the even or the odd lanes.
+ */
+static void vxLKMismatchRow(const vx_uint8 * VX_RESTRICT Jptr, vx_int32 stepJ,
+                            const vx_int16 * VX_RESTRICT Iptr, const vx_int16 * VX_RESTRICT dIptr,
+                            vx_int32 n, const vx_int32 iw[4], vx_int64 b[2])
+{
+    const vx_int32 W_BITS1 = 14;
+    vx_int32 iw00 = iw[0], iw01 = iw[1], iw10 = iw[2], iw11 = iw[3];
+    vx_int32 x, x0;
+#if defined(__SSE2__)
+    const __m128i z = _mm_setzero_si128();
+    const __m128i qw0 = _mm_set1_epi32(iw00 | (iw01 << 16));
+    const __m128i qw1 = _mm_set1_epi32(iw10 | (iw11 << 16));
+    const __m128i qdelta = _mm_set1_epi32(1 << (W_BITS1-5-1));
+#endif
+    for (x0 = 0; x0 < n; x0 += LK_CHUNK)
+    {
+        vx_int32 x1 = (x0 + LK_CHUNK < n ? x0 + LK_CHUNK : n);
+        vx_int32 b1 = 0, b2 = 0;
+        x = x0;
+#if defined(__SSE2__)
+        {
+            __m128i qb1 = z, qb2 = z;
+            vx_int32 sums[4];
+            for (; x + 8 <= x1; x += 8)
             {
-                int ival = INT_ROUND(src[x]*iw00 + src[x+1]*iw01 +
-                                      src[x+stepI]*iw10 + src[x+stepI+1]*iw11, W_BITS1-5);
-                int ixval = INT_ROUND(dsrc_x[0]*iw00 + dsrc_x[1]*iw01 +
-                                       dsrc_x[dstep_x]*iw10 + dsrc_x[dstep_x+1]*iw11, W_BITS1);
-                int iyval = INT_ROUND(dsrc_y[0]*iw00 + dsrc_y[1]*iw01 + dsrc_y[dstep_y]*iw10 +
-                                       dsrc_y[dstep_y+1]*iw11, W_BITS1);
-
-                Iptr[x] = (short)ival;
-                dIptr_x[x] = (short)ixval;
-                dIptr_y[x] = (short)iyval;
-
-                A11 += (float)(ixval*ixval);
-                A12 += (float)(ixval*iyval);
-                A22 += (float)(iyval*iyval);
+                __m128i j0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&Jptr[x]), z);
+                __m128i j1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&Jptr[x+1]), z);
+                __m128i k0 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&Jptr[x+stepJ]), z);
+                __m128i k1 = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)&Jptr[x+stepJ+1]), z);
+                __m128i lo = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(j0, j1), qw0),
+                                           _mm_madd_epi16(_mm_unpacklo_epi16(k0, k1), qw1));
+                __m128i hi = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(j0, j1), qw0),
+                                           _mm_madd_epi16(_mm_unpackhi_epi16(k0, k1), qw1));
+                __m128i diff, g0, g1;
+                lo = _mm_srai_epi32(_mm_add_epi32(lo, qdelta), W_BITS1-5);
+                hi = _mm_srai_epi32(_mm_add_epi32(hi, qdelta), W_BITS1-5);
+                diff = _mm_sub_epi16(_mm_packs_epi32(lo, hi), _mm_loadu_si128((const __m128i *)&Iptr[x]));
+                g0 = _mm_loadu_si128((const __m128i *)&dIptr[2*x]);
+                g1 = _mm_loadu_si128((const __m128i *)&dIptr[2*x+8]);
+                qb1 = _mm_add_epi32(qb1, _mm_madd_epi16(g0, _mm_unpacklo_epi16(diff, z)));
+                qb1 = _mm_add_epi32(qb1, _mm_madd_epi16(g1, _mm_unpackhi_epi16(diff, z)));
+                qb2 = _mm_add_epi32(qb2, _mm_madd_epi16(g0, _mm_unpacklo_epi16(z, diff)));
+                qb2 = _mm_add_epi32(qb2, _mm_madd_epi16(g1, _mm_unpackhi_epi16(z, diff)));
             }
+            _mm_storeu_si128((__m128i *)sums, qb1);
+            b1 = sums[0] + sums[1] + sums[2] + sums[3];
+            _mm_storeu_si128((__m128i *)sums, qb2);
+            b2 = sums[0] + sums[1] + sums[2] + sums[3];
         }
-
-
-        A11 *= FLT_SCALE;
-        A12 *= FLT_SCALE;
-        A22 *= FLT_SCALE;
-
-        double D = A11*A22 - A12*A12;
-        float minEig = (A22 + A11 - sqrt((A11-A22)*(A11-A22) +
-                        4.f*A12*A12))/(2*winSize*winSize);
-
-
-        if( minEig < 1.0e-04F || D < 1.0e-07F  )
+#endif
+        for (; x < x1; x++)
         {
-            if( level == 0  )
-                nextPt.tracking_status = 0;
-            continue;
+            vx_int32 diff = INT_ROUND(Jptr[x]*iw00 + Jptr[x+1]*iw01 +
+                                      Jptr[x+stepJ]*iw10 + Jptr[x+stepJ+1]*iw11,
+                                      W_BITS1-5) - Iptr[x];
+            b1 += diff * dIptr[2*x];
+            b2 += diff * dIptr[2*x+1];
         }
+        b[0] += b1;
+        b[1] += b2;
+    }
+}
 
-        D = 1.f/D;
+static void vxLKWeights(vx_float32 a, vx_float32 b, vx_int32 iw[4])
+{
+    const vx_int32 W_BITS = 14;
+    iw[0] = (vx_int32)(((1.f - a)*(1.f - b)*(1 << W_BITS))+0.5f);
+    iw[1] = (vx_int32)((a*(1.f - b)*(1 << W_BITS))+0.5f);
+    iw[2] = (vx_int32)(((1.f - a)*b*(1 << W_BITS))+0.5f);
+    iw[3] = (1 << W_BITS) - iw[0] - iw[1] - iw[2];
+}
 
-        // nextPt.x -= halfWin;
-        // nextPt.y -= halfWin;
-        float prevDelta_x=0.0f,prevDelta_y=0.0f;
+/*! \brief Tracks one point on one level, iterating until the termination criteria
+ * are met, and writes the estimate into the next point list.
+ */
+static void vxLKTrackPoint(const vx_lk_level_t *lk, vx_size index, vx_int16 *Iwin, vx_int16 *dIwin)
+{
+    const vx_float32 FLT_SCALE = 1.f/(1 << 20);
+    vx_keypoint_t_optpyrlk_internal *nextItem = &lk->nextPts[index];
+    vx_int32 winSize = lk->winSize, stepG = lk->width * 2;
+    vx_float32 prevX = lk->prevPts[index].x - lk->halfWin;
+    vx_float32 prevY = lk->prevPts[index].y - lk->halfWin;
+    vx_float32 nextX = nextItem->x - lk->halfWin;
+    vx_float32 nextY = nextItem->y - lk->halfWin;
+    vx_float32 prevDelta_x = 0.0f, prevDelta_y = 0.0f;
+    vx_int32 ix = (vx_int32)floor(prevX), iy = (vx_int32)floor(prevY);
+    vx_int64 A[3] = {0, 0, 0};
+    vx_int32 iw[4], y, j;
+    double A11, A12, A22, D;
+    vx_float32 minEig;
+
+    if ((ix < 0) || (ix >= lk->width - winSize - 1) ||
+        (iy < 0) || (iy >= lk->height - winSize - 1))
+    {
+        return;
+    }
 
-        j = 0;
-        while(j < num_iterations_i || termination_Criteria == VX_TERM_CRITERIA_EPSILON)
-        {
-            inextPt.x = floor(nextPt.x);
-            inextPt.y = floor(nextPt.y);
+    /* extract the patch from the first image, compute covariation matrix of derivatives */
+    vxLKWeights(prevX - ix, prevY - iy, iw);
+    for (y = 0; y < winSize; y++)
+    {
+        vxLKWindowRow(lk->I_base + (iy + y) * lk->stepI + ix, lk->stepI,
+                      &lk->grad[((vx_size)(iy + y) * lk->width + ix) * 2], stepG,
+                      winSize, iw, &Iwin[y * winSize], &dIwin[y * winSize * 2], A);
+    }
 
-            if( inextPt.x < 0 || inextPt.x >= J_addr.dim_x-winSize-1 ||
-               inextPt.y < 0 || inextPt.y >= J_addr.dim_y- winSize-1 )
-            {
-                if( level == 0  )
-                    nextPt.tracking_status = 0;
-                break;
-            }
+    A11 = (double)A[0] * FLT_SCALE;
+    A12 = (double)A[1] * FLT_SCALE;
+    A22 = (double)A[2] * FLT_SCALE;
 
-            a = nextPt.x - inextPt.x;
-            b = nextPt.y - inextPt.y;
-            iw00 = (int)(((1.f - a)*(1.f - b)*(1 << W_BITS))+0.5);
-            iw01 = (int)((a*(1.f - b)*(1 << W_BITS))+0.5);
-            iw10 = (int)(((1.f - a)*b*(1 << W_BITS))+0.5);
-            iw11 = (1 << W_BITS) - iw00 - iw01 - iw10;
-            double b1 = 0, b2 = 0;
+    D = A11*A22 - A12*A12;
+    minEig = (A22 + A11 - sqrt((A11-A22)*(A11-A22) +
+              4.f*A12*A12))/(2*winSize*winSize);
 
-            for( y = 0; y < winSize; y++ )
-            {
-                unsigned char* Jptr = (unsigned char*)vxFormatImagePatchAddress2d(J_base, inextPt.x, y + inextPt.y, &J_addr);
-                short* Iptr = (short*)vxFormatImagePatchAddress2d(IWinBuf_base,0, y,&IWinBuf_addr);
-                short* dIptr_x = (short*)vxFormatImagePatchAddress2d(derivIWinBuf_x_base,0, y,&derivIWinBuf_x_addr);
-                short* dIptr_y = (short*)vxFormatImagePatchAddress2d(derivIWinBuf_y_base,0, y,&derivIWinBuf_y_addr);
+    if (minEig < 1.0e-04F || D < 1.0e-07F)
+    {
+        return;
+    }
 
-                x = 0;
+    D = 1.f/D;
 
+    j = 0;
+    while (j < lk->num_iterations || lk->criteria == VX_TERM_CRITERIA_EPSILON)
+    {
+        vx_int32 jx = (vx_int32)floor(nextX), jy = (vx_int32)floor(nextY);
+        vx_int64 b[2] = {0, 0};
+        vx_float32 delta_x, delta_y;
+        double b1, b2;
 
-                for( ; x < winSize; x++)
-                {
-                    int diff = INT_ROUND(Jptr[x]*iw00 + Jptr[x+1]*iw01 +
-                                          Jptr[x+stepJ]*iw10 + Jptr[x+stepJ+1]*iw11,
-                                          W_BITS1-5) - Iptr[x];
-                    b1 += (float)(diff*dIptr_x[x]);
-                    b2 += (float)(diff*dIptr_y[x]);
-                }
-            }
+        if ((jx < 0) || (jx >= lk->width - winSize - 1) ||
+            (jy < 0) || (jy >= lk->height - winSize - 1))
+        {
+            break;
+        }
 
+        vxLKWeights(nextX - jx, nextY - jy, iw);
+        for (y = 0; y < winSize; y++)
+        {
+            vxLKMismatchRow(lk->J_base + (jy + y) * lk->stepJ + jx, lk->stepJ,
+                            &Iwin[y * winSize], &dIwin[y * winSize * 2], winSize, iw, b);
+        }
 
-            b1 *= FLT_SCALE;
-            b2 *= FLT_SCALE;
+        b1 = (double)b[0] * FLT_SCALE;
+        b2 = (double)b[1] * FLT_SCALE;
 
-            float delta_x = (float)((A12*b2 - A22*b1) * D);
-            float delta_y = (float)((A12*b1 - A11*b2) * D);
-            //printf("lvl=%d pt=%d iter=%d   -> (%f, %f) += (%f, %f)\n", (int)level, (int)list_indx, (int)j, nextPt.x, nextPt.y, delta_x, delta_y);
-            //delta = -delta;
+        delta_x = (vx_float32)((A12*b2 - A22*b1) * D);
+        delta_y = (vx_float32)((A12*b1 - A11*b2) * D);
 
-            nextPt.x += delta_x;
-            nextPt.y += delta_y;
-            nextPt_item[list_indx].x = nextPt.x + halfWin;
-            nextPt_item[list_indx].y = nextPt.y + halfWin;
+        nextX += delta_x;
+        nextY += delta_y;
+        nextItem->x = nextX + lk->halfWin;
+        nextItem->y = nextY + lk->halfWin;
 
-            if( (delta_x*delta_x + delta_y*delta_y) <= epsilon_f && (termination_Criteria == VX_TERM_CRITERIA_EPSILON || termination_Criteria == VX_TERM_CRITERIA_BOTH))
-                break;
+        if ((delta_x*delta_x + delta_y*delta_y) <= lk->epsilon &&
+            (lk->criteria == VX_TERM_CRITERIA_EPSILON || lk->criteria == VX_TERM_CRITERIA_BOTH))
+            break;
 
-            if( j > 0 && abs(delta_x + prevDelta_x) < 0.01 &&
-               abs(delta_y + prevDelta_y) < 0.01 )
-            {
-                nextPt_item[list_indx].x -= delta_x*0.5f;
-                nextPt_item[list_indx].y -= delta_y*0.5f;
-                break;
-            }
-            prevDelta_x = delta_x;
-            prevDelta_y = delta_y;
-            j++;
+        if (j > 0 && abs(delta_x + prevDelta_x) < 0.01 &&
+            abs(delta_y + prevDelta_y) < 0.01)
+        {
+            nextItem->x -= delta_x*0.5f;
+            nextItem->y -= delta_y*0.5f;
+            break;
         }
+        prevDelta_x = delta_x;
+        prevDelta_y = delta_y;
+        j++;
     }
-    status |= vxCommitArrayRange(prevPts, 0, list_length,prevPtsFirstItem);
-    status |= vxCommitArrayRange(nextPts, 0, list_length,nextPtsFirstItem);
-
-    status |= vxCommitImagePatch(IWinBuf, &rect, 0, &IWinBuf_addr, (void *)IWinBuf_base);
-    status |= vxCommitImagePatch(derivIWinBuf_x, &rect, 0, &derivIWinBuf_x_addr, (void *)derivIWinBuf_x_base);
-    status |= vxCommitImagePatch(derivIWinBuf_y, &rect, 0, &derivIWinBuf_y_addr, (void *)derivIWinBuf_y_base);
-
-    status |= vxCommitImagePatch(derivIx, &rect, 0, &derivIx_addr, (void *)derivIx_base);
-    status |= vxCommitImagePatch(J, &rect, 0, &J_addr, (void *)J_base);
-    status |= vxCommitImagePatch(derivIy, &rect, 0, &derivIy_addr, (void *)derivIy_base);
-    status |= vxCommitImagePatch(I, &rect, 0, &I_addr, (void *)I_base);
-
-    vxFreeImage((vx_image_t*)IWinBuf);
-    vxFreeImage((vx_image_t*)derivIWinBuf_x);
-    vxFreeImage((vx_image_t*)derivIWinBuf_y);
+}
 
-    vxReleaseImage(&IWinBuf);
-    vxReleaseImage(&derivIWinBuf_x);
-    vxReleaseImage(&derivIWinBuf_y);
+/*! \brief Tracks the points of one strip of the point list on one level. */
+static void vxLKTrackStrip(void *arg, vx_uint32 strip)
+{
+    vx_lk_level_t *lk = (vx_lk_level_t *)arg;
+    vx_size p0 = (lk->numPoints * strip) / lk->numStrips;
+    vx_size p1 = (lk->numPoints * (strip + 1)) / lk->numStrips;
+    vx_int16 *Iwin = &lk->windows[(vx_size)strip * lk->winSize * lk->winSize * 3];
+    vx_int16 *dIwin = &Iwin[lk->winSize * lk->winSize];
+    vx_size p;
+    for (p = p0; p < p1; p++)
+    {
+        vxLKTrackPoint(lk, p, Iwin, dIwin);
+    }
+}
 
-    vxReleaseContext(&context_lk_internal);
+/*! \brief Tracks every point on one level of the pyramids. The gradients of the level
+ * are computed once into the interleaved buffer, which holds the largest level, and
+ * the point list is split into strips across the worker threads.
+ */
+static vx_status LKTracker(
+        vx_threadpool_t *workers, vx_int16 *grad,
+        const vx_image prevImg, const vx_image nextImg,
+        const vx_array prevPts, vx_array nextPts,
+        vx_scalar winSize_s, vx_scalar criteria_s,
+        vx_uint32 level,vx_scalar epsilon,
+        vx_scalar num_iterations)
+{
+    vx_status status = VX_SUCCESS;
+    vx_lk_level_t lk;
+    vx_size winSize = 0, list_length = 0;
+    vx_size prevPts_stride = 0, nextPts_stride = 0;
+    void *prevPtsFirstItem = NULL, *nextPtsFirstItem = NULL;
+    void *I_base = NULL, *J_base = NULL;
+    vx_imagepatch_addressing_t I_addr, J_addr;
+    vx_rectangle_t rect;
 
-    return VX_SUCCESS;
+    memset(&lk, 0, sizeof(lk));
+    vxAccessScalarValue(winSize_s, &winSize);
+    vxAccessScalarValue(num_iterations, &lk.num_iterations);
+    vxAccessScalarValue(epsilon, &lk.epsilon);
+    vxAccessScalarValue(criteria_s, &lk.criteria);
+    lk.winSize = (vx_int32)winSize;
+    lk.halfWin = (vx_float32)(vx_size)(winSize*0.5f);
+    lk.level = level;
+    lk.grad = grad;
+
+    vxQueryArray(prevPts, VX_ARRAY_ATTRIBUTE_NUMITEMS, &list_length, sizeof(list_length));
+    status |= vxGetValidRegionImage(prevImg, &rect);
+    status |= vxAccessImagePatch(prevImg, &rect, 0, &I_addr, &I_base, VX_READ_ONLY);
+    status |= vxAccessImagePatch(nextImg, &rect, 0, &J_addr, &J_base, VX_READ_ONLY);
+    status |= vxAccessArrayRange(prevPts, 0, list_length, &prevPts_stride, &prevPtsFirstItem, VX_READ_ONLY);
+    status |= vxAccessArrayRange(nextPts, 0, list_length, &nextPts_stride, &nextPtsFirstItem, VX_READ_AND_WRITE);
+    if (status == VX_SUCCESS)
+    {
+        lk.I_base = (const vx_uint8 *)I_base;
+        lk.stepI = I_addr.stride_y;
+        lk.J_base = (const vx_uint8 *)J_base;
+        lk.stepJ = J_addr.stride_y;
+        lk.width = (vx_int32)I_addr.dim_x;
+        lk.height = (vx_int32)I_addr.dim_y;
+        lk.prevPts = (const vx_keypoint_t_optpyrlk_internal *)prevPtsFirstItem;
+        lk.nextPts = (vx_keypoint_t_optpyrlk_internal *)nextPtsFirstItem;
+        lk.numPoints = list_length;
+
+        lk.numStrips = (workers ? workers->numWorkers + 1u : 1u);
+        if (lk.numStrips > (vx_uint32)lk.height)
+            lk.numStrips = (vx_uint32)lk.height;
+        vxParallelLoop(workers, lk.numStrips, vxLKGradientStrip, &lk);
+
+        lk.numStrips = (workers ? workers->numWorkers + 1u : 1u);
+        if (lk.numStrips > list_length)
+            lk.numStrips = (vx_uint32)list_length;
+        if (lk.numStrips > 0u)
+        {
+            lk.windows = (vx_int16 *)malloc(lk.numStrips * winSize * winSize * 3 * sizeof(vx_int16));
+            if (lk.windows)
+                vxParallelLoop(workers, lk.numStrips, vxLKTrackStrip, &lk);
+            else
+                status = VX_ERROR_NO_MEMORY;
+            free(lk.windows);
+        }
+    }
+    status |= vxCommitArrayRange(prevPts, 0, list_length, prevPtsFirstItem);
+    status |= vxCommitArrayRange(nextPts, 0, list_length, nextPtsFirstItem);
+    status |= vxCommitImagePatch(nextImg, NULL, 0, &J_addr, J_base);
+    status |= vxCommitImagePatch(prevImg, NULL, 0, &I_addr, I_base);
+    return status;
 }
 
-
 static vx_status VX_CALLBACK vxOpticalFlowPyrLKKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_FAILURE;
@@ -381,11 +441,25 @@ static vx_status VX_CALLBACK vxOpticalFlowPyrLKKernel(vx_node node, vx_reference
         vx_keypoint_t_optpyrlk_internal *prevPt;
         vx_keypoint_t *initialPt = NULL;
         vx_keypoint_t_optpyrlk_internal *nextPt = NULL;
+        vx_int16 *grad = NULL;
 
         vxAccessScalarValue(use_initial_estimate,&use_initial_estimate_b);
         vxQueryPyramid(old_pyramid, VX_PYRAMID_ATTRIBUTE_LEVELS, &maxLevel, sizeof(maxLevel));
         vxQueryPyramid(old_pyramid, VX_PYRAMID_ATTRIBUTE_SCALE , &pyramid_scale, sizeof(pyramid_scale));
 
+        /* the gradients of every level fit in the buffer of the largest level */
+        {
+            vx_image base_image = vxGetPyramidLevel(old_pyramid, 0);
+            vx_uint32 width = 0, height = 0;
+            vxQueryImage(base_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+            vxQueryImage(base_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height));
+            vxReleaseImage(&base_image);
+            grad = (vx_int16 *)malloc((vx_size)width * height * 2 * sizeof(vx_int16));
+            if (grad == NULL)
+                return VX_ERROR_NO_MEMORY;
+        }
+        status = VX_SUCCESS;
+
         // the point in the list are in integer coordinates of x,y
         // The algorithm demand  a float so we convert the point first.
         vxQueryArray(prevPts, VX_ARRAY_ATTRIBUTE_NUMITEMS, &list_length,sizeof(list_length));
@@ -394,7 +468,6 @@ static vx_status VX_CALLBACK vxOpticalFlowPyrLKKernel(vx_node node, vx_reference
         {
             vx_image old_image = vxGetPyramidLevel(old_pyramid, level-1);
             vx_image new_image = vxGetPyramidLevel(new_pyramid, level-1);
-            vx_rectangle_t rec;
 
             prevPtsFirstItem = NULL;
             vxAccessArrayRange(prevPts, 0, list_length, &prevPts_stride, &prevPtsFirstItem, VX_READ_AND_WRITE);
@@ -407,7 +480,10 @@ static vx_status VX_CALLBACK vxOpticalFlowPyrLKKernel(vx_node node, vx_reference
                     vx_size list_length2 = 0;
                     vxQueryArray(estimatedPts, VX_ARRAY_ATTRIBUTE_NUMITEMS, &list_length2,sizeof(list_length2));
                     if (list_length2 != list_length)
+                    {
+                        free(grad);
                         return VX_ERROR_INVALID_PARAMETERS;
+                    }
 
                     initialPtsFirstItem = NULL;
                     vxAccessArrayRange(estimatedPts, 0, list_length, &estimatedPts_stride, &initialPtsFirstItem, VX_READ_ONLY);
@@ -477,55 +553,10 @@ static vx_status VX_CALLBACK vxOpticalFlowPyrLKKernel(vx_node node, vx_reference
                 vxCommitArrayRange(estimatedPts, 0, list_length,initialPtsFirstItem);
             }
 
-            vxGetValidRegionImage(old_image,&rec);
-            // printf("%ux%u - %ux%u\n", rec.start_x, rec.start_y, rec.end_x, rec.end_y);
-
-            {
-                vx_context context_scharr = vxCreateContext();
-                if(context_scharr)
-                {
-                    vx_uint32 width,height,n;
-
-                    width = rec.end_x - rec.start_x;
-                    height = rec.end_y - rec.start_y;
-
-                    vx_image shar_images[] = {
-                            old_image,     // index 0: Input 1
-                            vxCreateImage(context_scharr, width, height, VX_DF_IMAGE_S16),     // index 1: Input 2
-                            vxCreateImage(context_scharr, width, height, VX_DF_IMAGE_S16),       // index 2: Get Y channel
-                    };
-                    vx_graph graph_scharr = vxCreateGraph(context_scharr);
-                    vx_status extras_status = vxLoadKernels(context_scharr, "openvx-extras");
-                    if (graph_scharr && extras_status == VX_SUCCESS)
-                    {
-                        vx_node scharr_nodes[] = {
-                            vxScharr3x3Node(graph_scharr, shar_images[0], shar_images[1], shar_images[2]),
-                        };
-                        status = vxVerifyGraph(graph_scharr);
-                        if (status == VX_SUCCESS)
-                        {
-
-                            status = vxProcessGraph(graph_scharr);
-
-                            status |= LKTracker(old_image, shar_images[1], shar_images[2],
-                                        new_image, prevPts, nextPts,
-                                        window_dimension, termination, level-1,
-                                        epsilon,num_iterations);
-                        }
-                        for (n = 0; n < dimof(scharr_nodes); n++)
-                        {
-                            vxReleaseNode(&scharr_nodes[n]);
-                        }
-                        vxReleaseGraph(&graph_scharr);
-                    }
-                    for (n = 1; n < dimof(shar_images); n++)
-                    {
-                        vxReleaseImage(&shar_images[n]);
-                    }
-                    vxReleaseContext(&context_scharr);
-
-                }
-            }
+            status |= LKTracker(node->base.context->workers, grad,
+                                old_image, new_image, prevPts, nextPts,
+                                window_dimension, termination, level-1,
+                                epsilon, num_iterations);
 
             vxReleaseImage(&new_image);
             vxReleaseImage(&old_image);
@@ -550,7 +581,8 @@ static vx_status VX_CALLBACK vxOpticalFlowPyrLKKernel(vx_node node, vx_reference
 
         vxCommitArrayRange(nextPts, 0, list_length,nextPtsFirstItem);
 
-       return status;
+        free(grad);
+        return status;
     }
     return VX_ERROR_INVALID_PARAMETERS;
 }
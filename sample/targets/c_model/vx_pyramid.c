@@ -28,139 +28,231 @@
  */
 
 #include <VX/vx.h>
-#include <VX/vx_lib_debug.h>
-#include <VX/vx_lib_extras.h>
 #include <VX/vx_helper.h>
 
 #include <vx_internal.h>
-#include <math.h>
-
-
-static const vx_uint32 gaussian5x5scale = 256;
-static const vx_int16 gaussian5x5[5][5] =
-{
-    {1,  4,  6,  4, 1},
-    {4, 16, 24, 16, 4},
-    {6, 24, 36, 24, 6},
-    {4, 16, 24, 16, 4},
-    {1,  4,  6,  4, 1}
-};
+#include <c_model.h>
 
 static vx_param_description_t pyramid_kernel_params[] = {
     {VX_INPUT,  VX_TYPE_IMAGE,   VX_PARAMETER_STATE_REQUIRED},
     {VX_OUTPUT, VX_TYPE_PYRAMID, VX_PARAMETER_STATE_REQUIRED},
 };
 
-/*! \note Look at \ref vxPyramidNode to see how this pyramid construction works */
+/*! \brief Where each level of the pyramid samples the level above it, which is
+ * where a nearest neighbor scale of the whole level would sample it.
+ */
+typedef struct _vx_pyramid_level_t {
+    /*! \brief The source column of each destination column */
+    vx_int32 *xs;
+    /*! \brief The source row of each destination row */
+    vx_int32 *ys;
+    /*! \brief Whether xs[x] is 2x+1, as for the even levels of a half scale pyramid */
+    vx_bool half;
+} vx_pyramid_level_t;
 
-static vx_status VX_CALLBACK vxPyramidKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief The state shared by the strips of a pyramid level. */
+typedef struct _vx_pyramid_loop_t {
+    void *src_base;
+    vx_imagepatch_addressing_t src_addr;
+    void *dst_base;
+    vx_imagepatch_addressing_t dst_addr;
+    const vx_pyramid_level_t *level;
+    vx_border_mode_t borders;
+    vx_uint32 numStrips;
+    /*! \brief The scratch row of each strip */
+    vx_int32 *columns;
+    vx_size columnSize;
+} vx_pyramid_loop_t;
+
+static void vxPyramidStrip(void *arg, vx_uint32 strip)
 {
-    vx_status status = VX_FAILURE;
-    if (num == dimof(pyramid_kernel_params))
-    {
-        vx_graph graph = vxGetChildGraphOfNode(node);
-        status = vxProcessGraph(graph);
-    }
-    return status;
+    vx_pyramid_loop_t *loop = (vx_pyramid_loop_t *)arg;
+    vx_uint32 y0 = (vx_uint32)(((vx_uint64)loop->dst_addr.dim_y * strip) / loop->numStrips);
+    vx_uint32 y1 = (vx_uint32)(((vx_uint64)loop->dst_addr.dim_y * (strip + 1u)) / loop->numStrips);
+    vxGaussianPyramidRows(loop->src_base, &loop->src_addr, loop->dst_base, &loop->dst_addr,
+                          loop->level->xs, loop->level->ys, loop->level->half, y0, y1,
+                          &loop->borders, &loop->columns[strip * loop->columnSize]);
 }
 
-static vx_convolution vxCreateGaussian5x5Convolution(vx_context context)
+static vx_status vxCopyLevel(vx_image input, vx_image level0)
 {
-    vx_convolution conv = vxCreateConvolution(context, 5, 5);
-    vx_status status = vxAccessConvolutionCoefficients(conv, NULL);
-    if (status != VX_SUCCESS)
-    {
-        vxReleaseConvolution(&conv);
-        return NULL;
-    }
-    status = vxCommitConvolutionCoefficients(conv, (vx_int16 *)gaussian5x5);
-    if (status != VX_SUCCESS)
-    {
-        vxReleaseConvolution(&conv);
-        return NULL;
-    }
+    vx_status status = VX_SUCCESS;
+    void *src_base = NULL, *dst_base = NULL;
+    vx_imagepatch_addressing_t src_addr, dst_addr;
+    vx_rectangle_t rect;
+    vx_uint32 y;
 
-    vxSetConvolutionAttribute(conv, VX_CONVOLUTION_ATTRIBUTE_SCALE, (void *)&gaussian5x5scale, sizeof(vx_uint32));
-    if (status != VX_SUCCESS)
+    status |= vxGetValidRegionImage(input, &rect);
+    status |= vxAccessImagePatch(input, &rect, 0, &src_addr, &src_base, VX_READ_ONLY);
+    status |= vxAccessImagePatch(level0, &rect, 0, &dst_addr, &dst_base, VX_WRITE_ONLY);
+    if ((status == VX_SUCCESS) && (src_base != dst_base))
     {
-        vxReleaseConvolution(&conv);
-        return NULL;
+        for (y = 0u; y < src_addr.dim_y; y++)
+        {
+            memcpy(vxFormatImagePatchAddress2d(dst_base, 0, y, &dst_addr),
+                   vxFormatImagePatchAddress2d(src_base, 0, y, &src_addr),
+                   src_addr.dim_x * src_addr.stride_x);
+        }
     }
-    return conv;
+    status |= vxCommitImagePatch(input, NULL, 0, &src_addr, src_base);
+    status |= vxCommitImagePatch(level0, &rect, 0, &dst_addr, dst_base);
+    return status;
 }
 
-static vx_status VX_CALLBACK vxPyramidInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief Builds every level of the pyramid in one call. Each level convolves the
+ * level above it with the 5x5 Gaussian only where a nearest neighbor scale of the
+ * convolved level would sample it, and is computed in strips on the worker threads.
+ */
+static vx_status VX_CALLBACK vxPyramidKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
-    vx_status status = VX_ERROR_INVALID_PARAMETERS;
-    if (num == 2)
+    vx_status status = VX_FAILURE;
+    if (num == dimof(pyramid_kernel_params))
     {
-        vx_size lev, levels = 1;
-        vx_border_mode_t border;
         vx_image input = (vx_image)parameters[0];
         vx_pyramid gaussian = (vx_pyramid)parameters[1];
-        vx_context context = vxGetContext((vx_reference)node);
-        vx_graph graph = vxCreateGraph(context);
-        vx_enum interp = VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR;
-        status = vxLoadKernels(context, "openvx-debug");
-        if (status != VX_SUCCESS)
-        {
-            return status;
-        }
+        vx_pyramid_level_t *levels = NULL;
+        vx_threadpool_t *workers = node->base.context->workers;
+        vx_pyramid_loop_t loop;
+        vx_size lev, numLevels = 0;
+        vx_uint32 width = 0;
+
+        memset(&loop, 0, sizeof(loop));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &loop.borders, sizeof(loop.borders));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &levels, sizeof(levels));
+        vxQueryPyramid(gaussian, VX_PYRAMID_ATTRIBUTE_LEVELS, &numLevels, sizeof(numLevels));
+        vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width));
+        if ((levels == NULL) && (numLevels > 1))
+            return VX_ERROR_NOT_ALLOCATED;
+
+        loop.numStrips = (workers ? workers->numWorkers + 1u : 1u);
+        loop.columnSize = width + 4u;
+        loop.columns = (vx_int32 *)malloc(loop.numStrips * loop.columnSize * sizeof(vx_int32));
+        if (loop.columns == NULL)
+            return VX_ERROR_NO_MEMORY;
 
-        status = vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &border, sizeof(border));
-        if (status != VX_SUCCESS)
-        {
-            return status;
-        }
-        if (graph)
         {
             vx_image level0 = vxGetPyramidLevel(gaussian, 0);
-            vx_node copy = vxCopyImageNode(graph, input, level0);
+            status = vxCopyLevel(input, level0);
             vxReleaseImage(&level0);
-            status |= vxQueryPyramid(gaussian, VX_PYRAMID_ATTRIBUTE_LEVELS, &levels, sizeof(levels));
-            for (lev = 1; lev < levels; lev++)
-            {
-                /*! \internal Scaling is already precomputed for each level by the \ref vxCreatePyramid function */
-                vx_image tmp0 = (lev-1==0 ? input : vxGetPyramidLevel(gaussian, (vx_uint32)lev-1));
-                vx_image tmp1 = vxGetPyramidLevel(gaussian, (vx_uint32)lev);
-                vx_image virt = vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8);
-                vx_convolution conv = vxCreateGaussian5x5Convolution(context);
-                vx_node  gtmp = vxConvolveNode(graph, tmp0, conv, virt);
-                vx_node  stmp = vxScaleImageNode(graph, virt, tmp1, interp);
-
-                vxSetNodeAttribute(gtmp, VX_NODE_ATTRIBUTE_BORDER_MODE, &border, sizeof(border));
-                /* decrements the references */
-                if (lev > 1) vxReleaseImage(&tmp0);
-                vxReleaseConvolution(&conv);
-                vxReleaseImage(&tmp1);
-                vxReleaseImage(&virt);
-                vxReleaseNode(&gtmp);
-                vxReleaseNode(&stmp);
-            }
-            vxReleaseNode(&copy);
-            status = vxVerifyGraph(graph);
+        }
+        for (lev = 1; (lev < numLevels) && (status == VX_SUCCESS); lev++)
+        {
+            vx_image src = (lev == 1 ? input : vxGetPyramidLevel(gaussian, (vx_uint32)lev - 1));
+            vx_image dst = vxGetPyramidLevel(gaussian, (vx_uint32)lev);
+            vx_rectangle_t src_rect, dst_rect;
+
+            loop.src_base = loop.dst_base = NULL;
+            loop.level = &levels[lev];
+            status |= vxGetValidRegionImage(src, &src_rect);
+            status |= vxGetValidRegionImage(dst, &dst_rect);
+            status |= vxAccessImagePatch(src, &src_rect, 0, &loop.src_addr, &loop.src_base, VX_READ_ONLY);
+            status |= vxAccessImagePatch(dst, &dst_rect, 0, &loop.dst_addr, &loop.dst_base, VX_WRITE_ONLY);
             if (status == VX_SUCCESS)
             {
-                status = VX_SUCCESS;
-                status |= vxAddParameterToGraphByIndex(graph, node, 0); // img
-                status |= vxAddParameterToGraphByIndex(graph, node, 1); // pyr
-                status = vxSetChildGraphOfNode(node, graph);
+                vx_uint32 numStrips = loop.numStrips;
+                if (loop.numStrips > loop.dst_addr.dim_y)
+                    loop.numStrips = loop.dst_addr.dim_y;
+                vxParallelLoop(workers, loop.numStrips, vxPyramidStrip, &loop);
+                loop.numStrips = numStrips;
             }
+            status |= vxCommitImagePatch(src, NULL, 0, &loop.src_addr, loop.src_base);
+            status |= vxCommitImagePatch(dst, &dst_rect, 0, &loop.dst_addr, loop.dst_base);
+            if (lev > 1)
+                vxReleaseImage(&src);
+            vxReleaseImage(&dst);
         }
+        free(loop.columns);
     }
     return status;
 }
 
-static vx_status VX_CALLBACK vxPyramidDeinitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
+/*! \brief Computes where each level samples the level above it into the local data
+ * of the node, replacing the tables of an earlier verification.
+ */
+static vx_status VX_CALLBACK vxPyramidInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
     if (num == dimof(pyramid_kernel_params))
     {
-        vx_graph graph = vxGetChildGraphOfNode(node);
-        vxReleaseGraph(&graph);
-        /* set graph to "null" */
-        vxSetChildGraphOfNode(node, 0);
-        status = VX_SUCCESS;
+        vx_pyramid gaussian = (vx_pyramid)parameters[1];
+        vx_pyramid_level_t *levels = NULL;
+        vx_uint32 w[2] = {0, 0}, h[2] = {0, 0};
+        vx_size lev, numLevels = 0, size = 0;
+        vx_int32 *next;
+
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &levels, sizeof(levels));
+        free(levels);
+        levels = NULL;
+
+        status = vxQueryPyramid(gaussian, VX_PYRAMID_ATTRIBUTE_LEVELS, &numLevels, sizeof(numLevels));
+        size = numLevels * sizeof(vx_pyramid_level_t);
+        for (lev = 1; (lev < numLevels) && (status == VX_SUCCESS); lev++)
+        {
+            vx_image image = vxGetPyramidLevel(gaussian, (vx_uint32)lev);
+            status |= vxQueryImage(image, VX_IMAGE_ATTRIBUTE_WIDTH, &w[0], sizeof(w[0]));
+            status |= vxQueryImage(image, VX_IMAGE_ATTRIBUTE_HEIGHT, &h[0], sizeof(h[0]));
+            size += (w[0] + h[0]) * sizeof(vx_int32);
+            vxReleaseImage(&image);
+        }
+        if (status == VX_SUCCESS)
+        {
+            levels = (vx_pyramid_level_t *)calloc(1, size);
+            if (levels == NULL)
+                status = VX_ERROR_NO_MEMORY;
+        }
+        next = (vx_int32 *)&levels[numLevels];
+        for (lev = 1; (lev < numLevels) && (status == VX_SUCCESS); lev++)
+        {
+            vx_image src = vxGetPyramidLevel(gaussian, (vx_uint32)lev - 1);
+            vx_image dst = vxGetPyramidLevel(gaussian, (vx_uint32)lev);
+            vx_scale_tables_t *tables = NULL;
+            vx_size tsize = 0;
+            vx_uint32 i;
+
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &w[0], sizeof(w[0]));
+            vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &h[0], sizeof(h[0]));
+            vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_WIDTH, &w[1], sizeof(w[1]));
+            vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_HEIGHT, &h[1], sizeof(h[1]));
+            vxReleaseImage(&src);
+            vxReleaseImage(&dst);
+
+            tsize = vxScaleTablesSize(VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, w[0], h[0], w[1], h[1]);
+            tables = (vx_scale_tables_t *)malloc(tsize);
+            if ((tsize == 0) || (tables == NULL))
+            {
+                status = (tsize == 0 ? VX_ERROR_INVALID_DIMENSION : VX_ERROR_NO_MEMORY);
+                free(tables);
+                break;
+            }
+            vxScaleTables(VX_INTERPOLATION_TYPE_NEAREST_NEIGHBOR, w[0], h[0], w[1], h[1], tables, tsize);
+            levels[lev].xs = next;
+            next += w[1];
+            levels[lev].ys = next;
+            next += h[1];
+            levels[lev].half = vx_true_e;
+            /* the Gaussian is centered on the sample, which is kept inside of the level above */
+            for (i = 0u; i < w[1]; i++)
+            {
+                vx_int32 x = tables->x.start[i];
+                levels[lev].xs[i] = (x < 0 ? 0 : x >= (vx_int32)w[0] ? (vx_int32)w[0] - 1 : x);
+                if (levels[lev].xs[i] != (vx_int32)(2u * i + 1u))
+                    levels[lev].half = vx_false_e;
+            }
+            for (i = 0u; i < h[1]; i++)
+            {
+                vx_int32 y = tables->y.start[i];
+                levels[lev].ys[i] = (y < 0 ? 0 : y >= (vx_int32)h[0] ? (vx_int32)h[0] - 1 : y);
+            }
+            free(tables);
+        }
+        if (status != VX_SUCCESS)
+        {
+            free(levels);
+            levels = NULL;
+            size = 0;
+        }
+        vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &levels, sizeof(levels));
+        vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
     }
     return status;
 }
@@ -245,7 +337,7 @@ vx_kernel_description_t pyramid_kernel = {
     vxPyramidInputValidator,
     vxPyramidOutputValidator,
     vxPyramidInitializer,
-    vxPyramidDeinitializer,
+    NULL,
 };
 
 
@@ -35,18 +35,6 @@
 #include <stdio.h>
 #include <math.h>
 
-/* Specification 1.0, on AREA interpolation method: "The details of this
- * sampling method are implementation defined. The implementation should
- * perform enough sampling to avoid aliasing, but there is no requirement
- * that the sample areas for adjacent output pixels be disjoint, nor that
- * the pixels be weighted evenly."
- *
- * The existing implementation of AREA can use too much heap in certain
- * circumstances, so disabling for now, and using NEAREST_NEIGHBOR instead,
- * as it also passes conformance for AREA interpolation.
- */
-#define AREA_SCALE_ENABLE 0 /* TODO enable this again after changing implementation in kernels/c_model/c_scale.c */
-
 static vx_status VX_CALLBACK vxScaleImageKernel(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     if (num == 3)
@@ -55,18 +43,21 @@ static vx_status VX_CALLBACK vxScaleImageKernel(vx_node node, vx_reference *para
         vx_image  dst_image = (vx_image) parameters[1];
         vx_scalar stype     = (vx_scalar)parameters[2];
         vx_border_mode_t bordermode = {VX_BORDER_MODE_UNDEFINED, 0};
-        vx_float64 *interm = NULL;
+        vx_scale_tables_t *tables = NULL;
         vx_size size = 0ul;
 
         vxQueryNode(node, VX_NODE_ATTRIBUTE_BORDER_MODE, &bordermode, sizeof(bordermode));
-        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &interm, sizeof(interm));
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &tables, sizeof(tables));
         vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE,&size, sizeof(size));
 
-        return vxScaleImage(src_image, dst_image, stype, &bordermode, interm, size);
+        return vxScaleImage(src_image, dst_image, stype, &bordermode, tables, size);
     }
     return VX_ERROR_INVALID_PARAMETERS;
 }
 
+/*! \brief Builds the polyphase tables of the scale into the local data of the node,
+ * replacing the ones of an earlier verification.
+ */
 static vx_status VX_CALLBACK vxScaleImageInitializer(vx_node node, vx_reference *parameters, vx_uint32 num)
 {
     vx_status status = VX_ERROR_INVALID_PARAMETERS;
@@ -74,32 +65,33 @@ static vx_status VX_CALLBACK vxScaleImageInitializer(vx_node node, vx_reference
     {
         vx_image src = (vx_image)parameters[0];
         vx_image dst = (vx_image)parameters[1];
+        vx_scalar stype = (vx_scalar)parameters[2];
         vx_uint32 w1 = 0, h1 = 0, w2 = 0, h2 = 0;
-#if AREA_SCALE_ENABLE
-        vx_uint32 gcd_w = 0, gcd_h = 0;
-#endif
+        vx_enum type = 0;
+        vx_scale_tables_t *tables = NULL;
         vx_size size = 0;
 
         vxQueryImage(src, VX_IMAGE_ATTRIBUTE_WIDTH, &w1, sizeof(w1));
         vxQueryImage(src, VX_IMAGE_ATTRIBUTE_HEIGHT, &h1, sizeof(h1));
         vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_WIDTH, &w2, sizeof(w2));
         vxQueryImage(dst, VX_IMAGE_ATTRIBUTE_HEIGHT, &h2, sizeof(h2));
+        if (stype)
+            vxAccessScalarValue(stype, &type);
+
+        vxQueryNode(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &tables, sizeof(tables));
+        free(tables);
+        tables = NULL;
 
-/* AREA interpolation requires a scratch buffer, however, if AREA
- * implementation is disabled, then no scratch buffer is required, and
- * size can be 0 (setting to 1 so that checks can pass in the kernel) */
-#if AREA_SCALE_ENABLE
-        gcd_w = math_gcd(w1,w2);
-        gcd_h = math_gcd(h1,h2);
-        /* printf("%ux%u => %ux%u :: GCD_w %u GCD_h %u\n", w1,h1, w2,h2, gcd_w, gcd_h); */
-        if (gcd_w != 0 && gcd_h != 0)
+        size = vxScaleTablesSize(type, w1, h1, w2, h2);
+        if (size > 0ul)
         {
-            size = (w1 / gcd_w) * (w2 / gcd_w) * (h1 / gcd_h) * (h2 / gcd_h) * sizeof(vx_float64);
+            tables = (vx_scale_tables_t *)malloc(size);
+            if (tables)
+                vxScaleTables(type, w1, h1, w2, h2, tables, size);
+            else
+                size = 0ul;
         }
-        /* printf("Requesting "VX_FMT_SIZE" bytes for resizer\n", size); */
-#else
-        size = 1;
-#endif
+        vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_PTR, &tables, sizeof(tables));
         vxSetNodeAttribute(node, VX_NODE_ATTRIBUTE_LOCAL_DATA_SIZE, &size, sizeof(size));
         status = VX_SUCCESS;
     }
@@ -28,6 +28,9 @@
 #if defined(EXPERIMENTAL_USE_XML)
 #include <VX/vx_khr_xml.h>
 #endif
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+#include <VX/vx_ext_image_handle.h>
+#endif
 #include <VX/vx_lib_debug.h>
 #include <VX/vx_lib_extras.h>
 
@@ -491,7 +494,12 @@ int main(int argc, char *argv[])
                     dispIdx = cap + dimof(captures);
                     printf("camIdx = %u, dispIdx = %u\n", camIdx, dispIdx);
                     SDL_LockSurface(backplanes[cap]);
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+                    // the first capture image stays bound and is pointed at each buffer
+                    status = vxSwapImageHandle(images[0], &captures[camIdx], NULL, 1);
+#else
                     status = vxSetGraphParameterByIndex(graph, 0, (vx_reference)images[camIdx]);
+#endif
                     assert(status == VX_SUCCESS);
                     status = vxSetGraphParameterByIndex(graph, 2, (vx_reference)images[dispIdx]);
                     assert(status == VX_SUCCESS);
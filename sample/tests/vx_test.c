@@ -54,6 +54,18 @@
 #include <VX/vx_khr_variants.h>
 #endif
 
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+#include <VX/vx_ext_pipelining.h>
+#endif
+
+#if defined(EXPERIMENTAL_USE_MEMORY_PLAN)
+#include <VX/vx_ext_memory_plan.h>
+#endif
+
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+#include <VX/vx_ext_image_handle.h>
+#endif
+
 #include <VX/vx_helper.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -753,6 +765,259 @@ exit:
     return status;
 }
 
+/*!
+ * \brief Tests that a context holds more references than its initial table
+ * and that released slots are handed out again.
+ * \ingroup group_tests
+ */
+vx_status vx_test_framework_references(int argc, char *argv[])
+{
+#define NUM_REFS_TEST (1500)
+    vx_status status = VX_FAILURE;
+    vx_uint32 i, start = 0u, count = 0u;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_image *images = (vx_image *)calloc(NUM_REFS_TEST, sizeof(vx_image));
+        if (images == NULL)
+        {
+            status = VX_ERROR_NO_MEMORY;
+            goto exit;
+        }
+        status = vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_REFERENCES, &start, sizeof(start));
+        if (status != VX_SUCCESS)
+            goto exit;
+        for (i = 0u; i < NUM_REFS_TEST; i++)
+        {
+            images[i] = vxCreateImage(context, 16, 16, VX_DF_IMAGE_U8);
+            status = vxGetStatus((vx_reference)images[i]);
+            if (status != VX_SUCCESS)
+            {
+                VFAIL(exit, "Failed to create image %u of %u\n", i, NUM_REFS_TEST);
+            }
+        }
+        vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_REFERENCES, &count, sizeof(count));
+        if (count != start + NUM_REFS_TEST)
+        {
+            VFAIL(exit, "Expected %u references, found %u\n", start + NUM_REFS_TEST, count);
+        }
+        /* punch a hole into the table and fill it again */
+        for (i = 100u; i < 200u; i += 2u)
+        {
+            vxReleaseImage(&images[i]);
+        }
+        vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_REFERENCES, &count, sizeof(count));
+        if (count != start + NUM_REFS_TEST - 50u)
+        {
+            VFAIL(exit, "Expected %u references, found %u\n", start + NUM_REFS_TEST - 50u, count);
+        }
+        for (i = 100u; i < 200u; i += 2u)
+        {
+            images[i] = vxCreateImage(context, 16, 16, VX_DF_IMAGE_U8);
+            status = vxGetStatus((vx_reference)images[i]);
+            if (status != VX_SUCCESS)
+            {
+                VFAIL(exit, "Failed to create image %u in the hole\n", i);
+            }
+        }
+        vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_REFERENCES, &count, sizeof(count));
+        if (count != start + NUM_REFS_TEST)
+        {
+            VFAIL(exit, "Expected %u references, found %u\n", start + NUM_REFS_TEST, count);
+        }
+        for (i = 0u; i < NUM_REFS_TEST; i++)
+        {
+            vxReleaseImage(&images[i]);
+        }
+        vxQueryContext(context, VX_CONTEXT_ATTRIBUTE_REFERENCES, &count, sizeof(count));
+        if (count != start)
+        {
+            VFAIL(exit, "Expected %u references after release, found %u\n", start, count);
+        }
+        status = VX_SUCCESS;
+exit:
+        if (images)
+        {
+            for (i = 0u; i < NUM_REFS_TEST; i++)
+            {
+                if (images[i])
+                    vxReleaseImage(&images[i]);
+            }
+            free(images);
+        }
+        vxReleaseContext(&context);
+    }
+#undef NUM_REFS_TEST
+    return status;
+}
+
+/*!
+ * \brief Tests that mapped readers share a rectangle, that a writer has it to
+ * itself and that an access which could never be granted fails instead of waiting.
+ * \ingroup group_tests
+ */
+vx_status vx_test_framework_access_locks(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_uint32 w = 64, h = 48;
+    vx_uint32 errors = 0u;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_image a = vxCreateImage(context, w, h, VX_DF_IMAGE_U8);
+        vx_image b = vxCreateImage(context, w, h, VX_DF_IMAGE_U8);
+        vx_rectangle_t r1 = {0, 0, 32, 32};
+        vx_rectangle_t r2 = {16, 16, 48, 48};
+        vx_rectangle_t r3 = {48, 0, 64, 16};
+        vx_rectangle_t r4 = {0, 0, 16, 16};
+        vx_rectangle_t r5 = {0, 0, 64, 48};
+        vx_rectangle_t r6 = {32, 32, 48, 48};
+        vx_imagepatch_addressing_t addr1, addr2, addr3;
+        void *base1 = NULL, *base2 = NULL, *base3 = NULL;
+
+        if (vxGetStatus((vx_reference)a) != VX_SUCCESS ||
+            vxGetStatus((vx_reference)b) != VX_SUCCESS)
+        {
+            FAIL(exit, "Failed to create the images\n");
+        }
+        status = vxLoadKernels(context, "openvx-debug");
+        status |= vxuFillImage(context, 0x10, a);
+        status |= vxuFillImage(context, 0x20, b);
+        if (status != VX_SUCCESS)
+        {
+            FAIL(exit, "Failed to fill the images\n");
+        }
+
+        /* overlapping readers share */
+        status = vxAccessImagePatch(a, &r1, 0, &addr1, &base1, VX_READ_ONLY);
+        status |= vxAccessImagePatch(a, &r2, 0, &addr2, &base2, VX_READ_ONLY);
+        if (status != VX_SUCCESS || base1 == NULL || base2 == NULL)
+        {
+            FAIL(exit, "Overlapping readers did not share the image\n");
+        }
+        if (vxuNot(context, a, b) != VX_SUCCESS ||
+            vxuCheckImage(context, b, 0xFF - 0x10, &errors) != VX_SUCCESS)
+        {
+            FAIL(exit, "A graph could not read an image the application reads\n");
+        }
+
+        /* a writer is kept out by the readers, and fails as nothing would let it in */
+        if (vxAccessImagePatch(a, &r2, 0, &addr3, &base3, VX_WRITE_ONLY) == VX_SUCCESS)
+        {
+            FAIL(exit, "A writer was let into a rectangle under readers\n");
+        }
+        if (vxuNot(context, b, a) == VX_SUCCESS)
+        {
+            FAIL(exit, "A graph wrote to an image the application reads\n");
+        }
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+        {
+            /* a scheduled frame is refused the same way */
+            vx_uint32 depth = 2;
+            vx_graph graph = vxCreateGraph(context);
+            vx_node node = vxNotNode(graph, b, a);
+            vx_parameter param = vxGetParameterByIndex(node, 1);
+            status = vxAddParameterToGraph(graph, param);
+            status |= vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH, &depth, sizeof(depth));
+            status |= vxVerifyGraph(graph);
+            if (status == VX_SUCCESS && vxScheduleGraph(graph) == VX_SUCCESS)
+            {
+                /* let the frame finish before failing */
+                vxCommitImagePatch(a, NULL, 0, &addr1, base1);
+                vxCommitImagePatch(a, NULL, 0, &addr2, base2);
+                base1 = base2 = NULL;
+                vxWaitGraph(graph);
+                status = VX_FAILURE;
+            }
+            vxReleaseParameter(&param);
+            vxReleaseNode(&node);
+            vxReleaseGraph(&graph);
+            if (status != VX_SUCCESS)
+            {
+                FAIL(exit, "A pipelined graph was scheduled to write to an image the application reads\n");
+            }
+        }
+#endif
+        status = vxCommitImagePatch(a, NULL, 0, &addr1, base1);
+        status |= vxCommitImagePatch(a, NULL, 0, &addr2, base2);
+        base1 = base2 = base3 = NULL;
+        if (status != VX_SUCCESS)
+        {
+            FAIL(exit, "Failed to commit the readers\n");
+        }
+
+        /* once they are gone the writer has the rectangle to itself */
+        status = vxAccessImagePatch(a, &r2, 0, &addr2, &base2, VX_WRITE_ONLY);
+        if (status != VX_SUCCESS || base2 == NULL)
+        {
+            FAIL(exit, "The writer was not let in after the readers left\n");
+        }
+        if (vxAccessImagePatch(a, &r1, 0, &addr1, &base1, VX_READ_ONLY) == VX_SUCCESS)
+        {
+            FAIL(exit, "A reader was let into the rectangle of a writer\n");
+        }
+        base1 = NULL;
+        status = vxAccessImagePatch(a, &r3, 0, &addr3, &base3, VX_READ_ONLY);
+        status |= vxCommitImagePatch(a, NULL, 0, &addr3, base3);
+        base3 = NULL;
+        if (status != VX_SUCCESS)
+        {
+            FAIL(exit, "A reader of a disjoint rectangle was kept out by the writer\n");
+        }
+        status = vxCommitImagePatch(a, &r2, 0, &addr2, base2);
+        base2 = NULL;
+        if (status != VX_SUCCESS)
+        {
+            FAIL(exit, "Failed to commit the writer\n");
+        }
+
+        /* readers which start at the same pixel share a pointer, but not their rectangles */
+        status = vxAccessImagePatch(a, &r5, 0, &addr2, &base2, VX_READ_ONLY);
+        status |= vxAccessImagePatch(a, &r4, 0, &addr1, &base1, VX_READ_ONLY);
+        if (status != VX_SUCCESS || base1 != base2)
+        {
+            FAIL(exit, "Readers of the same corner were not given the same pointer\n");
+        }
+        status = vxCommitImagePatch(a, NULL, 0, &addr1, base1);
+        base1 = NULL;
+        if (status != VX_SUCCESS)
+        {
+            FAIL(exit, "Failed to commit the smaller reader\n");
+        }
+        if (vxAccessImagePatch(a, &r6, 0, &addr3, &base3, VX_WRITE_ONLY) == VX_SUCCESS)
+        {
+            FAIL(exit, "A writer was let in under the larger reader\n");
+        }
+        base3 = NULL;
+        status = vxCommitImagePatch(a, NULL, 0, &addr2, base2);
+        base2 = NULL;
+        status |= vxAccessImagePatch(a, &r6, 0, &addr3, &base3, VX_WRITE_ONLY);
+        status |= vxCommitImagePatch(a, &r6, 0, &addr3, base3);
+        base3 = NULL;
+        if (status != VX_SUCCESS)
+        {
+            FAIL(exit, "The writer was not let in after the larger reader left\n");
+        }
+
+        status = vxuNot(context, b, a);
+        if (status != VX_SUCCESS ||
+            vxuCheckImage(context, a, 0x10, &errors) != VX_SUCCESS)
+        {
+            FAIL(exit, "A graph could not write to the image after its accesses\n");
+        }
+        ALARM("Passed!");
+exit:
+        if (base1)
+            vxCommitImagePatch(a, NULL, 0, &addr1, base1);
+        if (base2)
+            vxCommitImagePatch(a, NULL, 0, &addr2, base2);
+        vxReleaseImage(&b);
+        vxReleaseImage(&a);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
 /*!
  * \brief Tests delay object creation.
  * \ingroup group_tests
@@ -951,6 +1216,418 @@ exit:
     return status;
 }
 
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+/*!
+ * \brief Test that a pipelined graph can be processed as soon as every
+ * scheduled frame has been waited on.
+ * \ingroup group_tests
+ */
+vx_status vx_test_framework_pipeline_process(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 w = 320, h = 240, depth = 3, r, f, i;
+        vx_uint32 errors = 0u;
+        vx_image images[] = {
+            vxCreateImage(context, w, h, VX_DF_IMAGE_U8),
+            vxCreateImage(context, w, h, VX_DF_IMAGE_U8),
+        };
+        vx_graph graph = vxCreateGraph(context);
+        status = vxLoadKernels(context, "openvx-debug");
+        if (graph && status == VX_SUCCESS)
+        {
+            vx_image virts[] = {
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_VIRT),
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_VIRT),
+            };
+            vx_node nodes[] = {
+                vxNotNode(graph, images[0], virts[0]),
+                vxNotNode(graph, virts[0], virts[1]),
+                vxAddNode(graph, virts[1], images[0], VX_CONVERT_POLICY_SATURATE, images[1]),
+            };
+            CHECK_ALL_ITEMS(virts, i, status, exit);
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            status = vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH, &depth, sizeof(depth));
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            for (r = 0u; (r < 10u) && (status == VX_SUCCESS); r++)
+            {
+                status = vxuFillImage(context, r, images[0]);
+                for (f = 0u; (f < depth) && (status == VX_SUCCESS); f++)
+                    status = vxScheduleGraph(graph);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Failed to schedule frame %u of round %u, status=%d", f, r, status);
+                for (f = 0u; (f < depth) && (status == VX_SUCCESS); f++)
+                    status = vxWaitGraph(graph);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Failed to wait on frame %u of round %u, status=%d", f, r, status);
+                /* the pipeline must have let go of the nodes */
+                status = vxProcessGraph(graph);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Failed to process the graph after round %u, status=%d", r, status);
+                status = vxuCheckImage(context, images[1], 2u * r, &errors);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Round %u has %u errors", r, errors);
+            }
+exit:
+            for (i = 0u; i < dimof(virts); i++)
+                vxReleaseImage(&virts[i]);
+            vxReleaseGraph(&graph);
+        }
+        for (i = 0u; i < dimof(images); i++)
+            vxReleaseImage(&images[i]);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+
+/*!
+ * \brief Test that each frame of a pipelined graph executes with the graph
+ * parameters it was scheduled with, while earlier frames are still outstanding,
+ * and that parameters which don't match the verified ones are refused then.
+ * \ingroup group_tests
+ */
+vx_status vx_test_framework_pipeline_frames(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 w = 320, h = 240, depth = 3, f, i, waited = 0u;
+        vx_uint32 errors = 0u;
+        vx_image inputs[8], outputs[8];
+        vx_image narrow = vxCreateImage(context, w / 2, h, VX_DF_IMAGE_U8);
+        vx_image wide = vxCreateImage(context, w, h, VX_DF_IMAGE_S16);
+        vx_graph graph = vxCreateGraph(context);
+        for (f = 0u; f < dimof(inputs); f++)
+        {
+            inputs[f] = vxCreateImage(context, w, h, VX_DF_IMAGE_U8);
+            outputs[f] = vxCreateImage(context, w, h, VX_DF_IMAGE_U8);
+        }
+        status = vxLoadKernels(context, "openvx-debug");
+        if (graph && narrow && wide && status == VX_SUCCESS)
+        {
+            vx_image virts[] = {
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8),
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8),
+            };
+            /* out = ~(2 * ~in) */
+            vx_node nodes[] = {
+                vxNotNode(graph, inputs[0], virts[0]),
+                vxAddNode(graph, virts[0], virts[0], VX_CONVERT_POLICY_SATURATE, virts[1]),
+                vxNotNode(graph, virts[1], outputs[0]),
+            };
+            vx_parameter params[2];
+            CHECK_ALL_ITEMS(virts, i, status, exit);
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            params[0] = vxGetParameterByIndex(nodes[0], 0);
+            params[1] = vxGetParameterByIndex(nodes[2], 1);
+            status |= vxAddParameterToGraph(graph, params[0]);
+            status |= vxAddParameterToGraph(graph, params[1]);
+            vxReleaseParameter(&params[0]);
+            vxReleaseParameter(&params[1]);
+            for (f = 0u; (f < dimof(inputs)) && (status == VX_SUCCESS); f++)
+            {
+                status |= vxuFillImage(context, 200u + f, inputs[f]);
+                status |= vxuFillImage(context, 0u, outputs[f]);
+            }
+            if (status == VX_SUCCESS)
+                status = vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_PIPELINE_DEPTH, &depth, sizeof(depth));
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            for (f = 0u; (f < dimof(inputs)) && (status == VX_SUCCESS); f++)
+            {
+                /* keep the pipeline full, the parameters are captured by the schedule */
+                if ((f >= depth) && ((status = vxWaitGraph(graph)) != VX_SUCCESS))
+                    VFAIL(exit, "Failed to wait on frame %u, status=%d", waited, status);
+                if (f >= depth)
+                    waited++;
+                status |= vxSetGraphParameterByIndex(graph, 0, (vx_reference)inputs[f]);
+                status |= vxSetGraphParameterByIndex(graph, 1, (vx_reference)outputs[f]);
+                if (status == VX_SUCCESS)
+                    status = vxScheduleGraph(graph);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Failed to schedule frame %u, status=%d", f, status);
+                /* the frame is outstanding, so the graph is not verified again */
+                if ((vxSetGraphParameterByIndex(graph, 0, (vx_reference)narrow) != VX_ERROR_INVALID_DIMENSION) ||
+                    (vxSetGraphParameterByIndex(graph, 1, (vx_reference)wide) != VX_ERROR_INVALID_FORMAT))
+                    VFAIL(exit, "Set mismatched parameters after frame %u", f);
+            }
+            for (; (waited < dimof(inputs)) && (status == VX_SUCCESS); waited++)
+            {
+                status = vxWaitGraph(graph);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Failed to wait on frame %u, status=%d", waited, status);
+            }
+            for (f = 0u; (f < dimof(outputs)) && (status == VX_SUCCESS); f++)
+            {
+                vx_uint32 in = 200u + f;
+                status = vxuCheckImage(context, outputs[f], 255u - 2u * (255u - in), &errors);
+                if (status != VX_SUCCESS)
+                    VFAIL(exit, "Frame %u has %u errors", f, errors);
+            }
+exit:
+            for (i = 0u; i < dimof(virts); i++)
+                vxReleaseImage(&virts[i]);
+            vxReleaseGraph(&graph);
+        }
+        for (f = 0u; f < dimof(inputs); f++)
+        {
+            vxReleaseImage(&inputs[f]);
+            vxReleaseImage(&outputs[f]);
+        }
+        vxReleaseImage(&narrow);
+        vxReleaseImage(&wide);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+#endif
+
+#if defined(EXPERIMENTAL_USE_MEMORY_PLAN)
+/*! \brief The alignment of the objects in the arena, VX_INT_ARENA_ALIGNMENT of the framework. */
+#define VX_TEST_ARENA_ALIGNMENT (64)
+
+/*!
+ * \brief Test that the virtual images of a chain share their storage once the
+ * graph is verified, and that the chain still computes the right result.
+ * \ingroup group_tests
+ */
+vx_status vx_test_framework_memory_plan(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        vx_uint32 w = 320, h = 240, i;
+        vx_uint32 errors = 0u;
+        vx_size planned = 0, naive = 0;
+        vx_image input = vxCreateImage(context, w, h, VX_DF_IMAGE_U8);
+        vx_image output = vxCreateImage(context, w, h, VX_DF_IMAGE_U8);
+        vx_graph graph = vxCreateGraph(context);
+        status = vxLoadKernels(context, "openvx-debug");
+        if (graph && status == VX_SUCCESS)
+        {
+            vx_image virts[] = {
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8),
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8),
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8),
+                vxCreateVirtualImage(graph, 0, 0, VX_DF_IMAGE_U8),
+            };
+            vx_node nodes[] = {
+                vxNotNode(graph, input, virts[0]),
+                vxNotNode(graph, virts[0], virts[1]),
+                vxNotNode(graph, virts[1], virts[2]),
+                vxNotNode(graph, virts[2], virts[3]),
+                vxNotNode(graph, virts[3], output),
+            };
+            CHECK_ALL_ITEMS(virts, i, status, exit);
+            CHECK_ALL_ITEMS(nodes, i, status, exit);
+            status |= vxuFillImage(context, 0x3C, input);
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            if (status == VX_SUCCESS)
+            {
+                status |= vxQueryGraph(graph, VX_GRAPH_ATTRIBUTE_PLANNED_MEMORY, &planned, sizeof(planned));
+                status |= vxQueryGraph(graph, VX_GRAPH_ATTRIBUTE_NAIVE_MEMORY, &naive, sizeof(naive));
+            }
+            if (status != VX_SUCCESS)
+                VFAIL(exit, "Failed to verify or query the graph, status=%d", status);
+            /* only two of the images in the chain are ever live at once */
+            if ((naive < dimof(virts) * w * h) || (planned < 2 * w * h) ||
+                (planned > 2 * (w * h + VX_TEST_ARENA_ALIGNMENT)))
+                VFAIL(exit, "Planned "VX_FMT_SIZE" bytes for "VX_FMT_SIZE" bytes instead of two images", planned, naive);
+            status = vxProcessGraph(graph);
+            if (status == VX_SUCCESS)
+                status = vxuCheckImage(context, output, 0xFF - 0x3C, &errors);
+            if (status != VX_SUCCESS)
+                VFAIL(exit, "The chain has %u errors, status=%d", errors, status);
+exit:
+            for (i = 0u; i < dimof(virts); i++)
+                vxReleaseImage(&virts[i]);
+            vxReleaseGraph(&graph);
+        }
+        vxReleaseImage(&input);
+        vxReleaseImage(&output);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+#endif
+
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+/*! \brief The planes returned through the image handle callback. */
+static void *handle_returned[4];
+static vx_uint32 handle_num_returned;
+
+static void VX_CALLBACK vx_test_handle_returned(vx_image image, void *ptrs[], vx_uint32 num_planes, void *user_data)
+{
+    if ((num_planes == 1u) && (handle_num_returned < dimof(handle_returned)))
+        handle_returned[handle_num_returned++] = ptrs[0];
+}
+
+/*! \brief The library of the blocking kernel of the image handle test. */
+#define VX_LIBRARY_TEST_HANDLE (0x4)
+
+/*! \brief The framework atomics of vx_osal.h, which needs the internal headers. */
+extern vx_uint32 vxAtomicLoad(volatile vx_uint32 *ptr);
+extern void vxAtomicStore(volatile vx_uint32 *ptr, vx_uint32 value);
+
+/*! \brief The state shared with the blocking kernel, which records the first
+ * pixel of its input and then waits for the test to let it go. The flags are
+ * only accessed atomically.
+ */
+static vx_uint32 handle_kernel_entered, handle_kernel_released;
+static vx_uint8 handle_kernel_pixel;
+
+static vx_status VX_CALLBACK vx_test_handle_kernel(vx_node node, vx_reference *parameters, vx_uint32 num)
+{
+    vx_status status = VX_SUCCESS;
+    vx_rectangle_t rect = {0, 0, 1, 1};
+    vx_imagepatch_addressing_t addr;
+    void *base = NULL;
+    status = vxAccessImagePatch((vx_image)parameters[0], &rect, 0, &addr, &base, VX_READ_ONLY);
+    if (status == VX_SUCCESS)
+    {
+        handle_kernel_pixel = *(vx_uint8 *)base;
+        status = vxCommitImagePatch((vx_image)parameters[0], NULL, 0, &addr, base);
+    }
+    vxAtomicStore(&handle_kernel_entered, 1u);
+    while (vxAtomicLoad(&handle_kernel_released) == 0u)
+        ;
+    return status;
+}
+
+static vx_status VX_CALLBACK vx_test_handle_input(vx_node node, vx_uint32 index)
+{
+    return VX_SUCCESS;
+}
+
+static vx_status VX_CALLBACK vx_test_handle_output(vx_node node, vx_uint32 index, vx_meta_format meta)
+{
+    return VX_ERROR_INVALID_PARAMETERS;
+}
+
+/*!
+ * \brief Test swapping the planes of an image created from a handle, while
+ * idle and while a scheduled graph holds the image, the release of exactly
+ * the images a graph held when its node is rebound meanwhile, and the return
+ * of the planes through the callback.
+ * \ingroup group_tests
+ */
+vx_status vx_test_framework_image_handle(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_context context = vxCreateContext();
+    if (context)
+    {
+        enum { W = 64, H = 48 };
+        static vx_uint8 planes[5][H][W];
+        vx_imagepatch_addressing_t addr = {W, H, sizeof(vx_uint8), W * sizeof(vx_uint8), VX_SCALE_UNITY, VX_SCALE_UNITY, 1, 1};
+        void *ptrs[] = {planes[0], planes[1], planes[2], planes[3], planes[4]};
+        void *prev = NULL;
+        vx_uint32 errors = 0u, returned = 0u;
+        vx_node node = NULL;
+        vx_image image = vxCreateImageFromHandle(context, VX_DF_IMAGE_U8, &addr, &ptrs[0], VX_IMPORT_TYPE_HOST);
+        vx_image other = vxCreateImageFromHandle(context, VX_DF_IMAGE_U8, &addr, &ptrs[3], VX_IMPORT_TYPE_HOST);
+        vx_image output = vxCreateImage(context, W, H, VX_DF_IMAGE_U8);
+        vx_graph graph = vxCreateGraph(context);
+        vx_char name[VX_MAX_KERNEL_NAME] = "org.khronos.test.image_handle";
+        vx_kernel kernel = vxAddKernel(context, name, VX_KERNEL_BASE(VX_ID_KHRONOS, VX_LIBRARY_TEST_HANDLE) + 0x0,
+                                       vx_test_handle_kernel, 1, vx_test_handle_input, vx_test_handle_output, NULL, NULL);
+        memset(planes[0], 0x10, sizeof(planes[0]));
+        memset(planes[1], 0x20, sizeof(planes[1]));
+        memset(planes[2], 0x30, sizeof(planes[2]));
+        memset(planes[3], 0x40, sizeof(planes[3]));
+        memset(planes[4], 0x50, sizeof(planes[4]));
+        handle_num_returned = 0u;
+        vxAtomicStore(&handle_kernel_entered, 0u);
+        vxAtomicStore(&handle_kernel_released, 0u);
+        status = vxLoadKernels(context, "openvx-debug");
+        if (kernel && status == VX_SUCCESS)
+        {
+            status |= vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED);
+            status |= vxFinalizeKernel(kernel);
+        }
+        if (image && other && output && graph && kernel && status == VX_SUCCESS)
+        {
+            node = vxCreateGenericNode(graph, kernel);
+            if (node == NULL)
+                FAIL(exit, "Failed to create the blocking node");
+            status |= vxSetParameterByIndex(node, 0, (vx_reference)image);
+            status |= vxSetImageHandleCallback(image, vx_test_handle_returned, NULL);
+            if (status == VX_SUCCESS)
+                status = vxVerifyGraph(graph);
+            if (status != VX_SUCCESS)
+                VFAIL(exit, "Failed to set up the graph, status=%d", status);
+
+            /* idle, the swap takes effect at once */
+            status = vxSwapImageHandle(image, &ptrs[1], &prev, 1);
+            if ((status != VX_SUCCESS) || (prev != ptrs[0]) ||
+                (handle_num_returned != 1u) || (handle_returned[0] != ptrs[0]))
+                VFAIL(exit, "The idle swap returned %u planes, status=%d", handle_num_returned, status);
+            status = vxuNot(context, image, output);
+            if (status == VX_SUCCESS)
+                status = vxuCheckImage(context, output, 0xFF - 0x20, &errors);
+            if (status != VX_SUCCESS)
+                VFAIL(exit, "The swapped image has %u errors, status=%d", errors, status);
+
+            /* scheduled, the swap waits until the graph completes */
+            status = vxScheduleGraph(graph);
+            if (status != VX_SUCCESS)
+                VFAIL(exit, "Failed to schedule the graph, status=%d", status);
+            while (vxAtomicLoad(&handle_kernel_entered) == 0u)
+                ;
+            status = vxSwapImageHandle(image, &ptrs[2], &prev, 1);
+            returned = handle_num_returned;
+            /* the running graph still holds the image it started with */
+            if (status == VX_SUCCESS)
+                status = vxSetParameterByIndex(node, 0, (vx_reference)other);
+            vxAtomicStore(&handle_kernel_released, 1u);
+            if (vxWaitGraph(graph) != VX_SUCCESS)
+                FAIL(exit, "The scheduled graph failed");
+            if ((status != VX_SUCCESS) || (prev != ptrs[1]) || (returned != 1u))
+                VFAIL(exit, "The swap of the held image returned %u planes, status=%d", returned, status);
+            if (handle_kernel_pixel != 0x20)
+                VFAIL(exit, "The graph saw %02x instead of the planes it started with", handle_kernel_pixel);
+            if ((handle_num_returned != 2u) || (handle_returned[1] != ptrs[1]))
+                VFAIL(exit, "The completed graph returned %u planes", handle_num_returned);
+            status = vxuNot(context, image, output);
+            if (status == VX_SUCCESS)
+                status = vxuCheckImage(context, output, 0xFF - 0x30, &errors);
+            if (status != VX_SUCCESS)
+                VFAIL(exit, "The deferred swap has %u errors, status=%d", errors, status);
+            /* the image bound meanwhile was never held, so its swap is immediate */
+            status = vxSwapImageHandle(other, &ptrs[4], &prev, 1);
+            if (status == VX_SUCCESS)
+                status = vxuNot(context, other, output);
+            if (status == VX_SUCCESS)
+                status = vxuCheckImage(context, output, 0xFF - 0x50, &errors);
+            if ((status != VX_SUCCESS) || (prev != ptrs[3]))
+                VFAIL(exit, "The rebound image has %u errors, status=%d", errors, status);
+
+            /* released, the last planes are returned */
+            vxReleaseNode(&node);
+            vxReleaseGraph(&graph);
+            vxReleaseImage(&image);
+            if ((handle_num_returned != 3u) || (handle_returned[2] != ptrs[2]))
+                VFAIL(exit, "The released image returned %u planes", handle_num_returned);
+        }
+exit:
+        vxAtomicStore(&handle_kernel_released, 1u);
+        vxReleaseNode(&node);
+        vxReleaseGraph(&graph);
+        vxReleaseImage(&image);
+        vxReleaseImage(&other);
+        vxReleaseImage(&output);
+        vxReleaseContext(&context);
+    }
+    return status;
+}
+#endif
+
 /*!
  * \brief Test calling a direct copy.
  * \ingroup group_tests
@@ -3024,8 +3701,20 @@ vx_unittest unittests[] = {
     {VX_FAILURE, "Framework: Virtual Image",    &vx_test_framework_virtualimage},
     {VX_FAILURE, "Framework: Delay",            &vx_test_framework_delay_graph},
     {VX_FAILURE, "Framework: Kernels",          &vx_test_framework_kernels},
+    {VX_FAILURE, "Framework: References",       &vx_test_framework_references},
+    {VX_FAILURE, "Framework: Access Locks",     &vx_test_framework_access_locks},
 #if defined(EXPERIMENTAL_USE_TARGET)
     {VX_FAILURE, "Framework: Target",           &vx_test_framework_targets},
+#endif
+#if defined(EXPERIMENTAL_USE_PIPELINING)
+    {VX_FAILURE, "Framework: Pipeline Process", &vx_test_framework_pipeline_process},
+    {VX_FAILURE, "Framework: Pipeline Frames",  &vx_test_framework_pipeline_frames},
+#endif
+#if defined(EXPERIMENTAL_USE_MEMORY_PLAN)
+    {VX_FAILURE, "Framework: Memory Plan",      &vx_test_framework_memory_plan},
+#endif
+#if defined(EXPERIMENTAL_USE_IMAGE_HANDLE)
+    {VX_FAILURE, "Framework: Image Handle",     &vx_test_framework_image_handle},
 #endif
     {VX_FAILURE, "Direct: Copy Image",          &vx_test_direct_copy_image},
     {VX_FAILURE, "Direct: Copy External Image", &vx_test_direct_copy_external_image},
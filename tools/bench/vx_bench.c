@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2012-2014 The Khronos Group Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and/or associated documentation files (the
+ * "Materials"), to deal in the Materials without restriction, including
+ * without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Materials, and to
+ * permit persons to whom the Materials are furnished to do so, subject to
+ * the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included
+ * in all copies or substantial portions of the Materials.
+ *
+ * THE MATERIALS ARE PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ * MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ * IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ * CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ * MATERIALS OR THE USE OR OTHER DEALINGS IN THE MATERIALS.
+ */
+
+/*!
+ * \file
+ * \brief A microbenchmark of the image patch access calls.
+ * \details Reports the time of one vxAccessImagePatch and vxCommitImagePatch pair
+ * for mapped reads, mapped writes, a small copied patch and a small patch read
+ * through a pointer into the image itself. Run it against a normal and an
+ * OPENVX_RELEASE_BUILD build to see what the debug zones cost.
+ * It also reports the time to create, fill and release a 1080p frame, which is
+ * mostly the cost of allocating its memory.
+ * The optional argument is the number of pairs to time.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <VX/vx.h>
+
+#define BENCH_WIDTH     (640)
+#define BENCH_HEIGHT    (480)
+#define BENCH_PATCH     (16)
+#define BENCH_FRAME_W   (1920)
+#define BENCH_FRAME_H   (1080)
+
+static vx_status vxBenchPatch(vx_image image, vx_rectangle_t *rect, vx_enum usage, void *buffer,
+                              vx_uint32 iterations, const char *name)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 i;
+    clock_t start = clock();
+    double ns;
+    for (i = 0u; (i < iterations) && (status == VX_SUCCESS); i++)
+    {
+        vx_imagepatch_addressing_t addr;
+        void *ptr = buffer;
+        status = vxAccessImagePatch(image, rect, 0, &addr, &ptr, usage);
+        if (status == VX_SUCCESS)
+            status = vxCommitImagePatch(image, rect, 0, &addr, ptr);
+    }
+    ns = (double)(clock() - start) * 1e9 / CLOCKS_PER_SEC / iterations;
+    if (status == VX_SUCCESS)
+        printf("%-16s %8.1f ns per access and commit\n", name, ns);
+    else
+        printf("%-16s failed with %d\n", name, status);
+    return status;
+}
+
+static vx_status vxBenchCreate(vx_context context, vx_df_image format, vx_uint32 iterations, const char *name)
+{
+    vx_status status = VX_SUCCESS;
+    vx_uint32 i;
+    clock_t start = clock();
+    double us;
+    for (i = 0u; (i < iterations) && (status == VX_SUCCESS); i++)
+    {
+        vx_image image = vxCreateImage(context, BENCH_FRAME_W, BENCH_FRAME_H, format);
+        vx_rectangle_t rect = {0, 0, BENCH_FRAME_W, BENCH_FRAME_H};
+        vx_imagepatch_addressing_t addr;
+        void *ptr = NULL;
+        status = vxGetStatus((vx_reference)image);
+        if (status == VX_SUCCESS)
+            status = vxAccessImagePatch(image, &rect, 0, &addr, &ptr, VX_WRITE_ONLY);
+        if (status == VX_SUCCESS)
+        {
+            vx_uint32 y;
+            for (y = 0u; y < addr.dim_y; y++)
+                memset(vxFormatImagePatchAddress2d(ptr, 0, y, &addr), (vx_uint8)i, addr.dim_x * addr.stride_x);
+            status = vxCommitImagePatch(image, &rect, 0, &addr, ptr);
+        }
+        vxReleaseImage(&image);
+    }
+    us = (double)(clock() - start) * 1e6 / CLOCKS_PER_SEC / iterations;
+    if (status == VX_SUCCESS)
+        printf("%-16s %8.1f us per frame\n", name, us);
+    else
+        printf("%-16s failed with %d\n", name, status);
+    return status;
+}
+
+int main(int argc, char *argv[])
+{
+    vx_status status = VX_FAILURE;
+    vx_uint32 iterations = (argc > 1 ? (vx_uint32)atoi(argv[1]) : 1000000u);
+    vx_context context = vxCreateContext();
+    if (iterations == 0u)
+        iterations = 1u;
+    if (context)
+    {
+        vx_image image = vxCreateImage(context, BENCH_WIDTH, BENCH_HEIGHT, VX_DF_IMAGE_U8);
+        vx_rectangle_t full = {0, 0, BENCH_WIDTH, BENCH_HEIGHT};
+        vx_rectangle_t patch = {0, 0, BENCH_PATCH, BENCH_PATCH};
+        vx_uint8 buffer[BENCH_PATCH*BENCH_PATCH];
+        status = vxGetStatus((vx_reference)image);
+        if (status == VX_SUCCESS)
+        {
+            status |= vxBenchPatch(image, &full, VX_READ_ONLY, NULL, iterations, "map read");
+            status |= vxBenchPatch(image, &full, VX_WRITE_ONLY, NULL, iterations, "map write");
+            status |= vxBenchPatch(image, &patch, VX_READ_ONLY, buffer, iterations, "copy read 16x16");
+            status |= vxBenchPatch(image, &patch, VX_WRITE_ONLY, buffer, iterations, "copy write 16x16");
+            {
+                /* a caller's pointer into the image itself is mapped, not copied */
+                vx_imagepatch_addressing_t addr;
+                void *ptr = NULL;
+                status |= vxAccessImagePatch(image, &patch, 0, &addr, &ptr, VX_READ_ONLY);
+                status |= vxCommitImagePatch(image, NULL, 0, &addr, ptr);
+                status |= vxBenchPatch(image, &patch, VX_READ_ONLY, ptr, iterations, "in place 16x16");
+            }
+            vxReleaseImage(&image);
+        }
+        if (status == VX_SUCCESS)
+        {
+            status |= vxBenchCreate(context, VX_DF_IMAGE_U8, (iterations + 999u) / 1000u, "create 1080p U8");
+            status |= vxBenchCreate(context, VX_DF_IMAGE_RGB, (iterations + 999u) / 1000u, "create 1080p RGB");
+        }
+        vxReleaseContext(&context);
+    }
+    return (status == VX_SUCCESS ? 0 : 1);
+}